@@ -455,10 +455,13 @@ std::string heap::big_to_string(cell big, size_t base, bool capital) const
     cpp_int val;
     size_t nbits = 0;
     get_big(big, val, nbits);
-    std::string s = big_to_string(val, base, nbits);
+    std::string s = big_to_string(abs(val), base, nbits);
     if (capital) {
 	boost::to_upper(s);
     }
+    if (val < 0) {
+	s = "-" + s;
+    }
     return s;
 }
 
@@ -485,7 +488,7 @@ void heap::set_big(cell big, const boost::multiprecision::cpp_int &i)
     if (i != 0) {
 	// It needs to be in the right most position of the bignum
 	// (the bignum is in big endian form)
-	auto nbytes = (nbits - ((msb(i) + 7) / 8)*8) / 8;
+	auto nbytes = (nbits - ((msb(abs(i)) + 8) / 8)*8) / 8;
 	while (nbytes) {
 	    ++bi;
 	    nbytes--;
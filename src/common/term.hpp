@@ -441,12 +441,6 @@ class int_cell : public cell {
 private:
     typedef int64_t T;
 
-    inline int_cell bin_op( const std::function<T(const T, const T)> &f,
-			    const int_cell a,
-			    const int_cell b) const {
-	return int_cell(f((T)a,(T)b));
-    }
-
 protected:
     inline int_cell(tag_t t, int64_t val) : cell(t, val) { }
 
@@ -484,7 +478,7 @@ public:
     }
 
     inline int_cell operator + (const int_cell other ) const {
-	return bin_op( std::plus<T>(), *this, other );
+	return int_cell(static_cast<T>(*this) + static_cast<T>(other));
     }
 
     inline int_cell & operator ++ () {
@@ -493,15 +487,15 @@ public:
     }
 
     inline int_cell operator - (const int_cell other ) const {
-	return bin_op( std::minus<T>(), *this, other );
+	return int_cell(static_cast<T>(*this) - static_cast<T>(other));
     }
 
     inline int_cell operator * (const int_cell other) const {
-	return bin_op( std::multiplies<T>(), *this, other );
+	return int_cell(static_cast<T>(*this) * static_cast<T>(other));
     }
 
     inline int_cell operator / (const int_cell other) const {
-	return bin_op( std::divides<T>(), *this, other );
+	return int_cell(static_cast<T>(*this) / static_cast<T>(other));
     }
 
     inline bool operator == (const int other) const {
@@ -583,15 +577,20 @@ private:
 public:
     static const size_t CELL_NUM_BYTES_HALF = CELL_NUM_BITS / 2 / 8;
 
-    // Lower 4 bytes (half cell) = number of bits
+    // The top bit of the size field is the sign of a bignum (the
+    // binary data itself is always the magnitude.)
+    static const size_t SIGN_BIT = static_cast<size_t>(1) << (CELL_NUM_BITS_HALF - TAG_SIZE_BITS - 1);
+
+    // Lower 4 bytes (half cell) = number of bits (and sign)
     // Upper 4 bytes (half cell) = binary data
-    inline dat_cell(size_t num_bits)
-        : int_cell(tag_t::DAT, static_cast<int64_t>(num_bits)) { }
+    inline dat_cell(size_t num_bits, bool negative = false)
+        : int_cell(tag_t::DAT, static_cast<int64_t>(num_bits | (negative ? SIGN_BIT : 0))) { }
 
     inline size_t num_bits() const
-    { auto mask = (static_cast<untagged_cell::value_t>(1) << (CELL_NUM_BITS_HALF - TAG_SIZE_BITS)) - 1;
-      return value() & mask;
-    }
+    { return value() & (SIGN_BIT - 1); }
+
+    inline bool is_negative() const
+    { return (value() & SIGN_BIT) != 0; }
 
     // [32] means reserved for 32 bits storing size.
     //
@@ -617,7 +616,8 @@ public:
 
 class big_header : public dat_cell {
 public:
-    inline big_header(size_t num_bits) : dat_cell(num_bits) { }
+    inline big_header(size_t num_bits, bool negative = false)
+	: dat_cell(num_bits, negative) { }
 };
 
 template<typename T> class big_iterator_base : public T {
@@ -1163,19 +1163,24 @@ public:
     inline big_cell new_big(const boost::multiprecision::cpp_int &i, size_t nbits0)
     {
 	using namespace boost::multiprecision;
-	size_t nbits = nbits0 == 0 ? (i ? msb(i)+1 : 1) : nbits0;
+	size_t nbits = nbits0 == 0 ? (i ? msb(abs(i))+1 : 1) : nbits0;
 	nbits = ((nbits + 7) / 8) * 8;
-	big_cell big = new_big(nbits);
+	big_cell big = new_big(nbits, i < 0);
 	set_big(big, i);
 	return big;
     }
 
-    inline big_cell new_big(size_t num_bits)
+    inline bool is_negative(const big_cell &big) const {
+	auto &hdr = reinterpret_cast<const big_header &>(get(big.index()));
+	return hdr.is_negative();
+    }
+
+    inline big_cell new_big(size_t num_bits, bool negative = false)
     {
 	auto num_bytes = (num_bits + 7) / 8;
 	auto num_cells = (num_bytes <= 4) ? 1 : 1+(((num_bytes-4) + sizeof(cell) - 1) / sizeof(cell));
 
-	big_header header(num_bits);
+	big_header header(num_bits, negative);
 
 	cell *p;
 	size_t index;
@@ -1213,6 +1218,9 @@ public:
 	auto &b = reinterpret_cast<const big_cell &>(dc);
 	nbits = num_bits(b);
 	import_bits(i, begin(b), end(b), 8);
+	if (is_negative(b)) {
+	    i = -i;
+	}
     }
     
     inline void new_cell0(cell c)
@@ -1257,10 +1265,22 @@ public:
 	cell *p;
 	std::tie(p, index) = allocate(tag_t::REF, cnt);
 	for (size_t i = 0; i < cnt; i++) {
-	    static_cast<ref_cell &>(p[i]).set_index(index+i);
+	    p[i] = ref_cell(index+i);
 	}
     }
 
+    // 'cnt' consecutive cells for the caller to fill in, or nullptr
+    // if they don't fit within a heap block.
+    inline cell * new_cells(size_t cnt, size_t &index)
+    {
+	if (cnt >= heap_block::MAX_SIZE) {
+	    return nullptr;
+	}
+	cell *p;
+	std::tie(p, index) = allocate(tag_t::REF, cnt);
+	return p;
+    }
+
     inline term empty_list() const
     {
 	return empty_list_;
@@ -0,0 +1,187 @@
+#include "term_buffer.hpp"
+
+namespace prologcoin { namespace common {
+
+const size_t term_buffer::NONE;
+
+void term_buffer::add(heap &src, term t, uint64_t &cost)
+{
+    size_t start = cells_.size();
+    starts_.push_back(start);
+    vars_.clear();
+
+    // Slot 0 is the term itself
+    cells_.push_back(cell());
+    stack_.push_back(std::make_pair(t, 0));
+
+    uint64_t n = 0;
+    while (!stack_.empty()) {
+	auto slot = stack_.back();
+	stack_.pop_back();
+	n++;
+	cell c = src.deref(slot.first);
+	size_t at = start + slot.second;
+	switch (c.tag()) {
+	case tag_t::REF: {
+	    auto index = static_cast<ref_cell &>(c).index();
+	    auto it = vars_.find(index);
+	    if (it == vars_.end()) {
+		vars_[index] = slot.second;
+		cells_[at] = ref_cell(slot.second);
+	    } else {
+		cells_[at] = ref_cell(it->second);
+	    }
+	    break;
+	}
+	case tag_t::STR: {
+	    con_cell f = src.functor(c);
+	    size_t arity = f.arity();
+	    size_t f_at = cells_.size() - start;
+	    cells_[at] = str_cell(f_at);
+	    cells_.push_back(f);
+	    n++; // Visited before and after its arguments
+	    cells_.resize(cells_.size() + arity);
+	    for (size_t i = arity; i > 0; i--) {
+		stack_.push_back(std::make_pair(src.arg(c, i - 1), f_at + i));
+	    }
+	    break;
+	}
+	case tag_t::BIG: {
+	    auto &big = static_cast<big_cell &>(c);
+	    size_t index = big.index();
+	    size_t num = src.num_cells(big);
+	    cells_[at] = big_cell(cells_.size() - start);
+	    for (size_t i = 0; i < num; i++) {
+		cells_.push_back(src[index + i]);
+	    }
+	    break;
+	}
+	default:
+	    cells_[at] = c;
+	    break;
+	}
+    }
+
+    costs_.push_back(n);
+    cost += n;
+}
+
+term term_buffer::get(heap &dst, size_t i, uint64_t &cost)
+{
+    size_t start = starts_[i], end = end_of(i);
+    size_t n = end - start;
+    cost += costs_[i];
+
+    size_t base;
+    cell *p = dst.new_cells(n, base);
+    if (p == nullptr) {
+	return rebuild(dst, start, end);
+    }
+
+    const cell *q = &cells_[start];
+    for (size_t k = 0; k < n; k++) {
+	cell c = q[k];
+	switch (c.tag()) {
+	case tag_t::REF:
+	case tag_t::STR:
+	case tag_t::BIG:
+	    p[k] = ptr_cell(c.tag(), static_cast<ptr_cell &>(c).index() + base);
+	    break;
+	case tag_t::DAT: {
+	    // Header of a bignum; its data is raw
+	    size_t num = static_cast<dat_cell &>(c).num_cells();
+	    for (size_t j = 0; j < num; j++) {
+		p[k + j] = q[k + j];
+	    }
+	    k += num - 1;
+	    break;
+	}
+	default:
+	    p[k] = c;
+	    break;
+	}
+    }
+    return p[0];
+}
+
+//
+// A term too large for a heap block is built up piece by piece.
+// Variables are numbered by their slot in the run, so this doesn't
+// need a hash map either.
+//
+term term_buffer::rebuild(heap &dst, size_t start, size_t end)
+{
+    var_dst_.assign(end - start, NONE);
+
+    term root = dst.new_ref();
+    size_t root_index = static_cast<ref_cell &>(root).index();
+    rebuild_stack_.push_back(std::make_pair(0, root_index));
+
+    while (!rebuild_stack_.empty()) {
+	auto slot = rebuild_stack_.back();
+	rebuild_stack_.pop_back();
+	size_t d = slot.second;
+	cell c = cells_[start + slot.first];
+	switch (c.tag()) {
+	case tag_t::REF: {
+	    size_t v = static_cast<ref_cell &>(c).index();
+	    if (var_dst_[v] == NONE) {
+		var_dst_[v] = d;
+	    }
+	    dst[d] = ref_cell(var_dst_[v]);
+	    break;
+	}
+	case tag_t::STR: {
+	    size_t f_at = static_cast<str_cell &>(c).index();
+	    con_cell f = static_cast<con_cell &>(cells_[start + f_at]);
+	    term str = dst.new_str(f);
+	    size_t args = static_cast<str_cell &>(str).index() + 1;
+	    dst[d] = str;
+	    for (size_t i = f.arity(); i > 0; i--) {
+		rebuild_stack_.push_back(std::make_pair(f_at + i,
+							args + i - 1));
+	    }
+	    break;
+	}
+	case tag_t::BIG: {
+	    size_t b_at = start + static_cast<big_cell &>(c).index();
+	    auto &hdr = static_cast<dat_cell &>(cells_[b_at]);
+	    auto big = dst.new_big(hdr.num_bits());
+	    size_t num = hdr.num_cells();
+	    for (size_t j = 0; j < num; j++) {
+		dst[big.index() + j] = cells_[b_at + j];
+	    }
+	    dst[d] = big;
+	    break;
+	}
+	default:
+	    dst[d] = c;
+	    break;
+	}
+    }
+
+    return dst[root_index];
+}
+
+term term_buffer::get_list(heap &dst, size_t from, term tail, uint64_t &cost)
+{
+    term lst = tail;
+    cost++;
+    for (size_t i = size(); i > from; i--) {
+	lst = dst.new_dotted_pair(get(dst, i - 1, cost), lst);
+	cost += 2;
+    }
+    return lst;
+}
+
+void term_buffer::trim(size_t n)
+{
+    if (n >= starts_.size()) {
+	return;
+    }
+    cells_.resize(starts_[n]);
+    starts_.resize(n);
+    costs_.resize(n);
+}
+
+}}
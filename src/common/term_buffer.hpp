@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef _common_term_buffer_hpp
+#define _common_term_buffer_hpp
+
+#include <vector>
+#include <unordered_map>
+#include "term.hpp"
+
+namespace prologcoin { namespace common {
+
+//
+// A compact side buffer of terms (e.g. the solutions of findall/3.)
+//
+// A term is flattened once into a run of cells whose pointers (REF,
+// STR and BIG) are relative to the start of the run. Getting it back
+// onto a heap is then a single pass that adds the address the run
+// lands on, instead of a copy that looks up every variable and
+// structure. Atoms are not translated, so terms go back to the heap
+// they came from (or one that shares its atom table.)
+//
+// Terms are kept in the order they were added, and the buffer can be
+// trimmed back to an earlier size, so nested users can share one.
+//
+class term_buffer {
+public:
+    term_buffer() { }
+
+    // Number of terms
+    inline size_t size() const { return starts_.size(); }
+    inline size_t num_cells() const { return cells_.size(); }
+
+    // 'cost' is what copying the term would cost (see term_utils::copy),
+    // i.e. one per subterm and one more per structure. That way the
+    // buffer charges the same as the copies it replaces.
+    void add(heap &src, term t, uint64_t &cost);
+
+    // A fresh instance of the i:th term on 'dst'. Costs the same as
+    // adding it.
+    term get(heap &dst, size_t i, uint64_t &cost);
+
+    // The list of terms from 'from' and onwards, ending with 'tail'.
+    // Costs what copying such a list would (with an atomic 'tail'.)
+    term get_list(heap &dst, size_t from, term tail, uint64_t &cost);
+
+    // Keep the first 'n' terms.
+    void trim(size_t n);
+
+    inline void clear() { trim(0); }
+
+private:
+    static const size_t NONE = static_cast<size_t>(-1);
+
+    inline size_t end_of(size_t i) const
+        { return i + 1 < starts_.size() ? starts_[i+1] : cells_.size(); }
+
+    term rebuild(heap &dst, size_t start, size_t end);
+
+    std::vector<cell> cells_;
+    std::vector<size_t> starts_;
+    std::vector<uint64_t> costs_;
+
+    // Scratch space
+    std::vector<std::pair<term, size_t> > stack_;
+    std::vector<std::pair<size_t, size_t> > rebuild_stack_;
+    std::unordered_map<size_t, size_t> vars_;
+    std::vector<size_t> var_dst_;
+};
+
+}}
+
+#endif
@@ -831,8 +831,12 @@ void term_emitter::emit_big(const term_emitter::elem &e)
 	// backward compatibility wtih Prolog. But in Prologcoin we'd
 	// like to have a compact representation of binary data.
 	// Especially if we get bitcoin compatibility for private keys.
+	if (heap_.is_negative(b)) {
+	    str += "-";
+	}
 	str += "58'";
-	str += heap_.big_to_string(b, 58);
+	auto digits = heap_.big_to_string(b, 58);
+	str += (digits[0] == '-') ? digits.substr(1) : digits;
     }
     emit_token(str);
 }
@@ -78,6 +78,15 @@ bool term_utils::equal(term a, term b, uint64_t &cost)
 	    return false;
 	}
 
+	if (a.tag() == tag_t::BIG) {
+	    if (number_standard_order(a, b) != 0) {
+		trim_stack(d);
+		cost = cost_tmp;
+		return false;
+	    }
+	    continue;
+	}
+
 	if (a.tag() != tag_t::STR) {
 	    trim_stack(d);
 	    cost = cost_tmp;
@@ -178,6 +187,17 @@ uint64_t term_utils::cost(term t)
 }
 
 bool term_utils::unify(term a, term b, uint64_t &cost)
+{
+    return unify_undo<true>(a, b, cost);
+}
+
+bool term_utils::unify(term a, term b)
+{
+    uint64_t cost = 0;
+    return unify_undo<false>(a, b, cost);
+}
+
+template<bool Cost> bool term_utils::unify_undo(term a, term b, uint64_t &cost)
 {
     size_t start_trail = trail_size();
     size_t start_stack = stack_size();
@@ -187,7 +207,7 @@ bool term_utils::unify(term a, term b, uint64_t &cost)
     // unification fails.
     set_register_hb(heap_size());
 
-    bool r = unify_helper(a, b, cost);
+    bool r = unify_helper<Cost>(a, b, cost);
 
     if (!r) {
       unwind_trail(start_trail, trail_size());
@@ -202,7 +222,7 @@ bool term_utils::unify(term a, term b, uint64_t &cost)
     return true;
 }
 
-bool term_utils::unify_helper(term a, term b, uint64_t &cost)
+template<bool Cost> bool term_utils::unify_helper(term a, term b, uint64_t &cost)
 {
     size_t d = stack_size();
 
@@ -218,11 +238,16 @@ bool term_utils::unify_helper(term a, term b, uint64_t &cost)
 	// So every iteration of this stack based unification loop
 	// will add 2 to the accumulated cost.
 
-	uint64_t cost_deref1 = 0, cost_deref2 = 0;
-        a = deref_with_cost(pop(), cost_deref1);
-	cost_tmp += cost_deref1;
-	b = deref_with_cost(pop(), cost_deref2);
-	cost_tmp += cost_deref2;
+	if (Cost) {
+	    uint64_t cost_deref1 = 0, cost_deref2 = 0;
+	    a = deref_with_cost(pop(), cost_deref1);
+	    cost_tmp += cost_deref1;
+	    b = deref_with_cost(pop(), cost_deref2);
+	    cost_tmp += cost_deref2;
+	} else {
+	    a = deref(pop());
+	    b = deref(pop());
+	}
 
 	if (a == b) {
 	    continue;
@@ -285,8 +310,12 @@ bool term_utils::unify_helper(term a, term b, uint64_t &cost)
 	  }
 	  break;
 	}
-        // TODO: Implement these two later...
-	case tag_t::BIG:assert(false); break;
+	case tag_t::BIG:
+	  if (number_standard_order(a, b) != 0) {
+	    cost = cost_tmp;
+	    return false;
+	  }
+	  break;
 	}
     }
 
@@ -295,6 +324,25 @@ bool term_utils::unify_helper(term a, term b, uint64_t &cost)
     return true;
 }
 
+int term_utils::number_standard_order(term a, term b)
+{
+    using namespace boost::multiprecision;
+
+    cpp_int va, vb;
+    size_t nbits = 0;
+    if (a.tag() == tag_t::BIG) {
+	get_big(a, va, nbits);
+    } else {
+	va = static_cast<const int_cell &>(a).value();
+    }
+    if (b.tag() == tag_t::BIG) {
+	get_big(b, vb, nbits);
+    } else {
+	vb = static_cast<const int_cell &>(b).value();
+    }
+    return (va < vb) ? -1 : (va > vb) ? 1 : 0;
+}
+
 int term_utils::functor_standard_order(con_cell a, con_cell b)
 {
     if (a == b) {
@@ -332,6 +380,18 @@ int term_utils::standard_order(term a, term b, uint64_t &cost)
   	    continue;
 	}
 
+	// Integers are ordered by value, whether they are small or big
+	if (is_number(a) && is_number(b) &&
+	    (a.tag() == tag_t::BIG || b.tag() == tag_t::BIG)) {
+	    int cmp = number_standard_order(a, b);
+	    if (cmp != 0) {
+		trim_stack(d);
+		cost = cost_tmp;
+		return cmp;
+	    }
+	    continue;
+	}
+
 	if (a.tag() != b.tag()) {
 	    trim_stack(d);
 	    if (a.tag() < b.tag()) {
@@ -358,7 +418,7 @@ int term_utils::standard_order(term a, term b, uint64_t &cost)
 	case tag_t::INT:
 	  {
 	    trim_stack(d);
-	    if (a.value() < b.value()) {
+	    if (a.value_signed() < b.value_signed()) {
 		cost = cost_tmp;
 	        return -1;
 	    } else {
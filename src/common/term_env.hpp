@@ -195,6 +195,9 @@ public:
         { return T::get_heap().new_str0(functor); }
     inline term new_big(size_t nbits)
         { return T::get_heap().new_big(nbits); }
+    inline term new_big(const boost::multiprecision::cpp_int &i,
+			size_t nbits = 0)
+        { return T::get_heap().new_big(i, nbits); }
 
     inline void new_term_copy_cell(term t)
         { T::get_heap().new_cell0(t); }
@@ -398,6 +401,8 @@ public:
     term_utils(heap &h, stacks &s, term_ops &o) : heap_proxy(h), stacks_proxy(s), ops_proxy(o) { }
 
     bool unify(term a, term b, uint64_t &cost);
+    // The same without counting the cost
+    bool unify(term a, term b);
     term copy(const term t, naming_map &names, uint64_t &cost);
     term copy(const term t, naming_map &names,
 	      heap &src, naming_map &src_names, uint64_t &cost);
@@ -423,8 +428,12 @@ public:
     
 
 private:
-    bool unify_helper(term a, term b, uint64_t &cost);
+    template<bool Cost> bool unify_undo(term a, term b, uint64_t &cost);
+    template<bool Cost> bool unify_helper(term a, term b, uint64_t &cost);
     int functor_standard_order(con_cell a, con_cell b);
+    int number_standard_order(term a, term b);
+    inline bool is_number(term t) const
+    { return t.tag() == tag_t::INT || t.tag() == tag_t::BIG; }
 
     inline void bind(const ref_cell &a, term b)
     {
@@ -523,6 +532,12 @@ public:
       return utils.unify(a, b, cost);
   }
 
+  inline bool unify(term a, term b)
+  {
+      term_utils utils(heap_dock<HT>::get_heap(), stacks_dock<ST>::get_stacks(), ops_dock<OT>::get_ops());
+      return utils.unify(a, b);
+  }
+
   inline term copy(term t, uint64_t &cost)
   {
       term_utils utils(heap_dock<HT>::get_heap(), stacks_dock<ST>::get_stacks(), ops_dock<OT>::get_ops());
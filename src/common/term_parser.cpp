@@ -863,7 +863,7 @@ protected:
 	// Round up to nearest byte
 	size_t nbits = 8;
 	if (val != 0) {
-	    nbits = ((msb(val) + 7) / 8) * 8;
+	    nbits = ((msb(val) + 8) / 8) * 8;
 	}
 
 	big_cell big = heap_.new_big(val, nbits);
@@ -1176,9 +1176,22 @@ public:
         throw token_exception_unrecognized_operator(tokenizer().line_string(), tok.pos(), tok.lexeme());
     }
 
+    select_operator(tok, candidates);
+
+    if (!consumed_name) {
+        tokenizer().consume_token();
+    }
+
+    return lookahead_;
+  }
+
+  void select_operator(const term_tokenizer::token &tok,
+		       const std::vector<term_ops::op_entry> &candidates)
+  {
     // Pick first candidate that doesn't yield parse error.
     // (Note that entries are sorted in precedence order.)
 
+    symbol_t symt = SYMBOL_UNKNOWN;
     term_ops::op_entry entry;
     for (auto e : candidates) {
 	entry = e;
@@ -1191,12 +1204,19 @@ public:
 
     lookahead_ = sym(current_state_, tok, symt);
     lookahead_.set_precedence(entry.precedence);
+  }
 
-    if (!consumed_name) {
-        tokenizer().consume_token();
+  // The symbol after a full stop is read ahead while still parsing
+  // the previous term, so an operator there was chosen for the wrong
+  // context (e.g. an infix ':-' for what starts a directive.)
+  void reselect_operator()
+  {
+    auto ord = lookahead_.ordinal();
+    if (ord < SYMBOL_OP_FX || ord > SYMBOL_OP_YFX) {
+	return;
     }
-
-    return lookahead_;
+    auto tok = lookahead_.token();
+    select_operator(tok, ops_.prec(tok.lexeme()));
   }
 
   bool check(sym symbol) {
@@ -1279,6 +1299,7 @@ void term_parser::set_debug(bool dbg)
 term term_parser::parse()
 {
   impl_->init();
+  impl_->reselect_operator();
   impl_->parse_next();
   return impl_->get_result();
 }
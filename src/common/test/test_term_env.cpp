@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <common/term_env.hpp>
 #include <common/term_ops.hpp>
+#include <common/term_buffer.hpp>
 
 using namespace prologcoin::common;
 
@@ -232,6 +233,53 @@ static void test_copy_term_bignum()
     assert( env.to_string(t1) == env2.to_string(t3));
 }
 
+static void test_term_buffer()
+{
+    header( "test_term_buffer()" );
+
+    term_env env;
+    term_buffer buf;
+
+    auto t1 = env.parse("foo(X, bar(X, Y), 16'102030405060708090A0B0C0D0E0f0, [a,b]).");
+    auto t2 = env.parse("hello.");
+    uint64_t cost = 0;
+    buf.add(env.get_heap(), t1, cost);
+    buf.add(env.get_heap(), t2, cost);
+    assert(buf.size() == 2);
+
+    auto c1 = buf.get(env.get_heap(), 0, cost);
+    std::cout << "Relocated: " << env.to_string(c1) << std::endl;
+
+    // Fresh variables, shared where they were shared
+    auto x = env.deref(env.arg(c1, 0));
+    assert(x.tag() == tag_t::REF);
+    assert(x != env.deref(env.arg(t1, 0)));
+    assert(x == env.deref(env.arg(env.arg(c1, 1), 0)));
+    assert(x != env.deref(env.arg(env.arg(c1, 1), 1)));
+    assert(env.to_string(env.arg(c1, 2)) == env.to_string(env.arg(t1, 2)));
+    assert(env.to_string(env.arg(c1, 3)) == "[a,b]");
+
+    auto lst = buf.get_list(env.get_heap(), 1, env.empty_list(), cost);
+    assert(env.to_string(lst) == "[hello]");
+
+    // Too large for a heap block; it's rebuilt instead
+    term big = env.empty_list();
+    for (size_t i = 0; i < 50000; i++) {
+	big = env.new_dotted_pair(int_cell(i), big);
+    }
+    big = env.new_dotted_pair(env.arg(t1, 0), big);
+    buf.trim(1);
+    buf.add(env.get_heap(), big, cost);
+    assert(buf.size() == 2 && buf.num_cells() > heap_block::MAX_SIZE);
+    auto c2 = buf.get(env.get_heap(), 1, cost);
+    assert(env.list_length(c2) == 50001);
+    assert(env.deref(env.arg(c2, 0)).tag() == tag_t::REF);
+    assert(env.to_string(env.arg(env.arg(c2, 1), 0)) == "49999");
+
+    buf.clear();
+    assert(buf.size() == 0 && buf.num_cells() == 0);
+}
+
 static void test_dfs_iterator()
 {
     header( "test_dfs_iterator()" );
@@ -330,6 +378,7 @@ int main( int argc, char *argv[] )
     test_unify_append();
     test_copy_term();
     test_copy_term_bignum();
+    test_term_buffer();
     test_dfs_iterator();
     test_copy_term_heaps();
     test_list_string();
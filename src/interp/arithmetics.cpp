@@ -5,33 +5,79 @@
 namespace prologcoin { namespace interp {
 
     using namespace prologcoin::common;
+    using namespace boost::multiprecision;
 
-    int_cell arithmetics_fn::get_int(const term &t)
-    {
-	cell c = t;
-	const int_cell &ic = static_cast<const int_cell &>(c);
-	return ic;
-    }
-
-    term arithmetics_fn::plus_2(interpreter_base &interp, term *args)
-    {
-	return get_int(args[0]) + get_int(args[1]);
-    }
+    const size_t arithmetics::MAX_BITS;
 
-    term arithmetics_fn::minus_2(interpreter_base &interp, term *args)
+    bool arithmetics_fn::apply(arith_op op, size_t arity, const int64_t *args,
+			       int64_t &r)
     {
-	return get_int(args[0]) - get_int(args[1]);
-    }
+	int64_t a = args[0];
+	int64_t b = (arity > 1) ? args[1] : 0;
 
-    term arithmetics_fn::times_2(interpreter_base &interp, term *args)
-    {
-	return get_int(args[0]) * get_int(args[1]);
+	switch (op) {
+	case ARITH_ADD: return add(a, b, r);
+	case ARITH_SUB: return sub(a, b, r);
+	case ARITH_MUL: return mul(a, b, r);
+	case ARITH_INT_DIV: return int_div(a, b, r);
+	case ARITH_DIV: return div(a, b, r);
+	case ARITH_MOD: return mod(a, b, r);
+	case ARITH_REM: return rem(a, b, r);
+	case ARITH_MIN: r = (a < b) ? a : b; return true;
+	case ARITH_MAX: r = (a > b) ? a : b; return true;
+	case ARITH_SHIFT_LEFT: return shift_left(a, b, r);
+	case ARITH_SHIFT_RIGHT: return shift_right(a, b, r);
+	case ARITH_AND: r = a & b; return true;
+	case ARITH_OR: r = a | b; return true;
+	case ARITH_XOR: r = a ^ b; return true;
+	case ARITH_GCD: {
+	    uint64_t x = (a < 0) ? -static_cast<uint64_t>(a) : a;
+	    uint64_t y = (b < 0) ? -static_cast<uint64_t>(b) : b;
+	    while (y != 0) {
+		uint64_t t = x % y;
+		x = y;
+		y = t;
+	    }
+	    r = static_cast<int64_t>(x);
+	    return fits(r);
+	}
+	case ARITH_POW: {
+	    if (b < 0) {
+		return false;
+	    }
+	    int64_t base = a;
+	    r = 1;
+	    while (b != 0) {
+		if ((b & 1) != 0 && !mul(r, base, r)) {
+		    return false;
+		}
+		b >>= 1;
+		if (b != 0 && !mul(base, base, base)) {
+		    return false;
+		}
+	    }
+	    return true;
+	}
+	case ARITH_NEG: r = -a; return fits(r);
+	case ARITH_POS: r = a; return true;
+	case ARITH_ABS: r = (a < 0) ? -a : a; return fits(r);
+	case ARITH_SIGN: r = (a > 0) - (a < 0); return true;
+	case ARITH_MSB: {
+	    if (a <= 0) {
+		return false;
+	    }
+	    r = 63 - __builtin_clzll(static_cast<uint64_t>(a));
+	    return true;
+	}
+	case ARITH_NOT: r = ~a; return true;
+	}
+	return false;
     }
 
-    void arithmetics::load_fn(const std::string &name, size_t arity, arithmetics::fn fn)
+    void arithmetics::load_fn(const std::string &name, size_t arity, arith_op op)
     {
 	con_cell f = interp_.functor(name, arity);
-	fn_map_[f] = fn;
+	fn_map_[f] = op;
     }
 
     void arithmetics::load_fns()
@@ -39,9 +85,29 @@ namespace prologcoin { namespace interp {
 	if (fn_map_.size() != 0) {
 	    return;
 	}
-        load_fn("+", 2, &arithmetics_fn::plus_2);
-        load_fn("-", 2, &arithmetics_fn::minus_2);
-        load_fn("*", 2, &arithmetics_fn::times_2);
+        load_fn("+", 2, ARITH_ADD);
+        load_fn("-", 2, ARITH_SUB);
+        load_fn("*", 2, ARITH_MUL);
+        load_fn("//", 2, ARITH_INT_DIV);
+        load_fn("div", 2, ARITH_DIV);
+        load_fn("mod", 2, ARITH_MOD);
+        load_fn("rem", 2, ARITH_REM);
+        load_fn("min", 2, ARITH_MIN);
+        load_fn("max", 2, ARITH_MAX);
+        load_fn("<<", 2, ARITH_SHIFT_LEFT);
+        load_fn(">>", 2, ARITH_SHIFT_RIGHT);
+        load_fn("/\\", 2, ARITH_AND);
+        load_fn("\\/", 2, ARITH_OR);
+        load_fn("xor", 2, ARITH_XOR);
+        load_fn("gcd", 2, ARITH_GCD);
+        load_fn("**", 2, ARITH_POW);
+        load_fn("^", 2, ARITH_POW);
+        load_fn("-", 1, ARITH_NEG);
+        load_fn("+", 1, ARITH_POS);
+        load_fn("abs", 1, ARITH_ABS);
+        load_fn("sign", 1, ARITH_SIGN);
+        load_fn("msb", 1, ARITH_MSB);
+        load_fn("\\", 1, ARITH_NOT);
     }
 
     void arithmetics::unload()
@@ -71,8 +137,8 @@ namespace prologcoin { namespace interp {
 		cell c = t;
 		const con_cell &f = static_cast<const con_cell &>(c);
 		size_t arity = f.arity();
-		auto fn_call = lookup(f);
-		if (fn_call == nullptr) {
+		auto it = fn_map_.find(f);
+		if (it == fn_map_.end()) {
 		    interp_.abort(interpreter_exception_undefined_function(
 			   context + ": Undefined function: " +
 			   interp_.atom_name(f) + "/" +
@@ -82,7 +148,7 @@ namespace prologcoin { namespace interp {
 		size_t end = args_.size();
 		size_t off = end - arity;
 		if (is_debug()) {
-		    std::cout << "arithmetics::eval(): " << 
+		    std::cout << "arithmetics::eval(): " <<
     		        interp_.atom_name(f) + "/" +
 			boost::lexical_cast<std::string>(arity) + "(";
 		    bool first = true;
@@ -93,7 +159,7 @@ namespace prologcoin { namespace interp {
 		    }
 		    std::cout << ")\n";
 		}
-		result = fn_call(interp_, &args_[off]);
+		result = apply(it->second, arity, &args_[off], context);
 		args_.resize(off);
 		interp_.push(result);
 		interp_.push(int_cell(1));
@@ -117,10 +183,7 @@ namespace prologcoin { namespace interp {
 		interp_.abort(interpreter_exception_not_sufficiently_instantiated(context + ": Arguments are not sufficiently instantiated"));
 		break;
 	    }
-	    case tag_t::BIG: {
-		interp_.abort(interpreter_exception_unsupported(context + ": Big integers are unsupported."));
-		break;
-	    }
+	    case tag_t::BIG:
 	    case tag_t::INT: {
 		assert(false); // Should not occur
 		break;
@@ -131,21 +194,202 @@ namespace prologcoin { namespace interp {
 	return result;
     }
 
+    term arithmetics::eval_binary(arith_op op, term x, term y,
+				  const std::string &context)
+    {
+	term args[2];
+	args[0] = x;
+	args[1] = y;
+	for (size_t i = 0; i < 2; i++) {
+	    if (args[i].tag() != tag_t::INT && args[i].tag() != tag_t::BIG) {
+		args[i] = eval(args[i], context);
+	    }
+	}
+	return apply(op, 2, args, context);
+    }
+
+    int arithmetics::compare(term lhs, term rhs, const std::string &context)
+    {
+	term x = eval(lhs, context);
+	term y = eval(rhs, context);
+	return compare_values(x, y);
+    }
+
+    int arithmetics::compare_values(term x, term y)
+    {
+	if (x.tag() == tag_t::INT && y.tag() == tag_t::INT) {
+	    auto vx = static_cast<const int_cell &>(x).value();
+	    auto vy = static_cast<const int_cell &>(y).value();
+	    return (vx < vy) ? -1 : (vx > vy) ? 1 : 0;
+	}
+	cpp_int vx, vy;
+	get_value(x, vx);
+	get_value(y, vy);
+	return (vx < vy) ? -1 : (vx > vy) ? 1 : 0;
+    }
+
     //
-    // Simple
+    // Small integers are computed in place. Only if the result
+    // doesn't fit (or on errors) we go through cpp_int.
     //
 
-    int_cell arithmetics::get_int_arg_type(term &arg,
-					   const std::string &context)
+    term arithmetics::apply(arith_op op, size_t arity, const term *args,
+			    const std::string &context)
+    {
+	int64_t vals[2];
+	bool small = true;
+	for (size_t i = 0; i < arity; i++) {
+	    if (args[i].tag() != tag_t::INT) {
+		small = false;
+		break;
+	    }
+	    vals[i] = static_cast<const int_cell &>(args[i]).value();
+	}
+	int64_t r;
+	if (small && arithmetics_fn::apply(op, arity, vals, r)) {
+	    return int_cell(r);
+	}
+	return apply_big(op, arity, args, context);
+    }
+
+    term arithmetics::apply_big(arith_op op, size_t arity, const term *args,
+				const std::string &context)
+    {
+	cpp_int x, y, r;
+	get_value(args[0], x);
+	if (arity > 1) {
+	    get_value(args[1], y);
+	}
+
+	switch (op) {
+	case ARITH_ADD: r = x + y; break;
+	case ARITH_SUB: r = x - y; break;
+	case ARITH_MUL:
+	    if (x != 0 && y != 0) {
+		check_bits(msb(abs(x)) + msb(abs(y)) + 2, context);
+	    }
+	    r = x * y;
+	    break;
+	case ARITH_INT_DIV:
+	    if (y == 0) zero_divisor(context);
+	    r = x / y;
+	    break;
+	case ARITH_DIV:
+	    if (y == 0) zero_divisor(context);
+	    r = x / y;
+	    if (x % y != 0 && ((x < 0) != (y < 0))) {
+		r -= 1;
+	    }
+	    break;
+	case ARITH_MOD:
+	    if (y == 0) zero_divisor(context);
+	    r = x % y;
+	    if (r != 0 && ((r < 0) != (y < 0))) {
+		r += y;
+	    }
+	    break;
+	case ARITH_REM:
+	    if (y == 0) zero_divisor(context);
+	    r = x % y;
+	    break;
+	case ARITH_MIN: r = (x < y) ? x : y; break;
+	case ARITH_MAX: r = (x > y) ? x : y; break;
+	case ARITH_SHIFT_LEFT:
+	case ARITH_SHIFT_RIGHT: {
+	    // A negative shift goes the other way
+	    bool left = (op == ARITH_SHIFT_LEFT) == (y >= 0);
+	    cpp_int n = abs(y);
+	    if (x == 0) {
+		r = 0;
+	    } else if (left) {
+		check_bits(n > MAX_BITS ? MAX_BITS + 1 :
+			   msb(abs(x)) + 1 + n.convert_to<size_t>(), context);
+		r = x << n.convert_to<size_t>();
+	    } else if (n >= msb(abs(x)) + 2) {
+		r = (x < 0) ? -1 : 0;
+	    } else {
+		r = x >> n.convert_to<size_t>();
+	    }
+	    break;
+	}
+	case ARITH_AND: r = x & y; break;
+	case ARITH_OR: r = x | y; break;
+	case ARITH_XOR: r = x ^ y; break;
+	case ARITH_GCD: r = gcd(x, y); break;
+	case ARITH_POW:
+	    if (y < 0) {
+		if (x == 1) {
+		    r = 1;
+		} else if (x == -1) {
+		    r = ((y & 1) == 0) ? 1 : -1;
+		} else if (x == 0) {
+		    zero_divisor(context);
+		} else {
+		    interp_.abort(interpreter_exception_wrong_arg_type(
+			context + ": Negative exponent: " +
+			interp_.safe_to_string(args[1])));
+		}
+	    } else if (x == 0) {
+		r = (y == 0) ? 1 : 0;
+	    } else if (x == 1) {
+		r = 1;
+	    } else if (x == -1) {
+		r = ((y & 1) == 0) ? 1 : -1;
+	    } else {
+		check_bits(y > MAX_BITS ? MAX_BITS + 1 :
+			   (msb(abs(x)) + 1) * y.convert_to<size_t>(), context);
+		r = pow(x, y.convert_to<unsigned>());
+	    }
+	    break;
+	case ARITH_NEG: r = -x; break;
+	case ARITH_POS: r = x; break;
+	case ARITH_ABS: r = abs(x); break;
+	case ARITH_SIGN: r = (x > 0) ? 1 : (x < 0) ? -1 : 0; break;
+	case ARITH_MSB:
+	    if (x <= 0) {
+		interp_.abort(interpreter_exception_wrong_arg_type(
+		    context + ": msb/1 requires a positive integer: " +
+		    interp_.safe_to_string(args[0])));
+	    }
+	    r = msb(x);
+	    break;
+	case ARITH_NOT: r = -x - 1; break;
+	}
+	return new_integer(r, context);
+    }
+
+    void arithmetics::get_value(term t, cpp_int &v)
+    {
+	if (t.tag() == tag_t::INT) {
+	    v = static_cast<const int_cell &>(t).value();
+	} else {
+	    size_t nbits = 0;
+	    interp_.get_big(t, v, nbits);
+	}
+    }
+
+    term arithmetics::new_integer(const cpp_int &v, const std::string &context)
     {
-	if (arg.tag() != tag_t::INT) {
-	    interp_.abort(interpreter_exception_argument_not_number(
-			      context + ": argument is not a number: " +
-			      interp_.safe_to_string(arg)));
-	}
-	cell c = arg;
-	int_cell &r = static_cast<int_cell &>(c);
-	return r;
+	if (v >= int_cell::min().value() && v <= int_cell::max().value()) {
+	    return int_cell(v.convert_to<int64_t>());
+	}
+	check_bits(msb(abs(v)) + 1, context);
+	return interp_.new_big(v);
+    }
+
+    void arithmetics::zero_divisor(const std::string &context)
+    {
+	interp_.abort(interpreter_exception_zero_divisor(
+			  context + ": Division by zero"));
+    }
+
+    void arithmetics::check_bits(size_t nbits, const std::string &context)
+    {
+	if (nbits > MAX_BITS) {
+	    interp_.abort(interpreter_exception_int_overflow(
+		context + ": Integer result exceeds " +
+		boost::lexical_cast<std::string>(MAX_BITS) + " bits"));
+	}
     }
 
 }}
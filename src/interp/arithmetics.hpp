@@ -8,21 +8,144 @@
 namespace prologcoin { namespace interp {
     class interpreter_base;
 
+    // Arithmetic functions. The evaluator and the WAM arithmetic
+    // instructions both dispatch on these with a switch, so the
+    // common case never goes through a function pointer.
+    enum arith_op {
+	ARITH_ADD,
+	ARITH_SUB,
+	ARITH_MUL,
+	ARITH_INT_DIV,
+	ARITH_DIV,
+	ARITH_MOD,
+	ARITH_REM,
+	ARITH_MIN,
+	ARITH_MAX,
+	ARITH_SHIFT_LEFT,
+	ARITH_SHIFT_RIGHT,
+	ARITH_AND,
+	ARITH_OR,
+	ARITH_XOR,
+	ARITH_GCD,
+	ARITH_POW,
+	ARITH_NEG,
+	ARITH_POS,
+	ARITH_ABS,
+	ARITH_SIGN,
+	ARITH_MSB,
+	ARITH_NOT
+    };
+
     class arithmetics_fn {
     public:
-	static common::term plus_2(interpreter_base &interp, common::term *args);
-	static common::term minus_2(interpreter_base &interp, common::term *args);
-	static common::term times_2(interpreter_base &interp, common::term *args);
-    private:
-	static common::int_cell get_int(const common::term &t);
-    };
+	// Fast paths on untagged integers. They return false if the
+	// result does not fit in an int_cell (or for a zero divisor), in
+	// which case the caller needs to take the general route.
+	// int_cell values are narrower than int64_t, so sums and
+	// differences of two of them cannot overflow.
+	static inline bool add(int64_t a, int64_t b, int64_t &r)
+	{
+	    r = a + b;
+	    return fits(r);
+	}
 
+	static inline bool sub(int64_t a, int64_t b, int64_t &r)
+	{
+	    r = a - b;
+	    return fits(r);
+	}
 
-    class arithmetics {
-        typedef std::function<common::term (interpreter_base &interp,
-				            common::term *args)> fn;
+	static inline bool mul(int64_t a, int64_t b, int64_t &r)
+	{
+	    if (a == 0 || b == 0) {
+		r = 0;
+		return true;
+	    }
+	    r = static_cast<int64_t>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b));
+	    return r / b == a && fits(r);
+	}
+
+	static inline bool int_div(int64_t a, int64_t b, int64_t &r)
+	{
+	    if (b == 0) {
+		return false;
+	    }
+	    r = a / b;
+	    return fits(r);
+	}
+
+	// Flooring division (div/2)
+	static inline bool div(int64_t a, int64_t b, int64_t &r)
+	{
+	    if (b == 0) {
+		return false;
+	    }
+	    r = a / b;
+	    if ((a % b != 0) && ((a < 0) != (b < 0))) {
+		r--;
+	    }
+	    return fits(r);
+	}
+
+	// Result has the sign of the divisor (mod/2)
+	static inline bool mod(int64_t a, int64_t b, int64_t &r)
+	{
+	    if (b == 0) {
+		return false;
+	    }
+	    r = a % b;
+	    if (r != 0 && ((r < 0) != (b < 0))) {
+		r += b;
+	    }
+	    return true;
+	}
+
+	// Result has the sign of the dividend (rem/2)
+	static inline bool rem(int64_t a, int64_t b, int64_t &r)
+	{
+	    if (b == 0) {
+		return false;
+	    }
+	    r = a % b;
+	    return true;
+	}
 
+	static inline bool shift_left(int64_t a, int64_t b, int64_t &r)
+	{
+	    if (b < 0 || b >= 62) {
+		return false;
+	    }
+	    r = static_cast<int64_t>(static_cast<uint64_t>(a) << b);
+	    return (r >> b) == a && fits(r);
+	}
+
+	static inline bool shift_right(int64_t a, int64_t b, int64_t &r)
+	{
+	    if (b < 0) {
+		return false;
+	    }
+	    r = a >> (b > 63 ? 63 : b);
+	    return true;
+	}
+
+	static inline bool fits(int64_t v)
+	{
+	    return v >= common::int_cell::min().value() &&
+		   v <= common::int_cell::max().value();
+	}
+
+	// Apply 'op' on small integers; false means take the general
+	// (bignum) route, which also reports any errors.
+	static bool apply(arith_op op, size_t arity, const int64_t *args,
+			  int64_t &r);
+    };
+
+    class arithmetics {
     public:
+	// Upper bound on the size of an integer result. Anything larger
+	// would be a cheap way of exhausting memory.
+	static const size_t MAX_BITS = 65536;
+
         arithmetics(interpreter_base &interp) : interp_(interp), debug_(false)
  	   { }
 
@@ -32,21 +155,38 @@ namespace prologcoin { namespace interp {
 
 	common::term eval(common::term &expr, const std::string &context);
 
+	// Evaluate 'op' on two already evaluated integers
+	common::term eval_binary(arith_op op, common::term x, common::term y,
+				 const std::string &context);
+
+	// Evaluate both sides and return -1, 0 or 1
+	int compare(common::term lhs, common::term rhs,
+		    const std::string &context);
+
+	// Compare two integers (small or big)
+	int compare_values(common::term x, common::term y);
+
     private:
-	void load_fn(const std::string &name, size_t arity, fn f);
+	void load_fn(const std::string &name, size_t arity, arith_op op);
 	void load_fns();
 
-	inline fn lookup(common::con_cell c) {
-	    return fn_map_[c];
-	}
+	common::term apply(arith_op op, size_t arity, const common::term *args,
+			   const std::string &context);
+	common::term apply_big(arith_op op, size_t arity,
+			       const common::term *args,
+			       const std::string &context);
+
+	void get_value(common::term t, boost::multiprecision::cpp_int &v);
+	common::term new_integer(const boost::multiprecision::cpp_int &v,
+				 const std::string &context);
 
-	common::int_cell get_int_arg_type(common::term &arg,
-					  const std::string &context);
+	void zero_divisor(const std::string &context);
+	void check_bits(size_t nbits, const std::string &context);
 
 	interpreter_base &interp_;
 	std::vector<common::term> args_;
 
-	std::unordered_map<common::con_cell, fn> fn_map_;
+	std::unordered_map<common::con_cell, arith_op> fn_map_;
 
 	inline bool is_debug() const { return debug_; }
 
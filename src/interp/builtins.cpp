@@ -1,6 +1,9 @@
 #include "builtins.hpp"
 #include "interpreter_base.hpp"
 #include "wam_interpreter.hpp"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include <stdarg.h>
 #include <boost/algorithm/string.hpp>
 
@@ -351,6 +354,41 @@ namespace prologcoin { namespace interp {
 	return ok;
     }	
 
+    int builtins::arith_compare(interpreter_base &interp, term lhs, term rhs, const std::string &context)
+    {
+	return interp.arith().compare(lhs, rhs, context);
+    }
+
+    bool builtins::operator_less_than(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return arith_compare(interp, args[0], args[1], "</2") < 0;
+    }
+
+    bool builtins::operator_equals_less_than(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return arith_compare(interp, args[0], args[1], "=</2") <= 0;
+    }
+
+    bool builtins::operator_greater_than(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return arith_compare(interp, args[0], args[1], ">/2") > 0;
+    }
+
+    bool builtins::operator_greater_than_equals(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return arith_compare(interp, args[0], args[1], ">=/2") >= 0;
+    }
+
+    bool builtins::operator_arith_equals(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return arith_compare(interp, args[0], args[1], "=:=/2") == 0;
+    }
+
+    bool builtins::operator_arith_not_equals(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return arith_compare(interp, args[0], args[1], "=\\=/2") != 0;
+    }
+
     //
     // Analyzing & constructing terms
     //
@@ -546,86 +584,619 @@ namespace prologcoin { namespace interp {
 	return failed;
     }
 
+    //
+    // findall/3, bagof/3, setof/3 and aggregate_all/3 run their goal
+    // like \+ does and collect the solutions in the solution buffer
+    // (see term_buffer): each one is copied once, and the result is
+    // relocated onto the heap when the goal has no more solutions.
+    // count, sum, max and min keep a single value instead.
+    //
+
     struct meta_context_findall : public meta_context {
 	inline meta_context_findall(interpreter_base &interp, meta_fn fn)
 	    : meta_context(interp, fn) { }
-	size_t secondary_hb_;
+	collect_kind_t kind_;
+	bool fail_if_empty_;
+	size_t buffer_mark_; // Solutions in the buffer before this call
         term template_;
 	term result_;
-	term interim_;
-	term tail_;
+	term witness_;      // bagof/setof: free variables (or [])
+	uint64_t count_;
+	int64_t sum_;       // Unless big_sum_, then it's in the buffer
+	bool big_sum_;
     };
 
-
-    bool builtins::findall_3(interpreter_base &interp, size_t arity, common::term args[])
+    void builtins::collect(interpreter_base &interp, collect_kind_t kind,
+			   bool fail_if_empty, term templ, term goal,
+			   term result, term witness)
     {
-	term qr = args[1];
-	auto *context = interp.new_meta_context<meta_context_findall>(&findall_3_meta);
-	context->template_ = args[0];
-	context->result_ = args[2];
-	context->interim_ = interp.secondary_env().empty_list();
-	context->tail_ = interp.secondary_env().empty_list();
-	context->secondary_hb_ = interp.secondary_env().get_register_hb();
-	interp.secondary_env().set_register_hb(interp.secondary_env().heap_size());
+	auto *context = interp.new_meta_context<meta_context_findall>(&builtins::collect_meta);
+	context->kind_ = kind;
+	context->fail_if_empty_ = fail_if_empty;
+	context->buffer_mark_ = interp.solution_buffer().size();
+	context->template_ = templ;
+	context->result_ = result;
+	context->witness_ = witness;
+	context->count_ = 0;
+	context->sum_ = 0;
+	context->big_sum_ = false;
 	interp.set_top_e();
 	interp.allocate_choice_point(code_point::fail());
 	interp.set_top_b(interp.b());
-	interp.set_p(code_point(qr));
+	interp.set_p(code_point(goal));
+	interp.set_cp(interp.empty_list());
+    }
+
+    bool builtins::findall_3(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	collect(interp, COLLECT_BAG, false, args[0], args[1], args[2],
+		interp.empty_list());
+	return true;
+    }
+
+    void builtins::add_solution(interpreter_base &interp,
+				meta_context_findall *context)
+    {
+	static const std::string sum_context = "aggregate_all/3";
+
+	auto &buf = interp.solution_buffer();
+	size_t mark = context->buffer_mark_;
+	uint64_t cost = 0;
+
+	switch (context->kind_) {
+	case COLLECT_BAG:
+	case COLLECT_SET:
+	    buf.add(interp.get_heap(), context->template_, cost);
+	    break;
+	case COLLECT_COUNT:
+	    context->count_++;
+	    break;
+	case COLLECT_SUM: {
+	    term expr = interp.deref(context->template_);
+	    term v = interp.arith().eval(expr, sum_context);
+	    int64_t r;
+	    if (!context->big_sum_ && v.tag() == tag_t::INT &&
+		arithmetics_fn::add(context->sum_,
+				    static_cast<const int_cell &>(v).value(), r)) {
+		context->sum_ = r;
+		break;
+	    }
+	    term acc = context->big_sum_
+		? buf.get(interp.get_heap(), mark, cost)
+		: int_cell(context->sum_);
+	    term sum = interp.arith().eval_binary(ARITH_ADD, acc, v,
+						  sum_context);
+	    buf.trim(mark);
+	    buf.add(interp.get_heap(), sum, cost);
+	    context->big_sum_ = true;
+	    break;
+	}
+	case COLLECT_MAX:
+	case COLLECT_MIN: {
+	    // max(X, W) and min(X, W) are compared on X
+	    term t = context->template_;
+	    if (buf.size() > mark) {
+		term best = buf.get(interp.get_heap(), mark, cost);
+		term k = interp.arg(t, 0), best_k = interp.arg(best, 0);
+		int cmp = interp.standard_order(k, best_k);
+		if (context->kind_ == COLLECT_MAX ? cmp <= 0 : cmp >= 0) {
+		    break;
+		}
+		buf.trim(mark);
+	    }
+	    buf.add(interp.get_heap(), t, cost);
+	    break;
+	}
+	}
+
+	interp.add_accumulated_cost(cost);
+    }
+
+    // Sort on standard order and remove duplicates
+    static void sort_set(interpreter_base &interp, std::vector<term> &v)
+    {
+	std::stable_sort(v.begin(), v.end(),
+			 [&](const term &a, const term &b)
+			 { return interp.standard_order(a, b) < 0; } );
+	v.erase(std::unique(v.begin(), v.end(),
+			    [&](const term &a, const term &b)
+			    { return interp.standard_order(a, b) == 0; }),
+		v.end());
+    }
+
+    static term new_list(interpreter_base &interp, const std::vector<term> &v,
+			 size_t from, size_t to)
+    {
+	term lst = interp.empty_list();
+	for (size_t i = to; i > from; i--) {
+	    lst = interp.new_dotted_pair(v[i - 1], lst);
+	}
+	return lst;
+    }
+
+    static bool is_variant(interpreter_base &interp, term a, term b)
+    {
+	std::unordered_map<term, term> a_to_b, b_to_a;
+	std::vector<std::pair<term, term> > stack;
+	stack.push_back(std::make_pair(a, b));
+	while (!stack.empty()) {
+	    a = interp.deref(stack.back().first);
+	    b = interp.deref(stack.back().second);
+	    stack.pop_back();
+	    if (a.tag() != b.tag()) {
+		return false;
+	    }
+	    switch (a.tag()) {
+	    case tag_t::REF: {
+		auto ab = a_to_b.find(a);
+		auto ba = b_to_a.find(b);
+		if (ab == a_to_b.end() && ba == b_to_a.end()) {
+		    a_to_b[a] = b;
+		    b_to_a[b] = a;
+		} else if (ab == a_to_b.end() || ba == b_to_a.end() ||
+			   ab->second != b || ba->second != a) {
+		    return false;
+		}
+		break;
+	    }
+	    case tag_t::STR: {
+		auto f = interp.functor(a);
+		if (f != interp.functor(b)) {
+		    return false;
+		}
+		for (size_t i = 0; i < f.arity(); i++) {
+		    stack.push_back(std::make_pair(interp.arg(a, i),
+						   interp.arg(b, i)));
+		}
+		break;
+	    }
+	    default:
+		if (interp.standard_order(a, b) != 0) {
+		    return false;
+		}
+		break;
+	    }
+	}
+	return true;
+    }
+
+    //
+    // The solutions (Witness-Template pairs) of bagof/setof with free
+    // variables, grouped on (variants of) Witness. Returns a list of
+    // Witness-Bag pairs.
+    //
+    static term group_bags(interpreter_base &interp,
+			   std::vector<term> &pairs, bool is_set)
+    {
+	std::stable_sort(pairs.begin(), pairs.end(),
+			 [&](const term &a, const term &b)
+			 { return interp.standard_order(interp.arg(a, 0),
+							interp.arg(b, 0)) < 0; });
+
+	std::vector<term> groups, bag;
+	std::vector<bool> taken(pairs.size(), false);
+	for (size_t i = 0; i < pairs.size(); i++) {
+	    if (taken[i]) {
+		continue;
+	    }
+	    term w = interp.arg(pairs[i], 0);
+	    bool ground = interp.is_ground(w);
+	    bag.clear();
+	    for (size_t j = i; j < pairs.size(); j++) {
+		if (taken[j]) {
+		    continue;
+		}
+		term wj = interp.arg(pairs[j], 0);
+		if (ground) {
+		    // Equal ground witnesses are next to each other
+		    if (interp.standard_order(w, wj) != 0) {
+			break;
+		    }
+		} else if (!is_variant(interp, w, wj)) {
+		    continue;
+		}
+		interp.unify(w, wj);
+		bag.push_back(interp.arg(pairs[j], 1));
+		taken[j] = true;
+	    }
+	    if (is_set) {
+		sort_set(interp, bag);
+	    }
+	    term b = new_list(interp, bag, 0, bag.size());
+	    groups.push_back(interp.new_term(con_cell("-", 2), {w, b}));
+	}
+	return new_list(interp, groups, 0, groups.size());
+    }
+
+    // Unify with the first Witness-Bag pair; the rest on backtracking.
+    bool builtins::next_bag(interpreter_base &interp, term witness, term bag,
+			    term groups)
+    {
+	static const con_cell bag_cont("$bag", 3);
+
+	term group = interp.arg(groups, 0);
+	term rest = interp.arg(groups, 1);
+	if (!interp.is_empty_list(rest)) {
+	    term cont = interp.new_term(bag_cont, {witness, bag, rest});
+	    interp.allocate_choice_point(code_point(cont));
+	}
+	if (!interp.unify(witness, interp.arg(group, 0)) ||
+	    !interp.unify(bag, interp.arg(group, 1))) {
+	    return false;
+	}
 	interp.set_cp(interp.empty_list());
-	
 	return true;
     }
 
-    bool builtins::findall_3_meta(interpreter_base &interp, const meta_reason_t &reason)
+    bool builtins::collect_meta(interpreter_base &interp, const meta_reason_t &reason)
     {
 	bool failed = interp.is_top_fail();
 
 	auto *context = interp.get_current_meta_context<meta_context_findall>();
+	auto &buf = interp.solution_buffer();
+	size_t mark = context->buffer_mark_;
 
 	if (reason == interp::meta_reason_t::META_DELETE) {
-	    interp.secondary_env().trim_heap(interp.secondary_env().get_register_hb());
-	    interp.secondary_env().set_register_hb(context->secondary_hb_);
+	    buf.trim(mark);
 	    interp.release_last_meta_context();
 	    return true;
 	} 
 
 	interp.set_complete(false);
 
-	if (failed) {
-	    interp.unwind_to_top_choice_point();
-	    term result = interp.copy(context->interim_, interp.secondary_env());
-	    term output = context->result_;
-	    interp.secondary_env().trim_heap(interp.secondary_env().get_register_hb());
-	    interp.secondary_env().set_register_hb(context->secondary_hb_);
-	    interp.release_last_meta_context();
-	    if (interp.e0() != interp.top_e()) {
-		interp.deallocate_environment();
+	if (!failed) {
+	    add_solution(interp, context);
+	    interp.set_p(common::con_cell("fail",0));
+	    interp.set_cp(interp.empty_list());
+	    return true;
+	}
+
+	interp.unwind_to_top_choice_point();
+
+	uint64_t cost = 0;
+	size_t n = buf.size() - mark;
+	bool ok = n > 0 || !context->fail_if_empty_;
+	bool has_witness = !interp.is_empty_list(context->witness_);
+	term result;
+	std::vector<term> v;
+	if (ok) {
+	    switch (context->kind_) {
+	    case COLLECT_BAG:
+		if (!has_witness) {
+		    result = buf.get_list(interp.get_heap(), mark,
+					  interp.empty_list(), cost);
+		    break;
+		}
+		// Fall through
+	    case COLLECT_SET:
+		for (size_t i = mark; i < buf.size(); i++) {
+		    v.push_back(buf.get(interp.get_heap(), i, cost));
+		}
+		if (has_witness) {
+		    result = group_bags(interp, v,
+					context->kind_ == COLLECT_SET);
+		} else {
+		    sort_set(interp, v);
+		    result = new_list(interp, v, 0, v.size());
+		}
+		break;
+	    case COLLECT_COUNT:
+		result = int_cell(static_cast<int64_t>(context->count_));
+		break;
+	    case COLLECT_SUM:
+		result = context->big_sum_
+		    ? buf.get(interp.get_heap(), mark, cost)
+		    : int_cell(context->sum_);
+		break;
+	    case COLLECT_MAX:
+	    case COLLECT_MIN:
+		// max(X) gives X, max(X, W) gives max(X, W)
+		result = buf.get(interp.get_heap(), mark, cost);
+		if (interp.functor(result).arity() == 1) {
+		    result = interp.arg(result, 0);
+		}
+		break;
 	    }
-	    interp.set_p(interp.cp());
+	}
+	interp.add_accumulated_cost(cost);
+
+	term output = context->result_;
+	term witness = context->witness_;
+	buf.trim(mark);
+	interp.release_last_meta_context();
+	if (interp.e0() != interp.top_e()) {
+	    interp.deallocate_environment();
+	}
+	interp.set_p(interp.cp());
+
+	interp.set_top_fail(false);
+	interp.set_complete(false);
+
+	if (!ok) {
 	    interp.set_cp(interp.empty_list());
+	    return false;
+	}
+	if (has_witness) {
+	    // Its choice point continues with CP
+	    return next_bag(interp, witness, output, result);
+	}
+	interp.set_cp(interp.empty_list());
+	return interp.unify(result, output);
+    }
+
+    //
+    // bagof/3 and setof/3. Template^Goal marks variables of Template
+    // as not free; the other free variables of Goal (the witness) get
+    // one bag per distinct binding, on backtracking.
+    //
+    void builtins::bagof(interpreter_base &interp, bool is_set,
+			 const std::string &name, term args[])
+    {
+	static const con_cell caret("^", 2);
+	static const con_cell witness_f("$w", 0);
+	static const con_cell pair("-", 2);
 
-	    interp.set_top_fail(false);
-	    interp.set_complete(false);
+	term templ = args[0];
+	term goal = interp.deref(args[1]);
 
-	    return interp.unify(result, output);
+	std::unordered_set<term> bound;
+	for (auto t : interp.iterate_over(templ)) {
+	    if (t.tag() == tag_t::REF) bound.insert(t);
+	}
+	while (goal.tag() == tag_t::STR && interp.functor(goal) == caret) {
+	    for (auto t : interp.iterate_over(interp.arg(goal, 0))) {
+		if (t.tag() == tag_t::REF) bound.insert(t);
+	    }
+	    goal = interp.arg(goal, 1);
+	}
+	if (goal.tag() == tag_t::REF) {
+	    interp.abort(interpreter_exception_not_sufficiently_instantiated(name + ": Arguments are not sufficiently instantiated"));
 	}
 
-	uint64_t cost = 0;
-	auto elem = interp.secondary_env().copy(context->template_, interp, cost);
-        interp.add_accumulated_cost(cost);
-	auto newtail = interp.secondary_env().new_dotted_pair(
-			      elem, interp.secondary_env().empty_list());
-	if (interp.secondary_env().is_empty_list(context->interim_)) {
-	    context->interim_ = newtail;
-	    context->tail_ = context->interim_;
+	std::vector<term> free;
+	for (auto t : interp.iterate_over(goal)) {
+	    if (t.tag() == tag_t::REF && !bound.count(t)) {
+		bound.insert(t);
+		free.push_back(t);
+	    }
+	}
+
+	if (free.empty()) {
+	    collect(interp, is_set ? COLLECT_SET : COLLECT_BAG, true,
+		    templ, goal, args[2], interp.empty_list());
+	    return;
+	}
+	term witness = interp.new_term(interp.to_functor(witness_f,
+							 free.size()));
+	for (size_t i = 0; i < free.size(); i++) {
+	    interp.set_arg(witness, i, free[i]);
+	}
+	collect(interp, is_set ? COLLECT_SET : COLLECT_BAG, true,
+		interp.new_term(pair, {witness, templ}), goal, args[2],
+		witness);
+    }
+
+    bool builtins::bagof_3(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	bagof(interp, false, "bagof/3", args);
+	return true;
+    }
+
+    bool builtins::setof_3(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	bagof(interp, true, "setof/3", args);
+	return true;
+    }
+
+    // The other bags of bagof/setof (on backtracking.)
+    bool builtins::bag_cont_3(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return next_bag(interp, args[0], args[1], args[2]);
+    }
+
+    //
+    // aggregate_all(Spec, Goal, Result) where Spec is count, sum(Expr),
+    // max(X), max(X, W), min(X), min(X, W), bag(X) or set(X).
+    //
+    bool builtins::aggregate_all_3(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	static const con_cell count("count", 0);
+	static const con_cell sum("sum", 1);
+	static const con_cell max1("max", 1), max2("max", 2);
+	static const con_cell min1("min", 1), min2("min", 2);
+	static const con_cell bag("bag", 1), set("set", 1);
+
+	term spec = interp.deref(args[0]);
+	if (spec.tag() == tag_t::REF) {
+	    interp.abort(interpreter_exception_not_sufficiently_instantiated("aggregate_all/3: Arguments are not sufficiently instantiated"));
+	}
+	if (spec == count) {
+	    collect(interp, COLLECT_COUNT, false, spec, args[1], args[2],
+		    interp.empty_list());
+	    return true;
+	}
+	con_cell f = interp.is_functor(spec) ? interp.functor(spec) : con_cell();
+	collect_kind_t kind;
+	term templ = spec;
+	if (f == sum) {
+	    kind = COLLECT_SUM;
+	    templ = interp.arg(spec, 0);
+	} else if (f == max1 || f == max2) {
+	    // Kept as max(X) or max(X, W) and compared on X
+	    kind = COLLECT_MAX;
+	} else if (f == min1 || f == min2) {
+	    kind = COLLECT_MIN;
+	} else if (f == bag) {
+	    kind = COLLECT_BAG;
+	    templ = interp.arg(spec, 0);
+	} else if (f == set) {
+	    kind = COLLECT_SET;
+	    templ = interp.arg(spec, 0);
 	} else {
-	    interp.secondary_env().set_arg(context->tail_, 1, newtail);
-	    context->tail_ = newtail;
+	    interp.abort(interpreter_exception_wrong_arg_type("aggregate_all/3: Unknown aggregate " + interp.to_string(spec)));
+	    return false;
 	}
+	bool fail_if_empty = kind == COLLECT_MAX || kind == COLLECT_MIN;
+	collect(interp, kind, fail_if_empty, templ, args[1], args[2],
+		interp.empty_list());
+	return true;
+    }
 
-	interp.set_p(common::con_cell("fail",0));
-	interp.set_cp(interp.empty_list());
+    //
+    // '$predsort_call'(P, O, X, Y) calls P with O, X and Y as extra
+    // arguments (for predsort/3 in the standard library.)
+    //
+    bool builtins::predsort_call_4(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	term p = interp.deref(args[0]);
+	if (p.tag() == tag_t::REF) {
+	    interp.abort(interpreter_exception_not_sufficiently_instantiated("predsort/3: Arguments are not sufficiently instantiated"));
+	}
+	if (p.tag() != tag_t::CON && p.tag() != tag_t::STR) {
+	    interp.abort(interpreter_exception_wrong_arg_type("predsort/3: Predicate is not callable; found " + interp.to_string(p)));
+	}
+	con_cell f = interp.functor(p);
+	size_t n = f.arity();
+	term goal = interp.new_term(interp.to_functor(interp.to_atom(f), n + 3));
+	for (size_t i = 0; i < n; i++) {
+	    interp.set_arg(goal, i, interp.arg(p, i));
+	}
+	for (size_t i = 0; i < 3; i++) {
+	    interp.set_arg(goal, n + i, args[i + 1]);
+	}
+	interp.set_p(code_point(goal));
+	return true;
+    }
+
+    //
+    // Dynamic database
+    //
+
+    predicate_descriptor & builtins::dynamic_descriptor(interpreter_base &interp, term head, const std::string &context)
+    {
+	if (head.tag() == tag_t::REF) {
+	    interp.abort(interpreter_exception_not_sufficiently_instantiated(context + ": Arguments are not sufficiently instantiated"));
+	}
+	if (!interp.is_functor(head)) {
+	    interp.abort(interpreter_exception_wrong_arg_type(context + ": Expected a callable term, found '" + interp.to_string(head) + "'"));
+	}
+	auto f = interp.functor(head);
+	if (interp.is_builtin(interp.empty_list(), f)) {
+	    interp.abort(interpreter_exception_wrong_arg_type(context + ": Cannot modify builtin " + interp.atom_name(f) + "/" + boost::lexical_cast<std::string>(f.arity())));
+	}
+	auto &pd = interp.get_predicate_descriptor(interp.empty_list(), f);
+	interp.make_dynamic(pd);
+	return pd;
+    }
+
+    bool builtins::assert_clause(interpreter_base &interp, term clause, bool at_end, const std::string &context)
+    {
+	clause = interp.deref(clause);
+	if (clause.tag() == tag_t::REF) {
+	    interp.abort(interpreter_exception_not_sufficiently_instantiated(context + ": Arguments are not sufficiently instantiated"));
+	}
+	interp.syntax_check_stack_.clear();
+	interp.syntax_check_stack_.push_back(
+		  std::bind(&interpreter_base::syntax_check_clause, &interp,
+			    clause));
+	interp.syntax_check();
+
+	term head = interp.clause_head(clause);
+	auto &pd = dynamic_descriptor(interp, head, context);
+	interp.get_dynamic_db().add(*pd.dynamic, interp, clause, head,
+				    interp.cost(clause), at_end);
+	return true;
+    }
+
+    bool builtins::assert_1(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return assert_clause(interp, args[0], true, "assert/1");
+    }
+
+    bool builtins::asserta_1(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return assert_clause(interp, args[0], false, "asserta/1");
+    }
+
+    bool builtins::assertz_1(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	return assert_clause(interp, args[0], true, "assertz/1");
+    }
 
+    bool builtins::retract_1(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	term clause = interp.deref(args[0]);
+	if (clause.tag() == tag_t::REF) {
+	    interp.abort(interpreter_exception_not_sufficiently_instantiated("retract/1: Arguments are not sufficiently instantiated"));
+	}
+	term head = interp.deref(interp.clause_head(clause));
+	auto &pd = dynamic_descriptor(interp, head, "retract/1");
+	return interp.retract_dynamic(pd.id, clause, term());
+    }
+
+    bool builtins::retractall_1(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	term head = interp.deref(args[0]);
+	auto &pd = dynamic_descriptor(interp, head, "retractall/1");
+	auto &dp = *pd.dynamic;
+	auto &db = interp.get_dynamic_db();
+
+	uint64_t gen = db.generation();
+	auto &candidates = dp.select(interp, head);
+	// Retracting doesn't change the candidate lists
+	for (auto *c : candidates) {
+	    if (!c->is_visible(gen) || !c->is_alive()) {
+		continue;
+	    }
+	    size_t current_heap = interp.heap_size();
+	    size_t current_trail = interp.trail_size();
+	    size_t old_register_hb = interp.get_register_hb();
+	    interp.set_register_hb(current_heap);
+
+	    auto copy_clause = interp.copy(c->clause, db.env());
+	    if (interp.unify(interp.clause_head(copy_clause), head)) {
+		db.remove(dp, c);
+	    }
+
+	    interp.unwind_trail(current_trail, interp.trail_size());
+	    interp.trim_trail(current_trail);
+	    interp.trim_heap(current_heap);
+	    interp.set_register_hb(old_register_hb);
+	}
+	if (db.should_reclaim(dp)) {
+	    interp.reclaim_dynamic(dp);
+	}
+	return true;
+    }
+
+    // Continuation of a call to a dynamic predicate (on backtracking.)
+    bool builtins::dynamic_cont_4(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	auto id = static_cast<const int_cell &>(args[1]).value();
+	return interp.call_dynamic(id, args[0], interp.qr());
+    }
+
+    // Continuation of retract/1 (on backtracking.)
+    bool builtins::retract_cont_4(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	auto id = static_cast<const int_cell &>(args[1]).value();
+	return interp.retract_dynamic(id, args[0], interp.qr());
+    }
+
+    //
+    // Tabling
+    //
+
+    // Continuation of the answers of a tabled call (on backtracking.)
+    bool builtins::table_cont_4(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	auto id = static_cast<const int_cell &>(args[1]).value();
+	return interp.tabled_answers(id, args[0], interp.qr());
+    }
+
+    bool builtins::abolish_all_tables_0(interpreter_base &interp, size_t arity, common::term args[])
+    {
+	interp.abolish_all_tables();
 	return true;
     }
 
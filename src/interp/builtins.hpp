@@ -9,7 +9,19 @@ namespace prologcoin { namespace interp {
 
     class interpreter_base;
     class meta_reason_t;
+    struct predicate_descriptor;
     struct meta_context;
+    struct meta_context_findall;
+
+    // What findall/3, bagof/3, setof/3 and aggregate_all/3 collect
+    enum collect_kind_t {
+	COLLECT_BAG,
+	COLLECT_SET,
+	COLLECT_COUNT,
+	COLLECT_SUM,
+	COLLECT_MAX,
+	COLLECT_MIN
+    };
 
     // We avoid std::function, because it is not as efficient as a
     // "raw" C function pointer.
@@ -152,6 +164,13 @@ namespace prologcoin { namespace interp {
 	//
 
 	static bool is_2(interpreter_base &interp, size_t arity, common::term args[]);
+	static int arith_compare(interpreter_base &interp, common::term lhs, common::term rhs, const std::string &context);
+	static bool operator_less_than(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool operator_equals_less_than(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool operator_greater_than(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool operator_greater_than_equals(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool operator_arith_equals(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool operator_arith_not_equals(interpreter_base &interp, size_t arity, common::term args[]);
 
 	//
 	// Analyzing & constructing terms
@@ -177,7 +196,47 @@ namespace prologcoin { namespace interp {
 	static bool operator_disprove(interpreter_base &interp, size_t arity, common::term args[]);
 	static bool operator_disprove_meta(interpreter_base &interp, const meta_reason_t &reason);
 	static bool findall_3(interpreter_base &interp, size_t arity, common::term args[]);
-	static bool findall_3_meta(interpreter_base &interp, const meta_reason_t &reason);
+	static bool collect_meta(interpreter_base &interp, const meta_reason_t &reason);
+	static bool bagof_3(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool setof_3(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool bag_cont_3(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool aggregate_all_3(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool predsort_call_4(interpreter_base &interp, size_t arity, common::term args[]);
+
+	//
+	// Dynamic database
+	//
+
+	static bool assert_1(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool asserta_1(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool assertz_1(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool retract_1(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool retractall_1(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool dynamic_cont_4(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool retract_cont_4(interpreter_base &interp, size_t arity, common::term args[]);
+
+	//
+	// Tabling
+	//
+
+	static bool table_cont_4(interpreter_base &interp, size_t arity, common::term args[]);
+	static bool abolish_all_tables_0(interpreter_base &interp, size_t arity, common::term args[]);
+    private:
+	static bool assert_clause(interpreter_base &interp, common::term clause,
+				  bool at_end, const std::string &context);
+	static predicate_descriptor & dynamic_descriptor(interpreter_base &interp,
+						       common::term head,
+						       const std::string &context);
+	static void collect(interpreter_base &interp, collect_kind_t kind,
+			    bool fail_if_empty, common::term templ,
+			    common::term goal, common::term result,
+			    common::term witness);
+	static void add_solution(interpreter_base &interp,
+				 meta_context_findall *context);
+	static bool next_bag(interpreter_base &interp, common::term witness,
+			     common::term bag, common::term groups);
+	static void bagof(interpreter_base &interp, bool is_set,
+			  const std::string &name, common::term args[]);
     };
 
 }}
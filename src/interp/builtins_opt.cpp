@@ -1,53 +1,343 @@
 #include "builtins_opt.hpp"
 #include "interpreter_base.hpp"
+#include <algorithm>
+#include <thread>
 
 namespace prologcoin { namespace interp {
 
     using namespace prologcoin::common;
     using namespace boost::logic;
 
-    tribool builtins_opt::sort_2(interpreter_base &interp, size_t arity, term args[])
-    {
-        term arg0 = args[0];
-	term arg1 = args[1];
+    //
+    // sort/2, msort/2, sort/4 and keysort/2 share one implementation.
+    // The elements are sorted (stably) on a key, which is the element
+    // itself or one of its arguments, in standard order.
+    //
+    // If all keys are small integers or all are atoms, each key is
+    // first mapped to a number with the same order, and those are
+    // radix sorted; a very long list is sorted in chunks by several
+    // threads and the chunks are then merged. Other keys are merge
+    // sorted with the standard order of terms.
+    //
 
-	if (arg0.tag() == tag_t::REF) {
-            interp.abort(interpreter_exception_not_sufficiently_instantiated("sort/2: Arguments are not sufficiently instantiated"));
+    struct sort_spec {
+	size_t key;      // 0 for the element, otherwise the argument
+	bool descending;
+	bool dedup;      // Keep only the first of elements with equal keys
+	bool pairs;      // Elements must be Key-Value pairs
+    };
+
+    typedef std::pair<uint64_t, size_t> sort_item; // (rank, index)
+
+    // Radix sort (on the rank) is stable, and so are the merges.
+    static const size_t RADIX_SORT_MIN = 64;
+    static const size_t PARALLEL_SORT_MIN = 1 << 16;
+    static const size_t PARALLEL_SORT_MAX_THREADS = 8;
+
+    size_t builtins_opt::sort_threads_ = 0;
+
+    uint64_t builtins_opt::sort_cost(size_t n)
+    {
+	uint64_t log_n = 0;
+	while ((static_cast<uint64_t>(1) << log_n) < n) {
+	    log_n++;
 	}
+	return 2 * n + n * log_n;
+    }
 
-	if (!interp.is_list(arg0)) {
-            interp.abort(interpreter_exception_not_sufficiently_instantiated("sort/2: First argument is not a list; found " + interp.to_string(arg0)));
+    void builtins_opt::get_elements(interpreter_base &interp, term lst,
+				    std::vector<term> &elems,
+				    const std::string &name)
+    {
+	term t = interp.deref(lst);
+	while (interp.is_dotted_pair(t)) {
+	    elems.push_back(interp.deref(interp.arg(t, 0)));
+	    t = interp.deref(interp.arg(t, 1));
+	}
+	if (t.tag() == tag_t::REF) {
+            interp.abort(interpreter_exception_not_sufficiently_instantiated(name + ": Arguments are not sufficiently instantiated"));
 	}
+	if (!interp.is_empty_list(t)) {
+            interp.abort(interpreter_exception_not_sufficiently_instantiated(name + ": First argument is not a list; found " + interp.to_string(lst)));
+	}
+    }
 
-	interp.add_accumulated_cost(interp.cost(arg0));
+    void builtins_opt::get_keys(interpreter_base &interp,
+				const std::vector<term> &elems,
+				const sort_spec &spec, std::vector<term> &keys,
+				const std::string &name)
+    {
+	static const con_cell pair("-", 2);
 
-	size_t n = interp.list_length(arg0);
+	size_t key = spec.key;
+	if (key == 0) {
+	    keys = elems;
+	    return;
+	}
+	keys.reserve(elems.size());
+	for (auto e : elems) {
+	    if (spec.pairs && !interp.is_functor(e, pair)) {
+		interp.abort(interpreter_exception_wrong_arg_type(name + ": Element is not a pair; found " + interp.to_string(e)));
+	    }
+	    if (e.tag() != tag_t::STR || interp.functor(e).arity() < key) {
+		interp.abort(interpreter_exception_wrong_arg_type(name + ": Element has no argument " + boost::lexical_cast<std::string>(key) + "; found " + interp.to_string(e)));
+	    }
+	    keys.push_back(interp.deref(interp.arg(e, key - 1)));
+	}
+    }
 
-	std::vector<term> vec(n);
+    // Ranks (with the order of the keys) if all keys are small integers
+    // or all are atoms.
+    static bool get_ranks(interpreter_base &interp, const std::vector<term> &keys,
+			  std::vector<sort_item> &items)
+    {
+	static const uint64_t SIGN = static_cast<uint64_t>(1) << 63;
+
+	size_t n = keys.size();
+	if (n == 0) {
+	    return true;
+	}
+	items.resize(n);
+	if (keys[0].tag() == tag_t::INT) {
+	    for (size_t i = 0; i < n; i++) {
+		if (keys[i].tag() != tag_t::INT) {
+		    return false;
+		}
+		auto v = static_cast<const int_cell &>(keys[i]).value();
+		items[i] = sort_item(static_cast<uint64_t>(v) ^ SIGN, i);
+	    }
+	    return true;
+	}
+	if (keys[0].tag() != tag_t::CON) {
+	    return false;
+	}
+	// Atoms are ordered on arity and then name. Order the distinct
+	// ones (with their names looked up once.)
+	std::unordered_map<cell, uint64_t> rank;
+	for (auto k : keys) {
+	    if (k.tag() != tag_t::CON) {
+		return false;
+	    }
+	    rank[k] = 0;
+	}
+	std::vector<std::pair<std::pair<size_t, std::string>, cell> > atoms;
+	atoms.reserve(rank.size());
+	for (auto &r : rank) {
+	    con_cell f = static_cast<con_cell &>(const_cast<cell &>(r.first));
+	    atoms.push_back(std::make_pair(std::make_pair(f.arity(),
+							  interp.atom_name(f)),
+					   r.first));
+	}
+	std::sort(atoms.begin(), atoms.end());
+	for (size_t i = 0; i < atoms.size(); i++) {
+	    rank[atoms[i].second] = i;
+	}
+	for (size_t i = 0; i < n; i++) {
+	    items[i] = sort_item(rank[keys[i]], i);
+	}
+	return true;
+    }
 
+    // Least significant digit first, 8 bits at a time. A digit that is
+    // the same for all items is skipped.
+    static void radix_sort(sort_item *items, sort_item *tmp, size_t n)
+    {
+	if (n < RADIX_SORT_MIN) {
+	    std::stable_sort(items, items + n,
+			     [](const sort_item &a, const sort_item &b)
+			     { return a.first < b.first; });
+	    return;
+	}
+	size_t counts[8][256] = { };
 	for (size_t i = 0; i < n; i++) {
-	    term el = interp.arg(arg0, 0);
-	    vec[i] = el;
-	    arg0 = interp.arg(arg0, 1);
+	    uint64_t r = items[i].first;
+	    for (size_t d = 0; d < 8; d++) {
+		counts[d][(r >> (8*d)) & 0xff]++;
+	    }
+	}
+	sort_item *from = items, *to = tmp;
+	for (size_t d = 0; d < 8; d++) {
+	    auto &count = counts[d];
+	    if (count[(from[0].first >> (8*d)) & 0xff] == n) {
+		continue;
+	    }
+	    size_t pos[256];
+	    size_t sum = 0;
+	    for (size_t i = 0; i < 256; i++) {
+		pos[i] = sum;
+		sum += count[i];
+	    }
+	    for (size_t i = 0; i < n; i++) {
+		to[pos[(from[i].first >> (8*d)) & 0xff]++] = from[i];
+	    }
+	    std::swap(from, to);
+	}
+	if (from != items) {
+	    std::copy(from, from + n, items);
+	}
+    }
+
+    static void parallel_radix_sort(std::vector<sort_item> &items,
+				    size_t num_threads)
+    {
+	size_t n = items.size();
+	if (n < 2) {
+	    return;
+	}
+	std::vector<sort_item> tmp(n);
+	if (n < PARALLEL_SORT_MIN || num_threads < 2) {
+	    radix_sort(&items[0], &tmp[0], n);
+	    return;
 	}
 
-	std::stable_sort(vec.begin(), vec.end(),
-			 [&](const term &t1, const term &t2)
-			 { return interp.standard_order(t1,t2) < 0; } );
+	// Sort chunks, then merge them pairwise
+	std::vector<size_t> bounds;
+	for (size_t i = 0; i <= num_threads; i++) {
+	    bounds.push_back(n * i / num_threads);
+	}
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < num_threads; i++) {
+	    size_t from = bounds[i], to = bounds[i+1];
+	    threads.push_back(std::thread([&items, &tmp, from, to]() {
+			radix_sort(&items[from], &tmp[from], to - from); }));
+	}
+	for (auto &t : threads) t.join();
 
-	vec.erase( std::unique(vec.begin(), vec.end()), vec.end());
-	n = vec.size();
+	auto less = [](const sort_item &a, const sort_item &b)
+	    { return a.first < b.first; };
+	while (bounds.size() > 2) {
+	    threads.clear();
+	    std::vector<size_t> merged;
+	    for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+		merged.push_back(bounds[i]);
+		if (i + 2 >= bounds.size()) {
+		    // An odd chunk out
+		    std::copy(items.begin() + bounds[i], items.begin() + bounds[i+1],
+			      tmp.begin() + bounds[i]);
+		    continue;
+		}
+		size_t a = bounds[i], b = bounds[i+1], c = bounds[i+2];
+		threads.push_back(std::thread([&items, &tmp, a, b, c, less]() {
+			    std::merge(items.begin() + a, items.begin() + b,
+				       items.begin() + b, items.begin() + c,
+				       tmp.begin() + a, less); }));
+	    }
+	    merged.push_back(n);
+	    for (auto &t : threads) t.join();
+	    items.swap(tmp);
+	    bounds.swap(merged);
+	}
+    }
 
-	// Build list from vector
+    tribool builtins_opt::sort_list(interpreter_base &interp, term lst,
+				    term result, const sort_spec &spec,
+				    const std::string &name)
+    {
+	std::vector<term> elems, keys;
+	get_elements(interp, lst, elems, name);
+	get_keys(interp, elems, spec, keys, name);
+
+	size_t n = elems.size();
+	interp.add_accumulated_cost(builtins_opt::sort_cost(n));
+
+	std::vector<sort_item> items;
+	bool ranked = get_ranks(interp, keys, items);
+	if (ranked) {
+	    if (spec.descending) {
+		for (auto &item : items) item.first = ~item.first;
+	    }
+	    size_t num_threads = sort_threads_;
+	    if (num_threads == 0) {
+		num_threads = std::thread::hardware_concurrency();
+	    }
+	    parallel_radix_sort(items, std::min(num_threads,
+						PARALLEL_SORT_MAX_THREADS));
+	} else {
+	    uint64_t cost = 0;
+	    auto order = [&](const sort_item &a, const sort_item &b)
+		{ int cmp = interp.common::term_env::standard_order(
+			keys[a.second], keys[b.second], cost);
+		  return spec.descending ? cmp > 0 : cmp < 0; };
+	    items.resize(n);
+	    for (size_t i = 0; i < n; i++) {
+		items[i] = sort_item(0, i);
+	    }
+	    std::stable_sort(items.begin(), items.end(), order);
+	}
+
+	if (spec.dedup && n > 0) {
+	    uint64_t cost = 0;
+	    size_t j = 0;
+	    for (size_t i = 1; i < n; i++) {
+		bool same = ranked
+		    ? items[i].first == items[j].first
+		    : interp.common::term_env::standard_order(
+			  keys[items[i].second], keys[items[j].second],
+			  cost) == 0;
+		if (!same) {
+		    items[++j] = items[i];
+		}
+	    }
+	    n = j + 1;
+	}
 
 	term r = interp.empty_list();
-	
-	for (size_t i = 0; i < n; i++) {
-	    term el = vec[n-i-1];
-	    r = interp.new_dotted_pair(el, r);
+	for (size_t i = n; i > 0; i--) {
+	    r = interp.new_dotted_pair(elems[items[i-1].second], r);
 	}
+	return interp.unify(result, r);
+    }
 
-	bool ok = interp.unify(arg1, r);
-	return ok;
+    tribool builtins_opt::sort_2(interpreter_base &interp, size_t arity, term args[])
+    {
+	static const sort_spec spec = { 0, false, true, false };
+	if (args[0].tag() == tag_t::REF) {
+            interp.abort(interpreter_exception_not_sufficiently_instantiated("sort/2: Arguments are not sufficiently instantiated"));
+	}
+	return sort_list(interp, args[0], args[1], spec, "sort/2");
+    }
+
+    tribool builtins_opt::msort_2(interpreter_base &interp, size_t arity, term args[])
+    {
+	static const sort_spec spec = { 0, false, false, false };
+	return sort_list(interp, args[0], args[1], spec, "msort/2");
+    }
+
+    tribool builtins_opt::keysort_2(interpreter_base &interp, size_t arity, term args[])
+    {
+	static const sort_spec spec = { 1, false, false, true };
+	return sort_list(interp, args[0], args[1], spec, "keysort/2");
+    }
+
+    //
+    // sort(Key, Order, List, Sorted) where Order is @< or @> (remove
+    // duplicates) or @=< or @>= (keep them.)
+    //
+    tribool builtins_opt::sort_4(interpreter_base &interp, size_t arity, term args[])
+    {
+	static const con_cell asc("@<", 0), asc_dup("@=<", 0);
+	static const con_cell desc("@>", 0), desc_dup("@>=", 0);
+
+	term key = interp.deref(args[0]);
+	term order = interp.deref(args[1]);
+	if (key.tag() == tag_t::REF || order.tag() == tag_t::REF) {
+            interp.abort(interpreter_exception_not_sufficiently_instantiated("sort/4: Arguments are not sufficiently instantiated"));
+	}
+	if (key.tag() != tag_t::INT ||
+	    static_cast<const int_cell &>(key).value() < 0) {
+	    interp.abort(interpreter_exception_wrong_arg_type("sort/4: Key must be a non-negative integer; found " + interp.to_string(key)));
+	}
+	sort_spec spec;
+	spec.key = static_cast<size_t>(static_cast<const int_cell &>(key).value());
+	if (order == asc || order == asc_dup) {
+	    spec.descending = false;
+	} else if (order == desc || order == desc_dup) {
+	    spec.descending = true;
+	} else {
+	    interp.abort(interpreter_exception_wrong_arg_type("sort/4: Order must be one of @<, @=<, @> or @>=; found " + interp.to_string(order)));
+	}
+	spec.dedup = order == asc || order == desc;
+	spec.pairs = false;
+	return sort_list(interp, args[2], args[3], spec, "sort/4");
     }
 }}
@@ -8,6 +8,7 @@
 
 namespace prologcoin { namespace interp {
     class interpreter_base;
+    struct sort_spec;
 
     using namespace boost::logic;
 
@@ -17,10 +18,34 @@ namespace prologcoin { namespace interp {
     public:
 
         static tribool sort_2(interpreter_base &interp, size_t arity, common::term caller[]);
+        static tribool msort_2(interpreter_base &interp, size_t arity, common::term caller[]);
+        static tribool sort_4(interpreter_base &interp, size_t arity, common::term caller[]);
+        static tribool keysort_2(interpreter_base &interp, size_t arity, common::term caller[]);
+
+	// The cost of sorting a list of n elements. It is a function of
+	// n only (n log n comparisons and two passes over the list), so
+	// it does not depend on which sorting path was taken.
+	static uint64_t sort_cost(size_t n);
+
+	// Threads for sorting very long lists (0 is one per core.)
+	static void set_sort_threads(size_t n) { sort_threads_ = n; }
+
+    private:
+	static size_t sort_threads_;
+
+	static void get_elements(interpreter_base &interp, common::term lst,
+				 std::vector<common::term> &elems,
+				 const std::string &name);
+	static void get_keys(interpreter_base &interp,
+			     const std::vector<common::term> &elems,
+			     const sort_spec &spec,
+			     std::vector<common::term> &keys,
+			     const std::string &name);
+	static tribool sort_list(interpreter_base &interp, common::term lst,
+				 common::term result, const sort_spec &spec,
+				 const std::string &name);
     };
 
 }}
 
 #endif
-
-
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include "dynamic_db.hpp"
+
+namespace prologcoin { namespace interp {
+
+using namespace prologcoin::common;
+
+//
+// dynamic_predicate
+//
+
+dynamic_predicate::dynamic_predicate(size_t arity)
+    : arity_(arity), first_serial_(0), last_serial_(-1), num_dead_(0),
+      args_(arity)
+{
+    if (arity_ > 0) {
+	args_[0].built = true;
+    }
+}
+
+dynamic_predicate::~dynamic_predicate()
+{
+    for (auto *c : all_) {
+	delete c;
+    }
+}
+
+size_t dynamic_predicate::num_indexes() const
+{
+    size_t n = 0;
+    for (auto &aindex : args_) {
+	if (aindex.built) n++;
+    }
+    return n;
+}
+
+cell dynamic_predicate::index_key(term_env &env, const term t0)
+{
+    term t = env.deref(t0);
+    switch (t.tag()) {
+    case tag_t::STR: return env.functor(t);
+    case tag_t::CON:
+    case tag_t::INT: return t;
+    default: return term();
+    }
+}
+
+const dynamic_clauses & dynamic_predicate::select(term_env &env, term goal)
+{
+    if (arity_ == 0 || all_.size() < 2) {
+	return all_;
+    }
+    for (size_t i = 0; i < arity_; i++) {
+	auto key = index_key(env, env.arg(goal, i));
+	if (key == term()) {
+	    continue;
+	}
+	auto &aindex = args_[i];
+	if (!aindex.built) {
+	    if (all_.size() < MIN_INDEX_CLAUSES) {
+		continue;
+	    }
+	    build_index(i);
+	}
+	auto it = aindex.by_key.find(key);
+	return it == aindex.by_key.end() ? aindex.vars : it->second;
+    }
+    return all_;
+}
+
+size_t dynamic_predicate::position_after(const dynamic_clauses &list,
+					 int64_t serial)
+{
+    auto it = std::upper_bound(list.begin(), list.end(), serial,
+			       [](int64_t s, const dynamic_clause *c)
+			       { return s < c->serial; });
+    return static_cast<size_t>(it - list.begin());
+}
+
+void dynamic_predicate::build_index(size_t arg_pos)
+{
+    auto &aindex = args_[arg_pos];
+    aindex.built = true;
+    for (auto *c : all_) {
+	add_to_index(arg_pos, c, true);
+    }
+}
+
+void dynamic_predicate::add_to_index(size_t arg_pos, dynamic_clause *c,
+				     bool at_end)
+{
+    auto &aindex = args_[arg_pos];
+    auto key = c->keys[arg_pos];
+    if (key == term()) {
+	for (auto &e : aindex.by_key) {
+	    if (at_end) e.second.push_back(c); else e.second.push_front(c);
+	}
+	if (at_end) aindex.vars.push_back(c); else aindex.vars.push_front(c);
+	return;
+    }
+    auto it = aindex.by_key.find(key);
+    if (it == aindex.by_key.end()) {
+	it = aindex.by_key.insert(std::make_pair(key, aindex.vars)).first;
+    }
+    if (at_end) it->second.push_back(c); else it->second.push_front(c);
+}
+
+void dynamic_predicate::add(dynamic_clause *c, bool at_end)
+{
+    c->serial = at_end ? ++last_serial_ : --first_serial_;
+    if (all_.empty()) {
+	first_serial_ = last_serial_ = c->serial;
+    }
+    if (at_end) all_.push_back(c); else all_.push_front(c);
+    for (size_t i = 0; i < arity_; i++) {
+	if (args_[i].built) {
+	    add_to_index(i, c, at_end);
+	}
+    }
+}
+
+size_t dynamic_predicate::remove_dead(uint64_t oldest)
+{
+    auto is_free = [oldest](const dynamic_clause *c)
+	           { return c->died <= oldest; };
+
+    for (auto &aindex : args_) {
+	for (auto it = aindex.by_key.begin(); it != aindex.by_key.end();) {
+	    auto &lst = it->second;
+	    lst.erase(std::remove_if(lst.begin(), lst.end(), is_free),
+		      lst.end());
+	    if (lst.empty()) {
+		it = aindex.by_key.erase(it);
+	    } else {
+		++it;
+	    }
+	}
+	auto &vars = aindex.vars;
+	vars.erase(std::remove_if(vars.begin(), vars.end(), is_free),
+		   vars.end());
+    }
+
+    size_t n = 0;
+    auto end = std::remove_if(all_.begin(), all_.end(),
+			      [&](dynamic_clause *c) {
+				  if (!is_free(c)) return false;
+				  delete c;
+				  n++;
+				  return true;
+			      });
+    all_.erase(end, all_.end());
+    num_dead_ -= n;
+    return n;
+}
+
+//
+// dynamic_db
+//
+
+dynamic_db::dynamic_db()
+    : env_(new term_env()), generation_(0), live_words_(0)
+{
+}
+
+dynamic_db::~dynamic_db()
+{
+    predicates_.clear();
+}
+
+dynamic_predicate * dynamic_db::new_predicate(size_t arity)
+{
+    predicates_.push_back(std::unique_ptr<dynamic_predicate>(
+			      new dynamic_predicate(arity)));
+    return predicates_.back().get();
+}
+
+dynamic_clause * dynamic_db::add(dynamic_predicate &dp, term_env &src,
+				 term clause, term head,
+				 uint64_t cost, bool at_end)
+{
+    auto *c = new dynamic_clause();
+    c->keys.resize(dp.arity());
+    for (size_t i = 0; i < dp.arity(); i++) {
+	c->keys[i] = dynamic_predicate::index_key(src, src.arg(head, i));
+    }
+
+    uint64_t copy_cost = 0;
+    size_t h = env_->heap_size();
+    c->clause = env_->copy(clause, src, copy_cost);
+    // Variable names are only useful in the source
+    env_->var_naming().clear();
+    c->words = env_->heap_size() - h;
+    c->cost = cost;
+    c->born = ++generation_;
+    c->died = dynamic_clause::ALIVE;
+    live_words_ += c->words;
+
+    dp.add(c, at_end);
+    return c;
+}
+
+void dynamic_db::remove(dynamic_predicate &dp, dynamic_clause *c)
+{
+    if (c->is_alive()) {
+	c->died = ++generation_;
+	dp.num_dead_++;
+    }
+}
+
+void dynamic_db::clear(dynamic_predicate &dp)
+{
+    generation_++;
+    for (auto *c : dp.all_) {
+	if (c->is_alive()) {
+	    c->died = generation_;
+	    dp.num_dead_++;
+	}
+    }
+}
+
+size_t dynamic_db::reclaim(dynamic_predicate &dp, uint64_t oldest)
+{
+    size_t words = 0;
+    for (auto *c : dp.all_) {
+	if (c->died <= oldest) {
+	    words += c->words;
+	}
+    }
+    size_t n = dp.remove_dead(oldest);
+    live_words_ -= words;
+
+    static const size_t MIN_COMPACT_WORDS = 64*1024;
+    if (env_->heap_size() > MIN_COMPACT_WORDS &&
+	env_->heap_size() > 2*live_words_) {
+	compact();
+    }
+    return n;
+}
+
+void dynamic_db::compact()
+{
+    std::unique_ptr<term_env> new_env(new term_env());
+    live_words_ = 0;
+    for (auto &dp : predicates_) {
+	for (auto *c : dp->all_) {
+	    uint64_t cost = 0;
+	    size_t h = new_env->heap_size();
+	    c->clause = new_env->copy(c->clause, *env_, cost);
+	    c->words = new_env->heap_size() - h;
+	    live_words_ += c->words;
+	}
+    }
+    new_env->var_naming().clear();
+    env_.swap(new_env);
+}
+
+}}
@@ -0,0 +1,156 @@
+#pragma once
+
+#ifndef _interp_dynamic_db_hpp
+#define _interp_dynamic_db_hpp
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../common/term_env.hpp"
+
+namespace prologcoin { namespace interp {
+
+//
+// A clause of a dynamic predicate. It is visible to a call that
+// started at generation G if born <= G < died; the clauses a call
+// iterates over are thus fixed when it starts (the logical update
+// view), whatever is asserted or retracted meanwhile.
+//
+struct dynamic_clause {
+    static const uint64_t ALIVE = static_cast<uint64_t>(-1);
+
+    common::term clause;
+    uint64_t cost;
+    int64_t serial;  // Clause order (asserta counts down, assertz up)
+    uint64_t born;
+    uint64_t died;   // ALIVE if not retracted
+    size_t words;    // Heap words of the stored clause
+    std::vector<common::cell> keys; // Index key per argument
+
+    inline bool is_visible(uint64_t gen) const
+        { return born <= gen && gen < died; }
+    inline bool is_alive() const
+        { return died == ALIVE; }
+};
+
+typedef std::deque<dynamic_clause *> dynamic_clauses;
+
+//
+// The clauses of a dynamic predicate in clause order, indexed on the
+// first argument. Other arguments are indexed on demand: the first
+// call that binds one of them (but not the first argument) builds an
+// index for it, which is then maintained by assert.
+//
+// An index maps the key of an argument (see index_key) to the clauses
+// that could match it, i.e. including those with a variable there.
+// All lists are ordered by serial, so a call can continue after the
+// last clause it tried with a binary search, even if clauses were
+// added or reclaimed in between.
+//
+class dynamic_predicate {
+public:
+    dynamic_predicate(size_t arity);
+    ~dynamic_predicate();
+
+    // Fewer clauses than this are never indexed on demand.
+    static const size_t MIN_INDEX_CLAUSES = 8;
+
+    inline size_t arity() const { return arity_; }
+    inline size_t size() const { return all_.size(); }
+    inline size_t num_alive() const { return all_.size() - num_dead_; }
+    inline size_t num_dead() const { return num_dead_; }
+    inline const dynamic_clauses & clauses() const { return all_; }
+    size_t num_indexes() const;
+
+    // The candidate clauses for a call to 'goal' (in 'env'.)
+    const dynamic_clauses & select(common::term_env &env, common::term goal);
+
+    // Position of the first clause in 'list' after 'serial'.
+    static size_t position_after(const dynamic_clauses &list, int64_t serial);
+
+    // Key of a (call or head) argument, term() for an unbound
+    // variable (or a bignum, which isn't indexed.)
+    static common::cell index_key(common::term_env &env, common::term t);
+
+private:
+    friend class dynamic_db;
+
+    struct arg_index {
+	arg_index() : built(false) { }
+
+	bool built;
+	std::unordered_map<common::cell, dynamic_clauses> by_key;
+	dynamic_clauses vars; // Clauses with a var (for any other key)
+    };
+
+    void add(dynamic_clause *c, bool at_end);
+    void build_index(size_t arg_pos);
+    void add_to_index(size_t arg_pos, dynamic_clause *c, bool at_end);
+    size_t remove_dead(uint64_t oldest);
+
+    size_t arity_;
+    int64_t first_serial_;
+    int64_t last_serial_;
+    size_t num_dead_;
+    dynamic_clauses all_;
+    std::vector<arg_index> args_;
+};
+
+//
+// Store of all dynamic predicates. Clauses are copied to a heap of
+// their own, so that they outlive the query that asserted them, and
+// are copied back to the interpreter heap when called.
+//
+// Retracted clauses are reclaimed once no running call could still
+// see them (the caller tells the oldest generation of those.) The
+// heap is compacted when most of it holds reclaimed clauses.
+//
+class dynamic_db {
+public:
+    dynamic_db();
+    ~dynamic_db();
+
+    // Dead clauses a predicate accumulates before reclaiming them
+    // is worthwhile.
+    static const size_t RECLAIM_THRESHOLD = 64;
+
+    inline common::term_env & env() { return *env_; }
+    inline uint64_t generation() const { return generation_; }
+
+    dynamic_predicate * new_predicate(size_t arity);
+
+    // Copy 'clause' (with 'head') from 'src' and add it first or last.
+    dynamic_clause * add(dynamic_predicate &dp, common::term_env &src,
+			 common::term clause, common::term head,
+			 uint64_t cost, bool at_end);
+
+    // Retract a clause (it stays until reclaimed.)
+    void remove(dynamic_predicate &dp, dynamic_clause *c);
+
+    // Retract all clauses.
+    void clear(dynamic_predicate &dp);
+
+    inline bool should_reclaim(const dynamic_predicate &dp) const
+        { return dp.num_dead() >= RECLAIM_THRESHOLD &&
+		 dp.num_dead() >= dp.num_alive(); }
+
+    // Free the clauses retracted at or before generation 'oldest'.
+    // Returns the number of clauses freed.
+    size_t reclaim(dynamic_predicate &dp, uint64_t oldest);
+
+    inline size_t num_predicates() const { return predicates_.size(); }
+    inline size_t live_words() const { return live_words_; }
+
+private:
+    void compact();
+
+    std::unique_ptr<common::term_env> env_;
+    std::vector<std::unique_ptr<dynamic_predicate> > predicates_;
+    uint64_t generation_;
+    size_t live_words_;
+};
+
+}}
+
+#endif
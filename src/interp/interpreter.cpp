@@ -8,7 +8,17 @@ interpreter::interpreter()
 {
     compiler_ = new wam_compiler(*this);
     id_to_predicate_.push_back(predicate()); // Reserve index 0
+    jit_index_entries_ = 0;
+    jit_index_limit_ = DEFAULT_JIT_INDEX_LIMIT;
+    jit_index_invalidations_ = 0;
+    jit_index_resets_ = 0;
+    auto_compile_threshold_ = DEFAULT_AUTO_COMPILE_THRESHOLD;
+    query_cache_size_ = DEFAULT_QUERY_CACHE_SIZE;
+    query_cache_hits_ = 0;
+    query_cache_misses_ = 0;
+    num_auto_compiled_ = 0;
     wam_enabled_ = true;
+    native_enabled_ = false;
     query_vars_ = nullptr;
     num_instances_ = 0;
 
@@ -25,7 +35,7 @@ interpreter::~interpreter()
 {
     delete compiler_;
     delete query_vars_;
-    predicate_id_.clear();
+    predicate_indexes_.clear();
     id_to_predicate_.clear();
 }
 
@@ -64,6 +74,44 @@ append([], Zs, Zs).
 append([X|Xs], Ys, [X|Zs]) :-
     append(Xs, Ys, Zs).
 
+%
+% predsort/3 (merge sort, elements that compare = are dropped)
+%
+
+predsort(P, L, Sorted) :-
+    '$predsort'(L, P, Sorted).
+
+'$predsort'([], _, []).
+'$predsort'([X|Xs], P, Sorted) :-
+    '$predsort1'(Xs, X, P, Sorted).
+
+'$predsort1'([], X, _, [X]).
+'$predsort1'([Y|Ys], X, P, Sorted) :-
+    '$predsort_split'([X,Y|Ys], L1, L2),
+    '$predsort'(L1, P, S1),
+    '$predsort'(L2, P, S2),
+    '$predmerge'(S1, S2, P, Sorted).
+
+'$predsort_split'([], [], []).
+'$predsort_split'([X|Xs], [X|Ys], Zs) :-
+    '$predsort_split'(Xs, Zs, Ys).
+
+'$predmerge'([], Ys, _, Ys).
+'$predmerge'([X|Xs], Ys, P, Zs) :-
+    '$predmerge1'(Ys, X, Xs, P, Zs).
+
+'$predmerge1'([], X, Xs, _, [X|Xs]).
+'$predmerge1'([Y|Ys], X, Xs, P, Zs) :-
+    '$predsort_call'(P, O, X, Y),
+    '$predmerge2'(O, X, Xs, Y, Ys, P, Zs).
+
+'$predmerge2'('<', X, Xs, Y, Ys, P, [X|Zs]) :-
+    '$predmerge'(Xs, [Y|Ys], P, Zs).
+'$predmerge2'('=', X, Xs, _, Ys, P, [X|Zs]) :-
+    '$predmerge'(Xs, Ys, P, Zs).
+'$predmerge2'('>', X, Xs, Y, Ys, P, [Y|Zs]) :-
+    '$predmerge1'(Ys, X, Xs, P, Zs).
+
 )PROG";
 
     load_program(lib);
@@ -142,9 +190,21 @@ bool interpreter::execute(const term query)
     }
 
     query_vars_->clear();
+    term goal = query;
+    if (is_wam_enabled() && !new_inst && !has_meta_context()) {
+	compile_hot_predicates();
+	if (query_cache_size_ != 0) {
+	    goal = compile_query(query);
+	}
+    }
+    if (!retired_predicate_ids_.empty()) {
+	release_retired_subsets();
+    }
     reset_accumulated_cost();
     set_top_fail(false);
     prepare_execution();
+    table_db_.reset_stack();
+    table_bypass_ = false;
 
     std::unordered_set<std::string> seen;
 
@@ -165,7 +225,7 @@ bool interpreter::execute(const term query)
     set_cp(code_point(empty_list()));
     set_qr(query);
 
-    set_p(code_point(query));
+    set_p(code_point(goal));
 
     bool b = cont();
 
@@ -181,30 +241,41 @@ bool interpreter::execute(const term query)
 bool interpreter::cont()
 {
     set_complete(false);
-    while (!is_complete()) {
-        while (!is_complete()) {
-	    if (p().has_wam_code()) {
-	        bool ok = cont_wam();
-		if (!ok) {
-	  	    fail();
+    try {
+	while (!is_complete()) {
+	    while (!is_complete()) {
+		if (p().has_wam_code()) {
+		    bool ok = cont_wam();
+		    if (!ok) {
+			fail();
+		    }
+		} else {
+		    dispatch();
 		}
-	    } else {
-		dispatch();
 	    }
-	}
 
-        if (is_complete() && has_meta_context()) {
-	    meta_context *mc = get_current_meta_context();
-	    meta_fn fn = mc->fn;
-	    if (!fn(*this, meta_reason_t::META_RETURN)) {
-		set_complete(false);
-		fail();
+	    if (is_complete() && has_meta_context()) {
+		meta_context *mc = get_current_meta_context();
+		meta_fn fn = mc->fn;
+		if (!fn(*this, meta_reason_t::META_RETURN)) {
+		    set_complete(false);
+		    fail();
+		}
 	    }
-        }
+	}
+    } catch (interpreter_exception &) {
+	// Costs deferred by the WAM may have passed the maximum before
+	// this was raised. Then running out of funds came first.
+	check_accumulated_cost();
+	throw;
     }
 
+    check_accumulated_cost();
+
     bool r = !is_top_fail();
 
+    shrink_stack();
+
     return r;
 }
 
@@ -287,6 +358,16 @@ void interpreter::fail()
 	    auto ch = reset_to_choice_point(b());
 	    auto bp = ch->bp;
 
+	    // A call from WAM has no goal term; its arguments are only
+	    // in the argument registers, which the previous clause body
+	    // may have overwritten.
+	    if (qr().tag() != common::tag_t::STR) {
+		set_num_of_args(ch->arity);
+		for (size_t i = 0; i < ch->arity; i++) {
+		    a(i) = ch->ai[i];
+		}
+	    }
+
 	    if (bp.is_fail()) {
 		// Do nothing
 	    } else if (bp.term_code().tag() != common::tag_t::INT) {
@@ -427,6 +508,8 @@ void interpreter::dispatch()
     static const con_cell default_module = empty_list();
     static const con_cell functor_colon(":",2);
 
+    check_accumulated_cost();
+
     set_qr(p().term_code());
 
     con_cell f = functor(qr());
@@ -502,8 +585,10 @@ void interpreter::dispatch()
 	break;
     }
 
+    auto &pd = get_predicate_descriptor(module, f);
+
     // Is this a built-in?
-    auto bf = get_builtin(module, f);
+    auto &bf = pd.bn;
     if (!bf.is_empty()) {
 	set_p(cp());
 	if (!bf.is_recursive()) {
@@ -518,9 +603,8 @@ void interpreter::dispatch()
     }
 
     // Is there a successful optimized built-in?
-    auto obf = get_builtin_opt(module, f);
-    if (obf != nullptr) {
-        tribool r = obf(*this, arity, args());
+    if (pd.bn_opt != nullptr) {
+        tribool r = (*pd.bn_opt)(*this, arity, args());
 	if (!indeterminate(r)) {
 	    set_p(cp());
 	    set_cp(empty_list());
@@ -531,36 +615,79 @@ void interpreter::dispatch()
 	}
     }
 
+    if (pd.tabled && !table_bypass_) {
+	set_pr(f);
+	term goal = p().term_code();
+	if (ptag == common::tag_t::STR) {
+	    if (functor(goal) == functor_colon) {
+		goal = arg(goal, 1);
+	    }
+	} else if (arity > 0) {
+	    goal = new_term(f);
+	    for (size_t i = 0; i < arity; i++) {
+		set_arg(goal, i, a(i));
+	    }
+	}
+	set_p(cp());
+	if (!call_tabled(goal)) {
+	    fail();
+	}
+	return;
+    }
+    // The evaluation of a tabled call runs its clauses
+    table_bypass_ = false;
+
+    if (pd.dynamic != nullptr) {
+	set_pr(f);
+	term goal = p().term_code();
+	if (ptag == common::tag_t::STR) {
+	    if (functor(goal) == functor_colon) {
+		goal = arg(goal, 1);
+	    }
+	} else if (arity > 0) {
+	    goal = new_term(f);
+	    for (size_t i = 0; i < arity; i++) {
+		set_arg(goal, i, a(i));
+	    }
+	}
+	if (!call_dynamic(pd.id, goal, term())) {
+	    fail();
+	}
+	return;
+    }
+
     if (is_wam_enabled()) {
-	if (auto instr = resolve_predicate(module, f)) {
-	    dispatch_wam(instr);
+	if (pd.is_compiled()) {
+	    dispatch_wam(to_code(pd.wam_offset));
 	    return;
 	}
+	// Compiled code costs less than interpreted code, so with cost
+	// tracking the cost of a query would depend on what ran before.
+	if (auto_compile_threshold_ != 0 && !is_track_cost()) {
+	    count_call(pd);
+	}
     }
 
-    auto first_arg = get_first_arg();
+    size_t predicate_id = matched_predicate_id(pd);
+
+    if (predicate_id == 0) {
+	std::stringstream msg;
+	msg << "Undefined predicate ";
+	if (!is_empty_list(module)) {
+	    msg << atom_name(module) << ":";
+	}
 
-    size_t predicate_id = matched_predicate_id(module, f, first_arg);
-    predicate  &pred = get_predicate_by_id(predicate_id);
+	msg << atom_name(f) << "/" << f.arity();
+	abort(interpreter_exception_undefined_predicate(msg.str()));
+	return;
+    }
 
     set_pr(f);
 
     // Otherwise a vector of clauses
-    auto &clauses = pred;
+    auto &clauses = get_predicate_by_id(predicate_id);
 
     if (clauses.empty()) {
-        clauses = get_predicate(module, f);
-	if (clauses.empty()) {
-	    std::stringstream msg;
-	    msg << "Undefined predicate ";
-	    if (!is_empty_list(module)) {
-		msg << atom_name(module) << ":";
-	    }
-
-	    msg << atom_name(f) << "/" << f.arity();
-	    abort(interpreter_exception_undefined_predicate(msg.str()));
-	    return;
-	}
 	set_p(empty_list());
 	fail();
 	return;
@@ -589,56 +716,479 @@ void interpreter::dispatch_wam(wam_instruction_base *instruction)
     set_p(instruction);
 }
 
-void interpreter::compute_matched_predicate(con_cell module,
-					    con_cell func,
-					    const term first_arg,
-					    predicate &matched)
+// Returns the key used to index an argument or term() if the
+// argument cannot be indexed (unbound or a bignum.)
+static inline common::cell jit_index_key(interpreter_base &interp,
+					 const common::term t0)
 {
-    auto &m_clauses = get_predicate(module, func);
-    for (auto &m_clause : m_clauses) {
-	// Extract head
+    using namespace prologcoin::common;
+
+    term t = interp.deref(t0);
+    switch (t.tag()) {
+    case tag_t::STR: return interp.functor(t);
+    case tag_t::CON:
+    case tag_t::INT: return t;
+    default: return term();
+    }
+}
+
+size_t interpreter::new_predicate_subset(predicate &clauses)
+{
+    size_t id;
+    if (!free_predicate_ids_.empty()) {
+	id = free_predicate_ids_.back();
+	free_predicate_ids_.pop_back();
+    } else {
+	id = id_to_predicate_.size();
+	id_to_predicate_.push_back(predicate());
+    }
+    jit_index_entries_ += clauses.size();
+    id_to_predicate_[id].swap(clauses);
+    return id;
+}
+
+interpreter::predicate_index & interpreter::get_predicate_index(predicate_descriptor &pd)
+{
+    if (pd.id >= predicate_indexes_.size()) {
+	predicate_indexes_.resize(pd.id + 1);
+    }
+    auto &index = predicate_indexes_[pd.id];
+    if (!index.is_valid()) {
+	predicate all = *pd.clauses;
+	index.all_subset = new_predicate_subset(all);
+	index.args.resize(pd.qn.second.arity());
+    }
+    return index;
+}
+
+interpreter::arg_index & interpreter::get_arg_index(predicate_descriptor &pd,
+						    predicate_index &index,
+						    size_t arg_pos)
+{
+    auto &aindex = index.args[arg_pos];
+    if (aindex.built) {
+	return aindex;
+    }
+    aindex.built = true;
+
+    auto &clauses = *pd.clauses;
+    std::vector<common::cell> keys;
+    std::vector<common::cell> distinct;
+    std::unordered_set<common::cell> seen;
+    for (auto &m_clause : clauses) {
 	auto head = clause_head(m_clause.clause());
-	auto head_functor = functor(head);
-	if (head_functor.arity() > 0) {
-	    auto head_first_arg = arg(head, 0);
-	    if (definitely_inequal(head_first_arg, first_arg)) {
-		continue;
+	auto key = jit_index_key(*this, arg(head, arg_pos));
+	keys.push_back(key);
+	if (key != term() && !seen.count(key)) {
+	    seen.insert(key);
+	    distinct.push_back(key);
+	}
+    }
+
+    // Don't index this argument if it would exceed the memory limit
+    // (calls will then scan the other candidates linearly.)
+    size_t num_vars = std::count(keys.begin(), keys.end(), term());
+    size_t required = (clauses.size() - num_vars)
+	            + (distinct.size() + 1) * num_vars;
+    if (jit_index_entries_ + required > jit_index_limit_) {
+	return aindex;
+    }
+
+    aindex.selective = !distinct.empty();
+    if (!aindex.selective) {
+	return aindex;
+    }
+
+    // Every subset keeps the clauses in program order, including those
+    // with a var in this argument position.
+    for (auto key : distinct) {
+	predicate subset;
+	for (size_t i = 0; i < clauses.size(); i++) {
+	    if (keys[i] == key || keys[i] == term()) {
+		subset.push_back(clauses[i]);
 	    }
 	}
-	matched.push_back(m_clause);
+	aindex.subsets[key] = new_predicate_subset(subset);
+    }
+    predicate var_subset;
+    for (size_t i = 0; i < clauses.size(); i++) {
+	if (keys[i] == term()) {
+	    var_subset.push_back(clauses[i]);
+	}
     }
+    aindex.var_subset = new_predicate_subset(var_subset);
+
+    return aindex;
 }
 
-size_t interpreter::matched_predicate_id(con_cell module,
-					 con_cell func, const term first_arg)
+size_t interpreter::matched_predicate_id(predicate_descriptor &pd)
 {
     using namespace prologcoin::common;
 
-    term index_arg = first_arg;
-    switch (first_arg.tag()) {
-    case tag_t::STR:
-	index_arg = functor(first_arg); break;
+    if (has_changed_predicates()) {
+	sync_predicate_indexes();
+    }
+
+    if (jit_index_entries_ > jit_index_limit_) {
+	for (auto &index : predicate_indexes_) {
+	    if (index.is_valid()) {
+		retire_predicate_index(index);
+	    }
+	}
+	predicate_indexes_.clear();
+	jit_index_resets_++;
+	release_retired_subsets();
+    }
+
+    if (pd.clauses == nullptr || pd.clauses->empty()) {
+	return 0;
+    }
+
+    auto &index = get_predicate_index(pd);
+    size_t arity = pd.qn.second.arity();
+
+    // Pick the bound argument with the fewest candidate clauses.
+    size_t best_id = index.all_subset;
+    size_t best_size = id_to_predicate_[best_id].size();
+    size_t num_bound = 0;
+    for (size_t i = 0; i < arity && best_size > 0; i++) {
+	auto key = jit_index_key(*this, a(i));
+	if (key == term()) {
+	    continue;
+	}
+	auto &aindex = get_arg_index(pd, index, i);
+	if (!aindex.selective) {
+	    continue;
+	}
+	num_bound++;
+	auto it = aindex.subsets.find(key);
+	size_t id = (it == aindex.subsets.end()) ? aindex.var_subset
+	                                         : it->second;
+	size_t sz = id_to_predicate_[id].size();
+	if (sz < best_size) {
+	    best_id = id;
+	    best_size = sz;
+	}
+    }
+
+    if (num_bound < 2 || best_size < 2) {
+	return best_id;
+    }
+
+    // Several arguments are bound. Narrow down the best subset with
+    // all of them.
+    std::vector<common::cell> combined_key(arity);
+    for (size_t i = 0; i < arity; i++) {
+	if (index.args[i].built && index.args[i].selective) {
+	    combined_key[i] = jit_index_key(*this, a(i));
+	}
+    }
+    auto it = index.combined.find(combined_key);
+    if (it != index.combined.end()) {
+	return it->second;
+    }
+
+    predicate narrowed;
+    for (auto &m_clause : id_to_predicate_[best_id]) {
+	auto head = clause_head(m_clause.clause());
+	bool matches = true;
+	for (size_t i = 0; i < arity && matches; i++) {
+	    if (combined_key[i] != term() &&
+		definitely_inequal(arg(head, i), interpreter_base::deref(a(i)))) {
+		matches = false;
+	    }
+	}
+	if (matches) {
+	    narrowed.push_back(m_clause);
+	}
+    }
+    size_t id = best_id;
+    if (narrowed.size() < best_size) {
+	id = new_predicate_subset(narrowed);
+    }
+    jit_index_entries_ += arity;
+    index.combined[combined_key] = id;
+
+    return id;
+}
+
+void interpreter::sync_predicate_indexes()
+{
+    for (auto &qn : get_changed_predicates()) {
+	auto *pd = find_predicate_descriptor(qn);
+	if (pd != nullptr && pd->id < predicate_indexes_.size()
+	    && predicate_indexes_[pd->id].is_valid()) {
+	    retire_predicate_index(predicate_indexes_[pd->id]);
+	    predicate_indexes_[pd->id] = predicate_index();
+	    jit_index_invalidations_++;
+	}
+    }
+    clear_changed_predicates();
+    release_retired_subsets();
+}
+
+void interpreter::retire_predicate_index(predicate_index &index)
+{
+    // Combined keys may share subsets with the argument indexes.
+    std::unordered_set<size_t> ids;
+    ids.insert(index.all_subset);
+    for (auto &aindex : index.args) {
+	if (aindex.selective) {
+	    for (auto &e : aindex.subsets) {
+		ids.insert(e.second);
+	    }
+	    ids.insert(aindex.var_subset);
+	}
+    }
+    for (auto &e : index.combined) {
+	ids.insert(e.second);
+	jit_index_entries_ -= e.first.size();
+    }
+    for (auto id : ids) {
+	jit_index_entries_ -= id_to_predicate_[id].size();
+	retired_predicate_ids_.push_back(id);
+    }
+}
+
+void interpreter::release_retired_subsets()
+{
+    // Subsets that a choice point may still backtrack into are kept.
+    std::unordered_set<size_t> live;
+    for (auto ch = b(); ch != nullptr; ch = ch->b) {
+	if (ch->bp.has_wam_code()) {
+	    continue;
+	}
+	auto bpterm = ch->bp.term_code();
+	if (bpterm.tag() == common::tag_t::INT) {
+	    size_t bpval = static_cast<const int_cell &>(bpterm).value();
+	    live.insert(bpval >> 8);
+	}
+    }
+
+    std::vector<size_t> still_retired;
+    for (auto id : retired_predicate_ids_) {
+	if (live.count(id)) {
+	    still_retired.push_back(id);
+	} else {
+	    predicate().swap(id_to_predicate_[id]);
+	    free_predicate_ids_.push_back(id);
+	}
+    }
+    retired_predicate_ids_.swap(still_retired);
+}
+
+interpreter::jit_index_stats interpreter::get_jit_index_stats() const
+{
+    jit_index_stats stats;
+    stats.num_predicates = 0;
+    stats.num_arg_indexes = 0;
+    for (auto &index : predicate_indexes_) {
+	if (index.is_valid()) stats.num_predicates++;
+	for (auto &aindex : index.args) {
+	    if (aindex.built) stats.num_arg_indexes++;
+	}
+    }
+    stats.num_subsets = id_to_predicate_.size() - 1
+	- free_predicate_ids_.size() - retired_predicate_ids_.size();
+    stats.num_entries = jit_index_entries_;
+    stats.num_retired = retired_predicate_ids_.size();
+    stats.num_invalidations = jit_index_invalidations_;
+    stats.num_resets = jit_index_resets_;
+    return stats;
+}
+
+void interpreter::print_jit_index_stats(std::ostream &out) const
+{
+    auto stats = get_jit_index_stats();
+    out << "JIT index: predicates=" << stats.num_predicates
+	<< " args=" << stats.num_arg_indexes
+	<< " subsets=" << stats.num_subsets
+	<< " entries=" << stats.num_entries << "/" << jit_index_limit_
+	<< " retired=" << stats.num_retired
+	<< " invalidations=" << stats.num_invalidations
+	<< " resets=" << stats.num_resets << "\n";
+}
+
+//
+// The shape of a query is the query where all constants in arguments
+// are replaced by parameters. Two queries with the same shape (and
+// the same sharing of variables) are compiled to the same clause:
+//
+//    '$qryN'(Vars..., Params...) :- Query with params.
+//
+void interpreter::query_shape_arg(query_shape &shape, const term arg0,
+				  term &lifted)
+{
+    using namespace prologcoin::common;
+
+    term arg = interpreter_base::deref(arg0);
+    switch (arg.tag()) {
+    case tag_t::REF: {
+	auto it = std::find(shape.vars.begin(), shape.vars.end(), arg);
+	shape.key += "V" + boost::lexical_cast<std::string>(
+			       it - shape.vars.begin());
+	if (it == shape.vars.end()) {
+	    shape.vars.push_back(arg);
+	}
+	lifted = arg;
+	break;
+    }
     case tag_t::CON:
     case tag_t::INT:
+    case tag_t::BIG:
+	shape.key += "#";
+	shape.constants.push_back(arg);
+	if (shape.build) {
+	    lifted = new_ref();
+	    shape.params.push_back(lifted);
+	}
 	break;
-    case tag_t::REF:
-	index_arg = term();
+    case tag_t::STR: {
+	auto f = functor(arg);
+	shape.key += boost::lexical_cast<std::string>(f.raw_value()) + "(";
+	if (shape.build) {
+	    lifted = new_term(f);
+	}
+	for (size_t i = 0; i < f.arity(); i++) {
+	    term lifted_arg;
+	    query_shape_arg(shape, interpreter_base::arg(arg, i), lifted_arg);
+	    if (shape.build) {
+		set_arg(lifted, i, lifted_arg);
+	    }
+	    shape.key += ",";
+	}
+	shape.key += ")";
+	break;
+    }
+    default:
+	shape.compilable = false;
 	break;
     }
+}
 
-    functor_index findex(std::make_pair(module,func), index_arg);
-    auto it = predicate_id_.find(findex);
-    size_t id;
-    if (it == predicate_id_.end()) {
-	id = id_to_predicate_.size();
-	id_to_predicate_.push_back( predicate() );
-	predicate_id_[findex] = id;
-	auto &pred = id_to_predicate_[id];
-	compute_matched_predicate(module, func, first_arg, pred);
+void interpreter::query_shape_goal(query_shape &shape, const term goal0,
+				   term &lifted)
+{
+    using namespace prologcoin::common;
+
+    static const con_cell comma(",", 2);
+    static const con_cell semi(";", 2);
+    static const con_cell arrow("->", 2);
+    static const con_cell colon(":", 2);
+
+    term goal = interpreter_base::deref(goal0);
+    switch (goal.tag()) {
+    case tag_t::CON:
+	shape.key += boost::lexical_cast<std::string>(goal.raw_value());
+	lifted = goal;
+	return;
+    case tag_t::STR:
+	break;
+    default:
+	// Var (or number) as goal; leave it to the interpreter.
+	shape.compilable = false;
+	return;
+    }
+
+    auto f = functor(goal);
+    shape.key += boost::lexical_cast<std::string>(f.raw_value()) + "(";
+    if (shape.build) {
+	lifted = new_term(f);
+    }
+    bool control = f == comma || f == semi || f == arrow;
+    for (size_t i = 0; i < f.arity() && shape.compilable; i++) {
+	term lifted_arg;
+	auto a = interpreter_base::arg(goal, i);
+	if (control) {
+	    query_shape_goal(shape, a, lifted_arg);
+	} else if (f == colon) {
+	    // Keep module qualified goals as they are
+	    shape.compilable = false;
+	} else {
+	    query_shape_arg(shape, a, lifted_arg);
+	}
+	if (shape.build) {
+	    set_arg(lifted, i, lifted_arg);
+	}
+	shape.key += ",";
+    }
+    shape.key += ")";
+}
+
+//
+// Returns the goal to run for the query; either a call to its
+// compiled clause or the query itself if it could not be compiled.
+//
+common::term interpreter::compile_query(const term query)
+{
+    static const size_t MAX_QUERY_ARGS = 64;
+
+    query_shape shape;
+    shape.build = false;
+    shape.compilable = true;
+    term lifted;
+    query_shape_goal(shape, query, lifted);
+
+    size_t arity = shape.vars.size() + shape.constants.size();
+    if (!shape.compilable || arity > MAX_QUERY_ARGS) {
+	return query;
+    }
+
+    auto found = query_cache_map_.find(shape.key);
+    qname qn;
+    if (found != query_cache_map_.end()) {
+	query_cache_hits_++;
+	query_cache_.splice(query_cache_.begin(), query_cache_, found->second);
+	qn = found->second->qn;
     } else {
-	id = it->second;
+	query_cache_misses_++;
+
+	size_t slot = query_cache_.size();
+	if (query_cache_.size() >= query_cache_size_) {
+	    // Evict the least recently used query
+	    auto &lru = query_cache_.back();
+	    remove_compiled(lru.qn);
+	    query_cache_map_.erase(lru.key);
+	    slot = lru.slot;
+	    query_cache_.pop_back();
+	}
+	qn = qname(empty_list(),
+		   functor("$qry" + boost::lexical_cast<std::string>(slot),
+			   arity));
+
+	query_shape lifted_shape;
+	lifted_shape.build = true;
+	lifted_shape.compilable = true;
+	query_shape_goal(lifted_shape, query, lifted);
+
+	term head = new_term(qn.second);
+	size_t i = 0;
+	for (auto v : lifted_shape.vars) set_arg(head, i++, v);
+	for (auto p : lifted_shape.params) set_arg(head, i++, p);
+	term clause = new_term(con_cell(":-", 2), {head, lifted});
+
+	wam_interim_code instrs(*this);
+	try {
+	    // The query is not a clause of the program, so it doesn't pay
+	    // for its size; only the goals it calls cost.
+	    compiler_->compile_clause(managed_clause(clause, 0), instrs);
+	} catch (wam_exception &ex) {
+	    return query;
+	}
+	size_t yn_size = compiler_->get_environment_size_of(instrs);
+	size_t first_offset = load_code(instrs);
+	set_predicate(qn, to_code(first_offset), yn_size);
+	clear_updated_predicate(qn);
+
+	query_cache_.push_front(compiled_query{shape.key, qn, slot});
+	query_cache_map_[shape.key] = query_cache_.begin();
     }
-    return id;
+
+    term goal = new_term(qn.second);
+    size_t i = 0;
+    for (auto v : shape.vars) set_arg(goal, i++, v);
+    for (auto c : shape.constants) set_arg(goal, i++, c);
+    return goal;
 }
 
 std::string interpreter::get_result(bool newlines) const
@@ -735,10 +1285,12 @@ void interpreter::print_result(std::ostream &out) const
 void interpreter::compile()
 {
     for (auto &qn : get_predicates()) {
-	if (is_updated_predicate(qn)) {
-	    remove_compiled(qn);
+	if (is_dynamic(qn) || is_tabled(qn)) {
+	    continue;
 	}
-	if (!is_compiled(qn)) {
+	if (is_updated_predicate(qn) && is_compiled(qn)) {
+	    update_compiled(qn);
+	} else if (!is_compiled(qn)) {
 	    compile(qn);
 	}
     }
@@ -747,13 +1299,24 @@ void interpreter::compile()
 
 void interpreter::compile(const qname &qn)
 {
+    if (is_dynamic(qn) || is_tabled(qn)) {
+	// Dynamic and tabled predicates are always interpreted
+	clear_updated_predicate(qn);
+	return;
+    }
     wam_interim_code instrs(*this);
     compiler_->compile_predicate(qn, instrs);
+    get_predicate_descriptor(qn).choice_points_avoided
+	= compiler_->num_choice_points_avoided();
     size_t yn_size = compiler_->get_environment_size_of(instrs);
-    size_t first_offset = next_offset();
-    load_code(instrs);
+    bool native = native_enabled_ && wam_native::is_supported();
+    size_t first_offset = load_code(instrs, native);
     auto *next_instr = to_code(first_offset);
     set_predicate(qn, next_instr, yn_size);
+    if (native) {
+	compile_native(first_offset, next_offset());
+    }
+    clear_updated_predicate(qn);
 }
 
 void interpreter::compile(common::con_cell module, common::con_cell name)
@@ -761,6 +1324,102 @@ void interpreter::compile(common::con_cell module, common::con_cell name)
     compile(std::make_pair(module, name));
 }
 
+//
+// A compiled predicate that has changed is compiled incrementally
+// from then on: as a clause chain, where added clauses are simply
+// appended (see wam_clause_chain.) Any other change rebuilds the
+// chain, but that's what reconsulting a predicate costs anyway.
+//
+void interpreter::update_compiled(const qname &qn)
+{
+    auto &clauses = interpreter_base::get_predicate(qn);
+    auto *chain = find_clause_chain(qn);
+    size_t n = (chain == nullptr) ? 0 : chain->size();
+    bool appended = n > 0 && n <= clauses.size() &&
+	            chain->clause(0) == clauses[0].clause() &&
+	            chain->clause(n-1) == clauses[n-1].clause();
+    if (!appended) {
+	remove_compiled(qn);
+	if (clauses.empty()) {
+	    clear_updated_predicate(qn);
+	    return;
+	}
+	chain = new_clause_chain(qn);
+	n = 0;
+    }
+    try {
+	bool native = native_enabled_ && wam_native::is_supported();
+	for (size_t i = n; i < clauses.size(); i++) {
+	    wam_interim_code instrs(*this);
+	    compiler_->compile_clause(clauses[i].clause(), instrs);
+	    size_t offset = load_code(instrs, native, false);
+	    if (native) {
+		compile_native(offset, next_offset());
+	    }
+	    add_chain_clause(*chain, clauses[i].clause(), offset);
+	}
+    } catch (wam_exception &ex) {
+	// Keep it interpreted
+	remove_compiled(qn);
+	clear_updated_predicate(qn);
+	throw;
+    }
+    clear_updated_predicate(qn);
+}
+
+void interpreter::count_call(predicate_descriptor &pd)
+{
+    if (++pd.call_count == auto_compile_threshold_) {
+	hot_predicates_.push_back(pd.qn);
+    }
+}
+
+//
+// This is done before a new top level query, which is also a good
+// time to reclaim the code of removed predicates.
+//
+void interpreter::compile_hot_predicates()
+{
+    // Compiled predicates that have changed since are updated
+    // incrementally.
+    std::vector<qname> changed;
+    for (auto &qn : get_updated_predicates()) {
+	if (is_compiled(qn)) {
+	    changed.push_back(qn);
+	}
+    }
+    for (auto &qn : changed) {
+	try {
+	    update_compiled(qn);
+	} catch (wam_exception &ex) {
+	    // Keep it interpreted
+	    continue;
+	}
+	num_auto_compiled_++;
+    }
+    collect_code();
+
+    if (hot_predicates_.empty()) {
+	return;
+    }
+
+    std::vector<qname> hot;
+    hot.swap(hot_predicates_);
+    for (auto &qn : hot) {
+	if (is_compiled(qn) || is_dynamic(qn) || is_tabled(qn) ||
+	    interpreter_base::get_predicate(qn).empty()) {
+	    continue;
+	}
+	try {
+	    compile(qn);
+	} catch (wam_exception &ex) {
+	    // Keep it interpreted
+	    continue;
+	}
+	num_auto_compiled_++;
+    }
+}
+
 void interpreter::bind_code_point(std::unordered_map<size_t, size_t> &label_map, code_point &cp)
 {
     if (cp.wam_code() == nullptr) {
@@ -791,13 +1450,38 @@ void interpreter::bind_code_point(std::unordered_map<size_t, size_t> &label_map,
     }
 }
 
-void interpreter::load_code(wam_interim_code &instrs)
+//
+// Load the code into a segment of its own (so it can be reclaimed on
+// its own once it's no longer used), or if not 'own_segment' where
+// there's room. Returns the code offset of the first instruction.
+//
+size_t interpreter::load_code(wam_interim_code &instrs, bool native,
+			      bool own_segment)
 {
     // instrs.print(std::cout);
 
+    size_t total = 0;
+    for (auto *instr : instrs) {
+	if (!wam_compiler::is_label_instruction(instr)) {
+	    total += instr->size();
+	}
+    }
+    if (native) {
+	total += wam_instruction<NATIVE>().size();
+    }
+    if (own_segment) {
+	new_segment(total);
+    } else {
+	reserve(total);
+    }
+
     std::unordered_map<size_t, size_t> label_map;
     size_t first_offset = next_offset();
-    size_t offset = first_offset;
+    if (native) {
+	add(wam_instruction<NATIVE>());
+    }
+    size_t code_offset = next_offset();
+    size_t offset = code_offset;
     // Collect labels
     for (auto *instr : instrs) {
 	if (wam_compiler::is_label_instruction(instr)) {
@@ -812,11 +1496,12 @@ void interpreter::load_code(wam_interim_code &instrs)
     }
 
     // Update code points
-    wam_instruction_base *instr = to_code(first_offset);
-    for (size_t i = first_offset; i < offset;) {
+    wam_instruction_base *instr = to_code(code_offset);
+    for (size_t i = code_offset; i < offset;) {
 	switch (instr->type()) {
 	case TRY_ME_ELSE:
 	case RETRY_ME_ELSE:
+	case TRY_ME_ELSE_BODY:
 	case TRY:
 	case RETRY:
 	case TRUST:
@@ -837,12 +1522,22 @@ void interpreter::load_code(wam_interim_code &instrs)
 	    bind_code_point(label_map, cp_instr->ps());
 	    }
 	    break;
+        case GUARD:
+	    {
+	    auto cp_instr = static_cast<wam_instruction<GUARD> *>(instr);
+	    bind_code_point(label_map, cp_instr->pt());
+	    bind_code_point(label_map, cp_instr->pf());
+	    bind_code_point(label_map, cp_instr->pu());
+	    }
+	    break;
         case SWITCH_ON_CONSTANT:
         case SWITCH_ON_STRUCTURE:
 	    {
-	    auto cp_instr = static_cast<wam_instruction_hash_map *>(instr);
-	    for (auto &e : cp_instr->map()) {
-		bind_code_point(label_map, e.second);
+	    auto cp_instr = static_cast<wam_instruction_switch_table *>(instr);
+	    for (size_t j = 0; j < cp_instr->num_slots(); j++) {
+		if (!cp_instr->is_free(j)) {
+		    bind_code_point(label_map, cp_instr->slot(j).cp);
+		}
 	    }
 	    }
 	    break;
@@ -852,6 +1547,8 @@ void interpreter::load_code(wam_interim_code &instrs)
 	i += instr->size();
 	instr = next_instruction(instr);
     }
+
+    return first_offset;
 }
 
 }}
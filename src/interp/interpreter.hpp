@@ -3,6 +3,7 @@
 #ifndef _interp_interpreter_hpp
 #define _interp_interpreter_hpp
 
+#include <list>
 #include "wam_interpreter.hpp"
 
 namespace prologcoin { namespace interp {
@@ -26,6 +27,28 @@ public:
     void compile(const qname &pred);
     void compile(common::con_cell module, common::con_cell name);
 
+    // Predicates called through dispatch() at least this many times
+    // are compiled to WAM code at the next safe point (0 = never.)
+    // Only without cost tracking, as cost must not depend on history.
+    inline void set_auto_compile_threshold(size_t n)
+        { auto_compile_threshold_ = n; }
+    inline size_t auto_compile_threshold() const
+        { return auto_compile_threshold_; }
+    inline size_t num_auto_compiled() const
+        { return num_auto_compiled_; }
+
+    // Top level queries are compiled to WAM code and cached by their
+    // shape (constants are passed as parameters.) At most this many
+    // query shapes are kept (0 = never compile queries.)
+    inline void set_query_cache_size(size_t n)
+        { query_cache_size_ = n; }
+    inline size_t query_cache_size() const
+        { return query_cache_size_; }
+    inline size_t num_query_cache_hits() const
+        { return query_cache_hits_; }
+    inline size_t num_query_cache_misses() const
+        { return query_cache_misses_; }
+
     bool execute(const term query);
     bool next();
     bool cont();
@@ -68,6 +91,14 @@ public:
     inline bool is_wam_enabled() const
     { return wam_enabled_; }
 
+    // Compiled predicates are also translated to subroutine-threaded
+    // native code (if the platform supports it, see wam_native.)
+    inline void set_native_enabled(bool enabled)
+    { native_enabled_ = enabled; }
+
+    inline bool is_native_enabled() const
+    { return native_enabled_; }
+
     std::string get_result(bool newlines = true) const;
     term get_result_term(const std::string &varname) const;
     term get_result_term() const;
@@ -83,10 +114,34 @@ public:
 private:
     static bool new_instance_meta(interpreter_base &interp, const meta_reason_t &reason);
 
-    void load_code(wam_interim_code &code);
+    void update_compiled(const qname &qn);
+    size_t load_code(wam_interim_code &code, bool native = false,
+		     bool own_segment = true);
     void bind_code_point(std::unordered_map<size_t, size_t> &label_map,
 			 code_point &cp);
     void dispatch();
+    void count_call(predicate_descriptor &pd);
+
+    struct query_shape {
+	std::string key;
+	std::vector<term> vars;
+	std::vector<term> params;
+	std::vector<term> constants;
+	bool build;       // Build the lifted term as well
+	bool compilable;
+    };
+
+    struct compiled_query {
+	std::string key;
+	qname qn;
+	size_t slot; // N in '$qryN'
+    };
+
+    term compile_query(const term query);
+    void query_shape_goal(query_shape &shape, const term goal,
+			  term &lifted);
+    void query_shape_arg(query_shape &shape, const term arg, term &lifted);
+    void compile_hot_predicates();
     void dispatch_wam(wam_instruction_base *instruction);
     bool unify_args(term clause_head, const code_point &p);
     bool select_clause(const code_point &instruction,
@@ -104,15 +159,89 @@ private:
 	return id_to_predicate_[id];
     }
 
-    void compute_matched_predicate(con_cell module, con_cell functor,
-				   const term first_arg,
-				   predicate &matched);
-    size_t matched_predicate_id(con_cell module,
-				con_cell functor, const term first_arg);
+    //
+    // Just-in-time clause indexing for the naive interpreter.
+    //
+    // An argument position of a predicate is only indexed once a call
+    // binds it. The index maps the principal functor of the argument
+    // to a clause subset, an id into id_to_predicate_, that are the
+    // only clauses that could match. A call picks the most selective
+    // of its bound arguments, and if several arguments are bound the
+    // subset is narrowed further by all of them (cached per key
+    // combination.)
+    //
+    // Choice points refer to subsets by id. When a predicate changes
+    // its indexes are dropped and the subsets are retired; a retired
+    // subset is released once no choice point refers to it.
+    //
+    struct arg_index {
+	arg_index() : built(false), selective(false), var_subset(0) { }
+
+	bool built;
+	bool selective;    // False if no clause has a non-var here
+	std::unordered_map<common::cell, size_t> subsets;
+	size_t var_subset; // Clauses with a var (for any other key)
+    };
+
+    struct combined_key_hash {
+	size_t operator()(const std::vector<common::cell> &key) const {
+	    size_t h = 0;
+	    for (auto c : key) h = 17*h + c.raw_value();
+	    return h;
+	}
+    };
 
+    struct predicate_index {
+	predicate_index() : all_subset(0) { }
+
+	inline bool is_valid() const { return all_subset != 0; }
+
+	size_t all_subset;
+	std::vector<arg_index> args;
+	std::unordered_map<std::vector<common::cell>, size_t,
+			   combined_key_hash> combined;
+    };
 
-    std::unordered_map<functor_index, size_t> predicate_id_;
+    size_t matched_predicate_id(predicate_descriptor &pd);
+    predicate_index & get_predicate_index(predicate_descriptor &pd);
+    arg_index & get_arg_index(predicate_descriptor &pd,
+			      predicate_index &index, size_t arg_pos);
+    size_t new_predicate_subset(predicate &clauses);
+    void sync_predicate_indexes();
+    void retire_predicate_index(predicate_index &index);
+    void release_retired_subsets();
+
+public:
+    struct jit_index_stats {
+	size_t num_predicates;    // Predicates with an index
+	size_t num_arg_indexes;   // Argument positions indexed
+	size_t num_subsets;       // Clause subsets in use
+	size_t num_entries;       // Clause references in subsets
+	size_t num_retired;       // Retired, but still referenced
+	size_t num_invalidations; // Indexes dropped due to updates
+	size_t num_resets;        // All indexes dropped due to limit
+    };
+
+    jit_index_stats get_jit_index_stats() const;
+    void print_jit_index_stats(std::ostream &out) const;
+
+    // Maximum number of clause references held by all subsets.
+    inline void set_jit_index_limit(size_t limit)
+        { jit_index_limit_ = limit; }
+    inline size_t jit_index_limit() const
+        { return jit_index_limit_; }
+
+private:
+    static const size_t DEFAULT_JIT_INDEX_LIMIT = 1024*1024;
+
+    std::vector<predicate_index> predicate_indexes_; // By descriptor id
     std::vector<predicate> id_to_predicate_;
+    std::vector<size_t> free_predicate_ids_;
+    std::vector<size_t> retired_predicate_ids_;
+    size_t jit_index_entries_;
+    size_t jit_index_limit_;
+    size_t jit_index_invalidations_;
+    size_t jit_index_resets_;
 
     inline std::vector<binding> & query_vars()
         { return *query_vars_; }
@@ -123,7 +252,24 @@ private:
     inline void set_query_vars(std::vector<binding> *qv)
         { query_vars_ = qv; }
 
+    static const size_t DEFAULT_AUTO_COMPILE_THRESHOLD = 100;
+
+    std::vector<qname> hot_predicates_;
+    size_t auto_compile_threshold_;
+    size_t num_auto_compiled_;
+
+    static const size_t DEFAULT_QUERY_CACHE_SIZE = 64;
+
+    // Most recently used first
+    std::list<compiled_query> query_cache_;
+    std::unordered_map<std::string,
+		       std::list<compiled_query>::iterator> query_cache_map_;
+    size_t query_cache_size_;
+    size_t query_cache_hits_;
+    size_t query_cache_misses_;
+
     bool wam_enabled_;
+    bool native_enabled_;
     std::vector<binding> *query_vars_;
     wam_compiler *compiler_;
     size_t num_instances_;
@@ -52,17 +52,21 @@ interpreter_base::interpreter_base() : register_pr_("", 0), comma_(",",2), empty
     num_of_args_ = 0;
     memset(&register_ai_[0], 0, sizeof(common::term)*MAX_ARGS);
     num_y_fn_ = nullptr;
+    accumulated_cost_ = 0;
     maximum_cost_ = std::numeric_limits<uint64_t>::max();
 }
 
 void interpreter_base::init()
 {
     debug_ = false;
-    track_cost_ = false;
+    track_cost_ = true;
+    table_bypass_ = false;
     file_id_count_ = 3;
     num_of_args_= 0;
     memset(register_ai_, 0, sizeof(register_ai_));
-    stack_ = reinterpret_cast<word_t *>(new char[MAX_STACK_SIZE]);
+    stack_ = reinterpret_cast<word_t *>(stack_space_.base());
+    stack_words_ = stack_space_.committed() / sizeof(word_t);
+    set_maximum_stack_size(DEFAULT_MAX_STACK_SIZE);
     num_y_fn_ = &num_y;
     standard_output_ = nullptr;
     prepare_execution();
@@ -79,6 +83,8 @@ interpreter_base::~interpreter_base()
     builtins_opt_.clear();
     program_db_.clear();
     program_predicates_.clear();
+    predicate_descriptor_ids_.clear();
+    predicate_descriptors_.clear();
 }
 
 void interpreter_base::reset()
@@ -189,6 +195,12 @@ void interpreter_base::syntax_check()
 
 void interpreter_base::load_clause(const term t, bool as_program)
 {
+    static const con_cell directive(":-", 1);
+    if (functor(t) == directive) {
+	load_directive(arg(t, 0));
+	return;
+    }
+
     syntax_check_stack_.push_back(
 		  std::bind(&interpreter_base::syntax_check_clause, this,
 			    t));
@@ -204,6 +216,18 @@ void interpreter_base::load_clause(const term t, bool as_program)
     
     auto qn = std::make_pair(module, predicate);
 
+    if (auto *pd = find_predicate_descriptor(qn)) {
+	if (pd->dynamic != nullptr) {
+	    if (as_program && !is_updated_predicate(qn)) {
+		dynamic_db_.clear(*pd->dynamic);
+		reclaim_dynamic(*pd->dynamic);
+	    }
+	    updated_predicates_.insert(qn);
+	    dynamic_db_.add(*pd->dynamic, *this, t, head, cost(t), true);
+	    return;
+	}
+    }
+
     auto found = program_db_.find(qn);
     if (found == program_db_.end()) {
         program_db_[qn] = managed_clauses();
@@ -218,7 +242,39 @@ void interpreter_base::load_clause(const term t, bool as_program)
 	}
     }
     updated_predicates_.insert(qn);
-    program_db_[qn].push_back(managed_clause(t, cost(t)));
+    changed_predicates_.insert(qn);
+    auto &clauses = program_db_[qn];
+    clauses.push_back(managed_clause(t, cost(t)));
+    if (auto *pd = find_predicate_descriptor(qn)) {
+	pd->clauses = &clauses;
+    }
+}
+
+predicate_descriptor & interpreter_base::get_predicate_descriptor(const qname &qn)
+{
+    auto it = predicate_descriptor_ids_.find(qn);
+    if (it != predicate_descriptor_ids_.end()) {
+	return predicate_descriptors_[it->second];
+    }
+
+    size_t id = predicate_descriptors_.size();
+    predicate_descriptors_.push_back(predicate_descriptor(id, qn));
+    predicate_descriptor_ids_[qn] = id;
+
+    auto &pd = predicate_descriptors_.back();
+    auto bn = builtins_.find(qn);
+    if (bn != builtins_.end()) {
+	pd.bn = bn->second;
+    }
+    auto bn_opt = builtins_opt_.find(qn);
+    if (bn_opt != builtins_opt_.end()) {
+	pd.bn_opt = &bn_opt->second;
+    }
+    auto clauses = program_db_.find(qn);
+    if (clauses != program_db_.end()) {
+	pd.clauses = &clauses->second;
+    }
+    return pd;
 }
 
 void interpreter_base::load_builtin(const qname &qn, builtin b)
@@ -226,6 +282,9 @@ void interpreter_base::load_builtin(const qname &qn, builtin b)
     auto found = builtins_.find(qn);
     if (found == builtins_.end()) {
         builtins_[qn] = b;
+	if (auto *pd = find_predicate_descriptor(qn)) {
+	    pd->bn = b;
+	}
     }
 }
 
@@ -233,7 +292,11 @@ void interpreter_base::load_builtin_opt(const qname &qn, builtin_opt b)
 {
     auto found = builtins_opt_.find(qn);
     if (found == builtins_opt_.end()) {
-        builtins_opt_[qn] = b;
+        auto &bn_opt = builtins_opt_[qn];
+	bn_opt = b;
+	if (auto *pd = find_predicate_descriptor(qn)) {
+	    pd->bn_opt = &bn_opt;
+	}
     }    
 }
 
@@ -288,6 +351,12 @@ void interpreter_base::load_builtins()
 
     // Arithmetics
     load_builtin(con_cell("is",2), &builtins::is_2);
+    load_builtin(con_cell("<",2), &builtins::operator_less_than);
+    load_builtin(con_cell("=<",2), &builtins::operator_equals_less_than);
+    load_builtin(con_cell(">",2), &builtins::operator_greater_than);
+    load_builtin(con_cell(">=",2), &builtins::operator_greater_than_equals);
+    load_builtin(con_cell("=:=",2), &builtins::operator_arith_equals);
+    load_builtin(con_cell("=\\=",2), &builtins::operator_arith_not_equals);
 
     // Analyzing & constructing terms
     load_builtin(functor("functor",3), &builtins::functor_3);
@@ -297,11 +366,32 @@ void interpreter_base::load_builtins()
     // Meta
     load_builtin(con_cell("\\+", 1), builtin(&builtins::operator_disprove,true));
     load_builtin(con_cell("findall",3), builtin(&builtins::findall_3,true));
+    load_builtin(con_cell("bagof",3), builtin(&builtins::bagof_3,true));
+    load_builtin(con_cell("setof",3), builtin(&builtins::setof_3,true));
+    load_builtin(con_cell("$bag",3), builtin(&builtins::bag_cont_3,true));
+    load_builtin(functor("aggregate_all",3), builtin(&builtins::aggregate_all_3,true));
+    load_builtin(functor("$predsort_call",4), builtin(&builtins::predsort_call_4,true));
+
+    // Dynamic database
+    load_builtin(con_cell("assert",1), &builtins::assert_1);
+    load_builtin(con_cell("asserta",1), &builtins::asserta_1);
+    load_builtin(con_cell("assertz",1), &builtins::assertz_1);
+    load_builtin(con_cell("retract",1), builtin(&builtins::retract_1,true));
+    load_builtin(functor("retractall",1), &builtins::retractall_1);
+    load_builtin(con_cell("$dyn",4), builtin(&builtins::dynamic_cont_4,true));
+    load_builtin(con_cell("$ret",4), builtin(&builtins::retract_cont_4,true));
+
+    // Tabling
+    load_builtin(con_cell("$tbl",4), builtin(&builtins::table_cont_4,true));
+    load_builtin(functor("abolish_all_tables",0), &builtins::abolish_all_tables_0);
 }
 
 void interpreter_base::load_builtins_opt()
 {
     load_builtin_opt(con_cell("sort", 2), &builtins_opt::sort_2);
+    load_builtin_opt(con_cell("msort", 2), &builtins_opt::msort_2);
+    load_builtin_opt(con_cell("sort", 4), &builtins_opt::sort_4);
+    load_builtin_opt(functor("keysort", 2), &builtins_opt::keysort_2);
 }
 
 void interpreter_base::enable_file_io()
@@ -340,6 +430,80 @@ void interpreter_base::load_builtins_file_io()
     load_builtin(con_cell("sformat",3), builtin(&builtins_fileio::sformat_3,true));
 }
 
+void interpreter_base::load_directive(const term t)
+{
+    static const con_cell index("index", 1);
+    if (is_functor(t) && functor(t) == index) {
+	set_index_spec(arg(t, 0));
+	return;
+    }
+    static const con_cell table("table", 1);
+    if (is_functor(t) && functor(t) == table) {
+	set_table_spec(arg(t, 0));
+	return;
+    }
+    throw syntax_exception_bad_directive(t, "Unsupported directive");
+}
+
+void interpreter_base::check_index_spec(const term spec, bool top)
+{
+    if (!is_functor(spec) || functor(spec).arity() == 0) {
+	throw syntax_exception_bad_directive(spec, "Index specification is not a structure");
+    }
+    size_t n = functor(spec).arity();
+    for (size_t i = 0; i < n; i++) {
+	term a = deref(arg(spec, i));
+	if (a.tag() == tag_t::INT) {
+	    auto v = static_cast<const int_cell &>(a).value();
+	    if (v == 0 || v == 1) {
+		continue;
+	    }
+	} else if (top && a.tag() == tag_t::STR) {
+	    // One level into the structure in this argument
+	    check_index_spec(a, false);
+	    continue;
+	}
+	throw syntax_exception_bad_directive(a, "Index argument must be 0 or 1");
+    }
+}
+
+void interpreter_base::set_index_spec(const term spec0)
+{
+    term spec = deref(spec0);
+    check_index_spec(spec, true);
+    qname qn(empty_list(), functor(spec));
+    index_specs_[qn] = spec;
+    // Recompile with the new index
+    changed_predicates_.insert(qn);
+    static_cast<wam_interpreter *>(this)->remove_compiled(qn);
+}
+
+// Name/Arity, or a comma list of them.
+void interpreter_base::set_table_spec(const term spec0)
+{
+    static const con_cell comma(",", 2);
+    static const con_cell slash("/", 2);
+
+    term spec = deref(spec0);
+    if (is_functor(spec) && functor(spec) == comma) {
+	set_table_spec(arg(spec, 0));
+	set_table_spec(arg(spec, 1));
+	return;
+    }
+    if (!is_functor(spec) || functor(spec) != slash) {
+	throw syntax_exception_bad_directive(spec, "Table specification must be Name/Arity");
+    }
+    term name = deref(arg(spec, 0));
+    term arity = deref(arg(spec, 1));
+    if (name.tag() != tag_t::CON || arity.tag() != tag_t::INT ||
+	static_cast<const int_cell &>(arity).value() < 0) {
+	throw syntax_exception_bad_directive(spec, "Table specification must be Name/Arity");
+    }
+    auto f = functor(atom_name(static_cast<const con_cell &>(name)),
+		     static_cast<const int_cell &>(arity).value());
+    set_tabled(qname(empty_list(), f));
+}
+
 void interpreter_base::load_program(const term t)
 {
     syntax_check_stack_.push_back(
@@ -389,7 +553,408 @@ void interpreter_base::load_program(std::istream &in)
 
 void interpreter_base::retract_predicate(const qname &pn)
 {
+    if (auto *pd = find_predicate_descriptor(pn)) {
+	if (pd->dynamic != nullptr) {
+	    dynamic_db_.clear(*pd->dynamic);
+	    reclaim_dynamic(*pd->dynamic);
+	    return;
+	}
+    }
     program_db_.erase(pn);
+    if (auto *pd = find_predicate_descriptor(pn)) {
+	pd->clauses = nullptr;
+    }
+    updated_predicates_.insert(pn);
+    changed_predicates_.insert(pn);
+}
+
+dynamic_predicate & interpreter_base::make_dynamic(predicate_descriptor &pd)
+{
+    if (pd.dynamic != nullptr) {
+	return *pd.dynamic;
+    }
+
+    auto &dp = *dynamic_db_.new_predicate(pd.qn.second.arity());
+    auto found = program_db_.find(pd.qn);
+    if (found != program_db_.end()) {
+	for (auto &m_clause : found->second) {
+	    auto clause = m_clause.clause();
+	    dynamic_db_.add(dp, *this, clause, clause_head(clause),
+			    m_clause.cost(), true);
+	}
+	program_db_.erase(found);
+	changed_predicates_.insert(pd.qn);
+    }
+    pd.clauses = nullptr;
+    pd.dynamic = &dp;
+
+    // Calls from compiled code go through dispatch from now on
+    static_cast<wam_interpreter *>(this)->remove_compiled(pd.qn);
+
+    return dp;
+}
+
+static inline int64_t int_arg(interpreter_base &interp, term t, size_t i)
+{
+    term a = interp.arg(t, i);
+    return static_cast<const int_cell &>(a).value();
+}
+
+uint64_t interpreter_base::oldest_dynamic_generation()
+{
+    static const con_cell dynamic_cont("$dyn", 4);
+    static const con_cell retract_cont("$ret", 4);
+
+    uint64_t oldest = dynamic_db_.generation();
+    for (auto *ch = b(); ch != nullptr; ch = ch->b) {
+	auto &bp = ch->bp;
+	if (bp.has_wam_code() || bp.term_code().tag() != tag_t::STR) {
+	    continue;
+	}
+	auto f = functor(bp.term_code());
+	if (f == dynamic_cont || f == retract_cont) {
+	    auto gen = int_arg(*this, bp.term_code(), 3);
+	    oldest = std::min(oldest, static_cast<uint64_t>(gen));
+	}
+    }
+    return oldest;
+}
+
+void interpreter_base::reclaim_dynamic(dynamic_predicate &dp)
+{
+    dynamic_db_.reclaim(dp, oldest_dynamic_generation());
+}
+
+//
+// Try the clauses of a dynamic predicate for 'goal'. A first call
+// (without a continuation) sees the clauses of the current
+// generation. If there are more candidates after the one that
+// matched, a choice point continues with '$dyn'(Goal, Id, Serial,
+// Gen), where Serial is the last clause tried; it is updated in
+// place so the continuation is only created once per call.
+//
+bool interpreter_base::call_dynamic(size_t pred_id, term goal, term cont)
+{
+    static const con_cell dynamic_cont("$dyn", 4);
+
+    auto &dp = *get_predicate_descriptor(pred_id).dynamic;
+    auto &candidates = dp.select(*this, goal);
+    size_t n = candidates.size();
+
+    uint64_t gen;
+    size_t i;
+    if (cont == term()) {
+	gen = dynamic_db_.generation();
+	i = 0;
+    } else {
+	gen = int_arg(*this, cont, 3);
+	auto serial = int_arg(*this, cont, 2);
+	i = dynamic_predicate::position_after(candidates, serial);
+    }
+
+    set_b0(b());
+
+    bool has_choice_point = false;
+    while (i < n) {
+	auto *c = candidates[i];
+	if (!c->is_visible(gen)) {
+	    i++;
+	    continue;
+	}
+	size_t j = i + 1;
+	while (j < n && !candidates[j]->is_visible(gen)) {
+	    j++;
+	}
+	if (j < n) {
+	    if (!has_choice_point) {
+		if (cont == term()) {
+		    cont = new_term(dynamic_cont,
+				    {goal, int_cell(pred_id), int_cell(0),
+				     int_cell(gen)});
+		}
+		allocate_choice_point(code_point(cont));
+		has_choice_point = true;
+	    }
+	    set_arg(cont, 2, int_cell(c->serial));
+	} else if (has_choice_point) {
+	    // Last candidate
+	    set_b(b()->b);
+	    if (b() != nullptr) set_register_hb(b()->h);
+	    has_choice_point = false;
+	}
+
+	auto copy_clause = copy(c->clause, dynamic_db_.env());
+	term copy_head = clause_head(copy_clause);
+	if (unify(copy_head, goal)) {
+	    allocate_environment(false);
+	    set_cp(empty_list());
+	    set_p(clause_body(copy_clause));
+	    set_qr(copy_head);
+	    add_accumulated_cost(c->cost);
+	    return true;
+	}
+	if (has_choice_point) {
+	    reset_to_choice_point(b());
+	}
+	i = j;
+    }
+
+    return false;
+}
+
+//
+// Like call_dynamic, but removes the first clause that unifies
+// with 'clause' (and is still there.) Continues with '$ret'(Clause,
+// Id, Serial, Gen) on backtracking.
+//
+bool interpreter_base::retract_dynamic(size_t pred_id, term clause, term cont)
+{
+    static const con_cell retract_cont("$ret", 4);
+    static const con_cell true_0("true", 0);
+
+    auto &dp = *get_predicate_descriptor(pred_id).dynamic;
+    term head = clause_head(clause);
+    term body = clause_body(clause);
+    if (is_empty_list(body)) {
+	body = true_0;
+    }
+    auto &candidates = dp.select(*this, head);
+    size_t n = candidates.size();
+
+    uint64_t gen;
+    size_t i;
+    if (cont == term()) {
+	gen = dynamic_db_.generation();
+	i = 0;
+    } else {
+	gen = int_arg(*this, cont, 3);
+	auto serial = int_arg(*this, cont, 2);
+	i = dynamic_predicate::position_after(candidates, serial);
+    }
+
+    auto is_candidate = [gen](const dynamic_clause *c)
+	{ return c->is_visible(gen) && c->is_alive(); };
+
+    bool has_choice_point = false;
+    while (i < n) {
+	auto *c = candidates[i];
+	if (!is_candidate(c)) {
+	    i++;
+	    continue;
+	}
+	size_t j = i + 1;
+	while (j < n && !is_candidate(candidates[j])) {
+	    j++;
+	}
+	if (j < n) {
+	    if (!has_choice_point) {
+		if (cont == term()) {
+		    cont = new_term(retract_cont,
+				    {clause, int_cell(pred_id), int_cell(0),
+				     int_cell(gen)});
+		}
+		allocate_choice_point(code_point(cont));
+		has_choice_point = true;
+	    }
+	    set_arg(cont, 2, int_cell(c->serial));
+	} else if (has_choice_point) {
+	    set_b(b()->b);
+	    if (b() != nullptr) set_register_hb(b()->h);
+	    has_choice_point = false;
+	}
+
+	auto copy_clause = copy(c->clause, dynamic_db_.env());
+	term copy_body = clause_body(copy_clause);
+	if (is_empty_list(copy_body)) {
+	    copy_body = true_0;
+	}
+	if (unify(clause_head(copy_clause), head) && unify(copy_body, body)) {
+	    dynamic_db_.remove(dp, c);
+	    // Proceed as if a fact was called (the choice point, if
+	    // any, saved the continuation.)
+	    allocate_environment(false);
+	    set_cp(empty_list());
+	    set_p(empty_list());
+	    if (dynamic_db_.should_reclaim(dp)) {
+		reclaim_dynamic(dp);
+	    }
+	    return true;
+	}
+	if (has_choice_point) {
+	    reset_to_choice_point(b());
+	}
+	i = j;
+    }
+
+    return false;
+}
+
+void interpreter_base::set_tabled(const qname &qn)
+{
+    get_predicate_descriptor(qn).tabled = true;
+    // Calls from compiled code must go through the tables
+    static_cast<wam_interpreter *>(this)->remove_compiled(qn);
+    abolish_all_tables();
+}
+
+void interpreter_base::abolish_all_tables()
+{
+    if (table_db_.is_evaluating()) {
+	throw interpreter_exception_unsupported("abolish_all_tables/0: Cannot remove tables while they are being evaluated");
+    }
+    table_db_.clear();
+}
+
+//
+// The evaluation of a tabled call runs its clauses like findall/3
+// runs its goal, adding each solution to the table. When no more are
+// found, it continues with the answers in the table (see
+// tabled_answers.)
+//
+struct meta_context_table : public meta_context {
+    inline meta_context_table(interpreter_base &interp, meta_fn fn)
+	: meta_context(interp, fn) { }
+    size_t call_id_;
+    term goal_;
+    size_t num_answers_; // Table size when the pass began
+};
+
+bool interpreter_base::call_tabled(term goal)
+{
+    uint64_t cost = 0;
+    auto &c = table_db_.find_or_add(*this, goal, cost);
+    add_accumulated_cost(cost);
+
+    switch (c.state) {
+    case tabled_call::COMPLETE:
+	return tabled_answers(c.id, goal, term());
+    case tabled_call::EVALUATING:
+	// A looping call; it gets the answers found so far.
+	table_db_.loop_to(c);
+	return tabled_answers(c.id, goal, term());
+    case tabled_call::INCOMPLETE:
+	if (table_db_.is_current(c)) {
+	    table_db_.loop_to(table_db_.evaluating_leader(c));
+	    return tabled_answers(c.id, goal, term());
+	}
+	break;
+    }
+
+    table_db_.push(c);
+
+    auto *context = new_meta_context<meta_context_table>(&tabled_meta);
+    context->call_id_ = c.id;
+    context->goal_ = goal;
+    context->num_answers_ = table_db_.num_answers();
+
+    set_top_e();
+    allocate_choice_point(code_point::fail());
+    set_top_b(b());
+    table_bypass_ = true;
+    set_p(code_point(goal));
+    set_cp(empty_list());
+
+    return true;
+}
+
+bool interpreter_base::tabled_meta(interpreter_base &interp,
+				   const meta_reason_t &reason)
+{
+    auto *context = interp.get_current_meta_context<meta_context_table>();
+    auto &db = interp.table_db_;
+
+    if (reason == meta_reason_t::META_DELETE) {
+	db.reset_stack();
+	interp.release_last_meta_context();
+	return true;
+    }
+
+    auto &c = db.get_call(context->call_id_);
+
+    interp.set_complete(false);
+
+    if (!interp.is_top_fail()) {
+	// A solution
+	uint64_t cost = 0;
+	db.add_answer(c, interp, context->goal_, cost);
+	interp.add_accumulated_cost(cost);
+	interp.set_p(con_cell("fail",0));
+	interp.set_cp(interp.empty_list());
+	return true;
+    }
+
+    interp.unwind_to_top_choice_point();
+    interp.set_top_fail(false);
+    interp.set_complete(false);
+
+    if (db.is_leader(c) && c.looped &&
+	db.num_answers() != context->num_answers_) {
+	// Its SCC found new answers; evaluate it again.
+	db.next_pass();
+	context->num_answers_ = db.num_answers();
+	interp.table_bypass_ = true;
+	interp.set_p(code_point(context->goal_));
+	interp.set_cp(interp.empty_list());
+	return true;
+    }
+
+    db.pop(c);
+    size_t call_id = context->call_id_;
+    term goal = context->goal_;
+    interp.release_last_meta_context();
+    if (interp.e0() != interp.top_e()) {
+	interp.deallocate_environment();
+    }
+    interp.set_p(interp.cp());
+
+    return interp.tabled_answers(call_id, goal, term());
+}
+
+//
+// Unify 'goal' with the answers of a tabled call, one at a time. More
+// answers are continued with '$tbl'(Goal, Id, Index, Gen), where
+// Index is the next answer. An incomplete call may still get more
+// answers, so it keeps its continuation until it runs out.
+//
+bool interpreter_base::tabled_answers(size_t call_id, term goal, term cont)
+{
+    static const con_cell table_cont("$tbl", 4);
+
+    uint64_t gen;
+    size_t i;
+    if (cont == term()) {
+	gen = table_db_.generation();
+	i = 0;
+    } else {
+	gen = int_arg(*this, cont, 3);
+	i = int_arg(*this, cont, 2);
+	if (gen != table_db_.generation()) {
+	    return false;
+	}
+    }
+
+    auto &c = table_db_.get_call(call_id);
+    size_t n = c.answers.size();
+    if (i >= n) {
+	return false;
+    }
+
+    if (i + 1 < n || c.state != tabled_call::COMPLETE) {
+	if (cont == term()) {
+	    cont = new_term(table_cont,
+			    {goal, int_cell(call_id), int_cell(0),
+			     int_cell(gen)});
+	}
+	set_arg(cont, 2, int_cell(i + 1));
+	allocate_choice_point(code_point(cont));
+    }
+
+    term answer = copy(c.answers[i], table_db_.env());
+    if (!unify(answer, goal)) {
+	return false;
+    }
+    set_cp(empty_list());
+    return true;
 }
 
 void interpreter_base::syntax_check_program(const term t)
@@ -578,6 +1143,30 @@ void interpreter_base::prepare_execution()
 }
 
 
+void interpreter_base::set_maximum_stack_size(size_t sz)
+{
+    size_t reserved = stack_space_.reserved();
+    max_stack_size_ = (sz > reserved) ? reserved : sz;
+}
+
+void interpreter_base::grow_stack(word_t *new_s)
+{
+    size_t need = (to_stack_relative_addr(new_s) + MAX_STACK_FRAME_WORDS + 1)
+	          * sizeof(word_t);
+    if (need > max_stack_size_ || !stack_space_.grow(need)) {
+	throw interpreter_exception_stack_overflow("Exceeded maximum stack size (" + boost::lexical_cast<std::string>(max_stack_size_) + " bytes.)");
+    }
+    stack_words_ = stack_space_.committed() / sizeof(word_t);
+}
+
+void interpreter_base::shrink_stack()
+{
+    word_t *top = allocate_stack();
+    stack_space_.shrink((to_stack_relative_addr(top) + MAX_STACK_FRAME_WORDS)
+			* sizeof(word_t));
+    stack_words_ = stack_space_.committed() / sizeof(word_t);
+}
+
 void interpreter_base::tidy_trail()
 {
     size_t from = (b() == nullptr) ? 0 : b()->tr;
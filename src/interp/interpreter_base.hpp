@@ -5,13 +5,18 @@
 
 #include <istream>
 #include <vector>
+#include <deque>
 #include <stack>
 #include <tuple>
 #include "../common/term_env.hpp"
+#include "../common/term_buffer.hpp"
 #include "builtins.hpp"
 #include "builtins_opt.hpp"
 #include "file_stream.hpp"
 #include "arithmetics.hpp"
+#include "dynamic_db.hpp"
+#include "tabling.hpp"
+#include "stack_space.hpp"
 #include "locale.hpp"
 
 namespace prologcoin { namespace interp {
@@ -50,6 +55,33 @@ private:
 typedef std::vector<managed_clause> managed_clauses;
 typedef managed_clauses predicate;
 typedef std::pair<predicate, size_t> indexed_predicate;
+
+//
+// Every called (module, functor) pair resolves once to a predicate
+// descriptor with a small integer id. It holds everything that is
+// needed to dispatch a call, so that a call is one lookup.
+//
+struct predicate_descriptor {
+    static const size_t NO_CODE = static_cast<size_t>(-1);
+
+    predicate_descriptor(size_t id0, const qname &qn0)
+	: id(id0), qn(qn0), bn_opt(nullptr), clauses(nullptr),
+	  dynamic(nullptr), tabled(false), wam_offset(NO_CODE), call_count(0),
+	  choice_points_avoided(0) { }
+
+    size_t id;
+    qname qn;
+    builtin bn;
+    const builtin_opt *bn_opt; // nullptr if none
+    predicate *clauses;        // nullptr if no clauses loaded
+    dynamic_predicate *dynamic; // nullptr unless modified by assert/retract
+    bool tabled;               // Calls go through the tables
+    size_t wam_offset;         // Entry point of compiled code
+    uint64_t call_count;       // Interpreted calls
+    size_t choice_points_avoided; // By the compiler's determinism analysis
+
+    inline bool is_compiled() const { return wam_offset != NO_CODE; }
+};
 }}
 
 namespace std {
@@ -123,6 +155,13 @@ public:
 	: syntax_exception(t, msg) { }
 };
 
+class syntax_exception_bad_directive : public syntax_exception
+{
+public:
+    syntax_exception_bad_directive(const common::term &t, const std::string &msg)
+	: syntax_exception(t, msg) { }
+};
+
 class interpreter_exception_out_of_funds : public interpreter_exception
 {
 public:
@@ -207,6 +246,20 @@ public:
 	: interpreter_exception(msg) { }
 };
 
+class interpreter_exception_zero_divisor : public interpreter_exception
+{
+public:
+    interpreter_exception_zero_divisor(const std::string &msg)
+	: interpreter_exception(msg) { }
+};
+
+class interpreter_exception_int_overflow : public interpreter_exception
+{
+public:
+    interpreter_exception_int_overflow(const std::string &msg)
+	: interpreter_exception(msg) { }
+};
+
 class wam_instruction_base;
 
 // Contemplated this be a union, but it's better to ensure
@@ -219,7 +272,8 @@ public:
     inline code_point(const common::con_cell l) : wam_code_(nullptr), term_code_(l){}
     inline code_point(const common::int_cell i) : wam_code_(nullptr), term_code_(i){}
     inline code_point(const code_point &other)
-        : wam_code_(other.wam_code_), term_code_(other.term_code_) { }
+        : wam_code_(other.wam_code_), module_(other.module_),
+	  term_code_(other.term_code_) { }
     inline code_point(wam_instruction_base *i)
         : wam_code_(i), term_code_(common::ref_cell(0)) { }
 
@@ -391,6 +445,7 @@ class interpreter_base : public common::term_env {
     friend class builtins_opt;
     friend class builtins_fileio;
     friend class arithmetics;
+    friend class arithmetics_fn;
     friend struct meta_context;
     friend class interpreter;
     friend struct new_instance_context;
@@ -418,6 +473,9 @@ public:
 
     void reset();
 
+    // Cost tracking is on by default. Without it compiled (WAM) code
+    // runs on an engine that neither counts nor checks cost, so
+    // accumulated_cost() and the maximum cost only cover the rest.
     bool is_track_cost() const { return track_cost_; }
     void set_track_cost(bool b) { track_cost_ = b; }
 
@@ -463,6 +521,52 @@ public:
 
     void retract_predicate(const qname &pn);
 
+    //
+    // Dynamic predicates, i.e. those modified by assert or retract
+    // (see dynamic_db.) A predicate that was consulted becomes
+    // dynamic the first time it is modified.
+    //
+    inline bool is_dynamic(const qname &qn)
+        { auto *pd = find_predicate_descriptor(qn);
+	  return pd != nullptr && pd->dynamic != nullptr; }
+
+    dynamic_predicate & make_dynamic(predicate_descriptor &pd);
+
+    inline dynamic_db & get_dynamic_db()
+        { return dynamic_db_; }
+
+    // The oldest generation a running call of a dynamic predicate
+    // (or retract) still sees.
+    uint64_t oldest_dynamic_generation();
+
+    //
+    // Tabled predicates, declared by ':- table p/N.' (see tabling.)
+    // Calls to them look up (or fill) their answer tables; their own
+    // clauses are always interpreted, so compiled code calls them
+    // through dispatch.
+    //
+    inline bool is_tabled(const qname &qn)
+        { auto *pd = find_predicate_descriptor(qn);
+	  return pd != nullptr && pd->tabled; }
+
+    void set_tabled(const qname &qn);
+
+    inline table_db & get_table_db()
+        { return table_db_; }
+
+    void abolish_all_tables();
+
+    //
+    // An index directive, e.g. ':- index(p(0, 1, tx(1, 0))).', tells
+    // which arguments (1) the compiled code of a predicate is indexed
+    // on, in order, overriding the compiler's own choice (see
+    // wam_compiler.) A structure indexes on its arguments instead.
+    //
+    void set_index_spec(const term spec);
+    inline const term * get_index_spec(const qname &qn) const
+        { auto it = index_specs_.find(qn);
+	  return it == index_specs_.end() ? nullptr : &it->second; }
+
     inline const std::vector<qname> & get_predicates() const
         { return program_predicates_; }
 
@@ -475,6 +579,9 @@ public:
     inline void clear_updated_predicates()
         { updated_predicates_.clear(); }
 
+    inline void clear_updated_predicate(const qname &pn)
+        { updated_predicates_.erase(pn); }
+
     std::string to_string_cp(const code_point &cp)
         { return cp.to_string(*this); }
 
@@ -524,6 +631,24 @@ public:
 	}
     }
 
+    predicate_descriptor & get_predicate_descriptor(const qname &qn);
+
+    inline predicate_descriptor & get_predicate_descriptor(con_cell module,
+							   con_cell f)
+        { return get_predicate_descriptor(std::make_pair(module, f)); }
+
+    inline predicate_descriptor & get_predicate_descriptor(size_t id)
+        { return predicate_descriptors_[id]; }
+
+    inline predicate_descriptor * find_predicate_descriptor(const qname &qn)
+        { auto it = predicate_descriptor_ids_.find(qn);
+	  return it == predicate_descriptor_ids_.end()
+	      ? nullptr : &predicate_descriptors_[it->second];
+	}
+
+    inline size_t num_predicate_descriptors() const
+        { return predicate_descriptors_.size(); }
+
     inline bool is_builtin(const qname &qn) const
         { return is_builtin(qn.first, qn.second); }
 
@@ -535,6 +660,19 @@ public:
 
     inline void set_maximum_cost(uint64_t cost) { maximum_cost_ = cost; }
 
+    // The stack starts small and grows in segments up to this limit
+    // (in bytes), beyond which stack_overflow is thrown. The limit can't
+    // exceed the reserved address range (stack_space::reserved().)
+    static const size_t DEFAULT_MAX_STACK_SIZE = 64*1024*1024;
+
+    inline size_t maximum_stack_size() const { return max_stack_size_; }
+    void set_maximum_stack_size(size_t sz);
+    inline size_t stack_committed_size() const
+        { return stack_space_.committed(); }
+
+    // Release stack segments above the current top
+    void shrink_stack();
+
     inline bool unify(term a, term b)
        { uint64_t cost = 0;
 	 bool ok = common::term_env::unify(a, b, cost);
@@ -603,6 +741,10 @@ protected:
     {
         return static_cast<size_t>(p - stack_);
     }
+    inline word_t * stack_base() const
+    {
+	return stack_;
+    }
 
     typedef size_t (*num_y_fn_t)(interpreter_base *interp, environment_base_t *);
 
@@ -828,8 +970,8 @@ protected:
 	}
 
 	if (to_stack_relative_addr(new_s) + MAX_STACK_FRAME_WORDS
-	    >= MAX_STACK_SIZE_WORDS) {
-	    throw interpreter_exception_stack_overflow("Exceeded maximum stack size (" + boost::lexical_cast<std::string>(MAX_STACK_SIZE) + " bytes.)");
+	    >= stack_words_) {
+	    grow_stack(new_s);
 	}
 
 	return new_s;
@@ -998,12 +1140,25 @@ protected:
     inline term_env & secondary_env()
         { return secondary_env_; }
 
+    inline common::term_buffer & solution_buffer()
+        { return solution_buffer_; }
+
     inline void reset_accumulated_cost(uint64_t value = 0)
         { accumulated_cost_ = value; }
 
     inline void add_accumulated_cost(uint64_t cost)
         { accumulated_cost_ += cost;
-          if (accumulated_cost_ >= maximum_cost_) {
+	  check_accumulated_cost();
+        }
+
+    // Add cost without checking it against the maximum. The check is
+    // then made at the next check_accumulated_cost(), which must happen
+    // before anything observable (a call or the end of execution.)
+    inline void defer_accumulated_cost(uint64_t cost)
+        { accumulated_cost_ += cost; }
+
+    inline void check_accumulated_cost()
+        { if (accumulated_cost_ >= maximum_cost_) {
 	      throw interpreter_exception_out_of_funds(
                         "Not enough funds to complete. Maximum was "
 			+ boost::lexical_cast<std::string>(maximum_cost_) + ".");
@@ -1020,6 +1175,15 @@ protected:
     bool has_told_standard_outputs();
     void load_builtins_file_io();
 
+    // Predicates whose clauses have been added or removed since the
+    // last time the clause indexes were synchronized.
+    inline bool has_changed_predicates() const
+        { return !changed_predicates_.empty(); }
+    inline const std::unordered_set<qname> & get_changed_predicates() const
+        { return changed_predicates_; }
+    inline void clear_changed_predicates()
+        { changed_predicates_.clear(); }
+
 private:
     void load_builtin(const qname &qn, builtin b);
     inline void load_builtin_opt(con_cell f, builtin_opt b)
@@ -1046,6 +1210,19 @@ private:
 
     common::cell first_arg_index(const term first_arg);
 
+    void load_directive(const term t);
+    void check_index_spec(const term spec, bool top);
+    void set_table_spec(const term spec);
+
+    bool call_dynamic(size_t pred_id, term goal, term cont);
+    bool retract_dynamic(size_t pred_id, term clause, term cont);
+    void reclaim_dynamic(dynamic_predicate &dp);
+
+    bool call_tabled(term goal);
+    bool tabled_answers(size_t call_id, term goal, term cont);
+    static bool tabled_meta(interpreter_base &interp,
+			    const meta_reason_t &reason);
+
     void syntax_check();
 
     void syntax_check_program(const term term);
@@ -1058,6 +1235,10 @@ private:
     // copy terms.
     term_env secondary_env_;
 
+    // Solutions collected by findall/3, bagof/3, setof/3 and
+    // aggregate_all/3. Nested calls share it (in LIFO order.)
+    common::term_buffer solution_buffer_;
+
     bool debug_;
     bool track_cost_;
     std::vector<std::function<void ()> > syntax_check_stack_;
@@ -1067,15 +1248,31 @@ private:
     std::unordered_map<qname, predicate> program_db_;
     std::vector<qname> program_predicates_;
     std::unordered_set<qname> updated_predicates_;
+    std::unordered_set<qname> changed_predicates_;
+
+    // Descriptors are never removed, so references to them are stable.
+    std::unordered_map<qname, size_t> predicate_descriptor_ids_;
+    std::deque<predicate_descriptor> predicate_descriptors_;
+
+    dynamic_db dynamic_db_;
+    std::unordered_map<qname, term> index_specs_;
+
+    table_db table_db_;
+    // The next call of a tabled predicate runs its clauses (it is
+    // the evaluation of the call) rather than looking up its table.
+    bool table_bypass_;
 
     // Stack is emulated at heap offset >= 2^59 (3 bits for tag, remember!)
     // (This conforms to the WAM standard where addr(stack) > addr(heap))
     const size_t STACK_BASE = 0x80000000000000;
-    const size_t MAX_STACK_SIZE = 1024*1024;
-    const size_t MAX_STACK_SIZE_WORDS = MAX_STACK_SIZE / sizeof(word_t);
     const size_t MAX_STACK_FRAME_WORDS = 4096 / sizeof(word_t);
 
+    void grow_stack(word_t *new_s);
+
+    stack_space stack_space_;
     word_t    *stack_;
+    size_t    stack_words_;  // Committed words
+    size_t    max_stack_size_;
 
     bool top_fail_;
     bool complete_;
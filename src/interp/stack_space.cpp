@@ -0,0 +1,89 @@
+#include <new>
+#include "stack_space.hpp"
+
+#if defined(__linux__) || defined(__APPLE__)
+#define STACK_SPACE_MMAP 1
+#include <sys/mman.h>
+#endif
+
+namespace prologcoin { namespace interp {
+
+stack_space::stack_space(size_t reserve)
+    : base_(nullptr), reserved_(round_up(reserve)), committed_(0),
+      mapped_(false)
+{
+#if STACK_SPACE_MMAP
+    void *mem = mmap(nullptr, reserved_, PROT_NONE,
+		     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mem != MAP_FAILED) {
+	base_ = static_cast<char *>(mem);
+	mapped_ = true;
+    }
+#endif
+    if (!mapped_) {
+	if (reserved_ > FALLBACK_SIZE) {
+	    reserved_ = FALLBACK_SIZE;
+	}
+	base_ = new char[reserved_];
+	committed_ = reserved_;
+    }
+    if (!grow(SEGMENT_SIZE)) {
+	throw std::bad_alloc();
+    }
+}
+
+stack_space::~stack_space()
+{
+#if STACK_SPACE_MMAP
+    if (mapped_) {
+	munmap(base_, reserved_);
+	return;
+    }
+#endif
+    delete [] base_;
+}
+
+size_t stack_space::round_up(size_t size)
+{
+    return (size + SEGMENT_SIZE - 1) / SEGMENT_SIZE * SEGMENT_SIZE;
+}
+
+bool stack_space::grow(size_t size)
+{
+    if (size <= committed_) {
+	return true;
+    }
+    size_t new_committed = round_up(size);
+    if (new_committed > reserved_) {
+	return false;
+    }
+#if STACK_SPACE_MMAP
+    if (mprotect(base_ + committed_, new_committed - committed_,
+		 PROT_READ | PROT_WRITE) != 0) {
+	return false;
+    }
+#endif
+    committed_ = new_committed;
+    return true;
+}
+
+void stack_space::shrink(size_t in_use)
+{
+    if (!mapped_) {
+	return;
+    }
+    size_t keep = round_up(in_use) + SEGMENT_SIZE;
+    if (keep >= committed_) {
+	return;
+    }
+#if STACK_SPACE_MMAP
+    size_t n = committed_ - keep;
+    madvise(base_ + keep, n, MADV_DONTNEED);
+    if (mprotect(base_ + keep, n, PROT_NONE) != 0) {
+	return;
+    }
+    committed_ = keep;
+#endif
+}
+
+}}
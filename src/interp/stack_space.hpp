@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef _interp_stack_space_hpp
+#define _interp_stack_space_hpp
+
+#include <cstddef>
+
+namespace prologcoin { namespace interp {
+
+//
+// Memory for the environment/choice point stack. A range of address
+// space is reserved up front, but memory is only committed in segments
+// as the stack grows and released again when it shrinks. The base
+// never moves, so pointers into the stack (and addresses relative to
+// STACK_BASE) stay valid while it grows.
+//
+// Where address space can't be reserved (no mmap) a smaller range
+// (FALLBACK_SIZE) is allocated at once and committing is a no-op.
+//
+class stack_space {
+public:
+    static const size_t SEGMENT_SIZE = 64*1024;
+    static const size_t RESERVED_SIZE = 1024*1024*1024;
+    static const size_t FALLBACK_SIZE = 16*1024*1024;
+
+    stack_space(size_t reserve = RESERVED_SIZE);
+    ~stack_space();
+
+    inline char * base() const { return base_; }
+    inline size_t reserved() const { return reserved_; }
+    inline size_t committed() const { return committed_; }
+
+    // Commit memory so that at least 'size' bytes are usable.
+    // Returns false if that exceeds the reserved range.
+    bool grow(size_t size);
+
+    // Release committed segments that are beyond 'in_use' bytes.
+    // One spare segment is kept to avoid growing again at once.
+    void shrink(size_t in_use);
+
+private:
+    static size_t round_up(size_t size);
+
+    char *base_;
+    size_t reserved_;
+    size_t committed_;
+    bool mapped_;
+};
+
+}}
+
+#endif
@@ -0,0 +1,244 @@
+#include "tabling.hpp"
+
+namespace prologcoin { namespace interp {
+
+using namespace prologcoin::common;
+
+//
+// term_trie
+//
+
+term_trie::term_trie()
+{
+    clear();
+}
+
+void term_trie::clear()
+{
+    nodes_.clear();
+    nodes_.push_back(node());
+}
+
+size_t term_trie::find(term_env &env, term t, uint64_t &cost)
+{
+    return walk(env, t, false, cost);
+}
+
+size_t term_trie::insert(term_env &env, term t, size_t value, uint64_t &cost)
+{
+    size_t leaf = walk(env, t, true, cost);
+    auto &n = nodes_[leaf];
+    if (n.value == NONE) {
+	n.value = value;
+	return NONE;
+    }
+    return n.value;
+}
+
+// Returns the node of the last cell of 't' (or its value if not 'add'.)
+size_t term_trie::walk(term_env &env, term t, bool add, uint64_t &cost)
+{
+    size_t at = 0;
+    uint64_t n = 0;
+
+    stack_.clear();
+    vars_.clear();
+    stack_.push_back(t);
+
+    // Cells of a bignum still to go (they're raw data)
+    size_t big_index = 0, big_left = 0;
+
+    while (big_left > 0 || !stack_.empty()) {
+	cell key;
+	if (big_left > 0) {
+	    key = env.get_heap()[big_index++];
+	    big_left--;
+	} else {
+	    t = env.deref(stack_.back());
+	    stack_.pop_back();
+	    switch (t.tag()) {
+	    case tag_t::REF: {
+		auto index = static_cast<ref_cell &>(t).index();
+		auto it = vars_.find(index);
+		size_t k;
+		if (it == vars_.end()) {
+		    k = vars_.size();
+		    vars_[index] = k;
+		} else {
+		    k = it->second;
+		}
+		key = ref_cell(k);
+		break;
+	    }
+	    case tag_t::STR: {
+		auto f = env.functor(t);
+		key = f;
+		for (size_t i = f.arity(); i > 0; i--) {
+		    stack_.push_back(env.arg(t, i - 1));
+		}
+		break;
+	    }
+	    case tag_t::BIG: {
+		auto &big = static_cast<big_cell &>(t);
+		big_index = big.index();
+		big_left = env.get_heap().num_cells(big);
+		key = env.get_heap()[big_index++];
+		big_left--;
+		break;
+	    }
+	    default:
+		key = t;
+		break;
+	    }
+	}
+	n++;
+
+	auto found = nodes_[at].children.find(key);
+	if (found != nodes_[at].children.end()) {
+	    at = found->second;
+	    continue;
+	}
+	if (!add) {
+	    cost += n;
+	    return NONE;
+	}
+	size_t next = nodes_.size();
+	nodes_[at].children[key] = next;
+	nodes_.push_back(node());
+	at = next;
+    }
+
+    cost += n;
+    return add ? at : nodes_[at].value;
+}
+
+//
+// table_db
+//
+
+table_db::table_db()
+    : env_(new term_env()), num_answers_(0), pass_(0), generation_(0)
+{
+}
+
+table_db::~table_db()
+{
+}
+
+tabled_call & table_db::find_or_add(term_env &src, term goal, uint64_t &cost)
+{
+    size_t id = call_trie_.insert(src, goal, calls_.size(), cost);
+    if (id == term_trie::NONE) {
+	id = calls_.size();
+	calls_.push_back(std::unique_ptr<tabled_call>(new tabled_call(id)));
+    }
+    return *calls_[id];
+}
+
+bool table_db::add_answer(tabled_call &c, term_env &src, term goal,
+			  uint64_t &cost)
+{
+    if (c.answer_trie.insert(src, goal, c.answers.size(), cost)
+	!= term_trie::NONE) {
+	return false;
+    }
+    uint64_t copy_cost = 0;
+    c.answers.push_back(env_->copy(goal, src, copy_cost));
+    cost += copy_cost;
+    num_answers_++;
+    return true;
+}
+
+size_t table_db::memory_words() const
+{
+    // A trie node is a value and a (small) hash map of children.
+    static const size_t NODE_WORDS = 8;
+
+    size_t nodes = call_trie_.num_nodes();
+    size_t answers = 0;
+    for (auto &c : calls_) {
+	nodes += c->answer_trie.num_nodes();
+	answers += c->answers.size();
+    }
+    return env_->heap_size() + answers + NODE_WORDS * nodes;
+}
+
+void table_db::push(tabled_call &c)
+{
+    c.state = tabled_call::EVALUATING;
+    c.depth = stack_.size();
+    c.leader = c.depth;
+    c.looped = false;
+    stack_.push_back(&c);
+    incomplete_marks_.push_back(incomplete_.size());
+}
+
+void table_db::loop_to(tabled_call &c)
+{
+    c.looped = true;
+    auto *top = stack_.back();
+    top->leader = std::min(top->leader, c.depth);
+}
+
+void table_db::pop(tabled_call &c)
+{
+    stack_.pop_back();
+    size_t mark = incomplete_marks_.back();
+    incomplete_marks_.pop_back();
+
+    if (is_leader(c)) {
+	c.state = tabled_call::COMPLETE;
+	for (size_t i = mark; i < incomplete_.size(); i++) {
+	    incomplete_[i]->state = tabled_call::COMPLETE;
+	    incomplete_[i]->listed = false;
+	}
+	incomplete_.resize(mark);
+	return;
+    }
+
+    c.state = tabled_call::INCOMPLETE;
+    c.pass = pass_;
+    c.leader_call = stack_[c.leader];
+    if (!c.listed) {
+	c.listed = true;
+	incomplete_.push_back(&c);
+    }
+    auto *top = stack_.back();
+    top->leader = std::min(top->leader, c.leader);
+}
+
+tabled_call & table_db::evaluating_leader(const tabled_call &c)
+{
+    // A leader that was popped since depends on one further down
+    auto *leader = c.leader_call;
+    while (leader->state != tabled_call::EVALUATING) {
+	leader = leader->leader_call;
+    }
+    return *leader;
+}
+
+void table_db::reset_stack()
+{
+    for (auto *c : stack_) {
+	c->state = tabled_call::INCOMPLETE;
+    }
+    for (auto *c : incomplete_) {
+	c->listed = false;
+    }
+    stack_.clear();
+    incomplete_.clear();
+    incomplete_marks_.clear();
+    pass_++;
+}
+
+void table_db::clear()
+{
+    reset_stack();
+    calls_.clear();
+    call_trie_.clear();
+    env_.reset(new term_env());
+    num_answers_ = 0;
+    generation_++;
+}
+
+}}
@@ -0,0 +1,158 @@
+#pragma once
+
+#ifndef _interp_tabling_hpp
+#define _interp_tabling_hpp
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../common/term_env.hpp"
+
+namespace prologcoin { namespace interp {
+
+//
+// A trie over terms up to variants. A term is flattened in preorder
+// (a functor for every structure, variables numbered by their first
+// occurrence), so two terms end at the same node iff they are
+// variants. Children are hashed on the cell at the next position.
+//
+class term_trie {
+public:
+    static const size_t NONE = static_cast<size_t>(-1);
+
+    term_trie();
+
+    // Value of the variant of 't' (in 'env'), or NONE if there is none.
+    // 'cost' is the number of cells visited.
+    size_t find(common::term_env &env, common::term t, uint64_t &cost);
+
+    // Like find, but adds 'value' for 't' if there is no variant of it.
+    size_t insert(common::term_env &env, common::term t, size_t value,
+		  uint64_t &cost);
+
+    inline size_t num_nodes() const { return nodes_.size(); }
+    void clear();
+
+private:
+    struct node {
+	node() : value(NONE) { }
+	size_t value;
+	std::unordered_map<common::cell, size_t> children;
+    };
+
+    size_t walk(common::term_env &env, common::term t, bool add,
+		uint64_t &cost);
+
+    std::vector<node> nodes_;
+    std::vector<common::term> stack_;
+    std::unordered_map<size_t, size_t> vars_;
+};
+
+//
+// A call (up to variants) of a tabled predicate and its answers. The
+// answers are kept in insertion order, so a consumer can continue
+// with the next one by index, also while more are being added.
+//
+struct tabled_call {
+    enum state_t {
+	EVALUATING, // On the evaluation stack
+	INCOMPLETE, // Evaluated, but depends on a call being evaluated
+	COMPLETE    // All answers are in the table
+    };
+
+    tabled_call(size_t id0)
+	: id(id0), state(INCOMPLETE), depth(0), leader(0), looped(false),
+	  listed(false), pass(0), leader_call(nullptr) { }
+
+    size_t id;
+    state_t state;
+    size_t depth;   // Position on the evaluation stack
+    size_t leader;  // Oldest call (depth) this one depends on
+    bool looped;    // Called again while being evaluated
+    bool listed;    // In the list of incomplete calls
+    uint64_t pass;  // When it was last evaluated (if incomplete)
+    tabled_call *leader_call; // The call it depends on (if incomplete)
+    term_trie answer_trie;
+    std::vector<common::term> answers;
+};
+
+//
+// The tables of all tabled predicates (see interpreter_base::call_tabled.)
+//
+// Calls are evaluated by linear tabling: a call that is already being
+// evaluated (a looping call) consumes the answers found so far instead
+// of being evaluated again. The oldest call of such a cycle (the leader
+// of the SCC) is then evaluated again until no new answers are found,
+// after which the leader and every call that depends on it are
+// complete. Answers (and their variant check) live here, in a heap of
+// their own, so they outlive the query.
+//
+class table_db {
+public:
+    table_db();
+    ~table_db();
+
+    inline common::term_env & env() { return *env_; }
+
+    // Changed by clear(), so that continuations into old tables fail.
+    inline uint64_t generation() const { return generation_; }
+
+    inline tabled_call & get_call(size_t id) { return *calls_[id]; }
+    inline size_t num_calls() const { return calls_.size(); }
+
+    // The call for the variant of 'goal' (in 'src'), created if new.
+    tabled_call & find_or_add(common::term_env &src, common::term goal,
+			      uint64_t &cost);
+
+    // Add 'goal' (in 'src') as an answer of 'c' unless it has a
+    // variant of it already. Returns true if it was added.
+    bool add_answer(tabled_call &c, common::term_env &src, common::term goal,
+		    uint64_t &cost);
+
+    // Answers added to any call so far.
+    inline size_t num_answers() const { return num_answers_; }
+
+    // Heap words and trie nodes used by the tables.
+    size_t memory_words() const;
+
+    // Evaluation stack
+    inline bool is_evaluating() const { return !stack_.empty(); }
+    void push(tabled_call &c);
+    // 'c' (on the stack) was called again.
+    void loop_to(tabled_call &c);
+    inline bool is_leader(const tabled_call &c) const
+        { return c.leader == c.depth; }
+    // Pop 'c' when one pass of its evaluation is done. A leader
+    // completes its SCC, otherwise it remains incomplete.
+    void pop(tabled_call &c);
+    // A leader evaluates its SCC again.
+    inline void next_pass() { pass_++; }
+    // An incomplete call that was evaluated since the last pass began
+    // is not evaluated again; its answers are consumed like those of
+    // a looping call (to its leader.)
+    inline bool is_current(const tabled_call &c) const
+        { return c.state == tabled_call::INCOMPLETE && c.pass == pass_ &&
+		 is_evaluating(); }
+    tabled_call & evaluating_leader(const tabled_call &c);
+    // Abandon evaluation (after an exception): calls on the stack are
+    // evaluated again next time.
+    void reset_stack();
+
+    // Remove all tables.
+    void clear();
+
+private:
+    std::unique_ptr<common::term_env> env_;
+    term_trie call_trie_;
+    std::vector<std::unique_ptr<tabled_call> > calls_;
+    std::vector<tabled_call *> stack_;
+    std::vector<tabled_call *> incomplete_;
+    std::vector<size_t> incomplete_marks_;
+    size_t num_answers_;
+    uint64_t pass_;
+    uint64_t generation_;
+};
+
+}}
+
+#endif
@@ -19,3 +19,105 @@ length([X|Xs], N) :-
 ?- length([1,2,3,4,5],Q2).
 % Expect: Q2 = 5
 % Expect: end
+
+%
+% Comparisons and integer division
+%
+
+count(N, N, []) :- !.
+count(I, N, [I|Is]) :-
+    I < N,
+    I1 is I + 1,
+    count(I1, N, Is).
+?- count(0, 5, Q3).
+% Expect: Q3 = [0,1,2,3,4]
+% Expect: end
+
+classify(X, Y, lt) :- X < Y.
+classify(X, Y, eq) :- X =:= Y.
+classify(X, Y, gt) :- X > Y.
+?- classify(2*3, 7 - 1, Q4).
+% Expect: Q4 = eq
+% Expect: end
+
+divmod(X, Y, Q, R) :-
+    Q is X // Y,
+    R is X - Q*Y,
+    R >= 0, R =< Y, Q =\= 0.
+?- divmod(17, 5, Q5, Q6).
+% Expect: Q5 = 3, Q6 = 2
+% Expect: end
+
+?- Q7 is (0 - 7) // 2.
+% Expect: Q7 = -3
+% Expect: end
+
+%
+% ISO integer functions
+%
+
+?- Q8 is -7 mod 2, Q9 is -7 rem 2, Q10 is -7 div 2, Q11 is 7 mod -2.
+% Expect: Q8 = 1, Q9 = -1, Q10 = -4, Q11 = -1
+% Expect: end
+
+?- Q12 is min(3, -4) + max(3, -4), Q13 is abs(-5) * sign(-5), Q14 is gcd(12, 18).
+% Expect: Q12 = -1, Q13 = -5, Q14 = 6
+% Expect: end
+
+?- Q15 is 1 << 10, Q16 is -16 >> 2, Q17 is 12 /\ 10, Q18 is 12 \/ 10, Q19 is 12 xor 10, Q20 is \ 5.
+% Expect: Q15 = 1024, Q16 = -4, Q17 = 8, Q18 = 14, Q19 = 6, Q20 = -6
+% Expect: end
+
+?- Q21 is 2 ** 10, Q22 is (-3) ^ 3, Q23 is msb(1000).
+% Expect: Q21 = 1024, Q22 = -27, Q23 = 9
+% Expect: end
+
+%
+% Overflow promotes to big integers (and back again)
+%
+
+fact(0, 1) :- !.
+fact(N, F) :-
+    N1 is N - 1,
+    fact(N1, F1),
+    F is N * F1.
+
+fact_ratio(N, M, R) :-
+    fact(N, F),
+    fact(M, G),
+    R is F // G.
+?- fact_ratio(25, 23, Q24).
+% Expect: Q24 = 600
+% Expect: end
+
+big_pow(A, B) :-
+    X is 2 ** 100,
+    Y is 2 ** 50,
+    Z is Y * Y,
+    X =:= Z, X > Y, X == Z,
+    A is X >> 98,
+    B is X mod 1000007.
+?- big_pow(Q25, Q26).
+% Expect: Q25 = 4, Q26 = 698635
+% Expect: end
+
+big_shift(A, B) :-
+    X is 1 << 70,
+    Y is X + 1,
+    Y > X,
+    A is Y - X,
+    B is msb(X).
+?- big_shift(Q27, Q28).
+% Expect: Q27 = 1, Q28 = 70
+% Expect: end
+
+big_neg(A, B) :-
+    X is 1 << 70,
+    Y is 0 - X,
+    Z is -X,
+    Y == Z, Y < 0,
+    A is sign(Y),
+    B is X + Y.
+?- big_neg(Q29, Q30).
+% Expect: Q29 = -1, Q30 = 0
+% Expect: end
@@ -0,0 +1,65 @@
+%
+% First argument indexing over larger tables
+%
+
+color(red, 1).
+color(green, 2).
+color(blue, 3).
+color(cyan, 4).
+color(magenta, 5).
+color(yellow, 6).
+color(black, 7).
+color(white, 8).
+color(orange, 9).
+color(purple, 10).
+color(brown, 11).
+color(grey, 12).
+color(blue, 13).
+
+?- color(orange, Q1).
+% Expect: Q1 = 9
+% Expect: end
+
+?- color(blue, Q2).
+% Expect: Q2 = 3
+% Expect: Q2 = 13
+% Expect: end
+
+?- color(pink, Q3).
+% Expect: fail
+
+num(1, one).
+num(2, two).
+num(3, three).
+num(4, four).
+num(5, five).
+num(6, six).
+num(7, seven).
+num(8, eight).
+num(9, nine).
+num(10, ten).
+
+?- num(7, Q4).
+% Expect: Q4 = seven
+% Expect: end
+
+?- num(11, Q5).
+% Expect: fail
+
+shape(f(_), 1).
+shape(g(_,_), 2).
+shape(h(_,_,_), 3).
+shape(f(_,_), 4).
+shape(k(_), 5).
+shape(l(_), 6).
+shape(m(_), 7).
+shape(n(_), 8).
+shape(o(_), 9).
+shape(p(_), 10).
+
+?- shape(f(a,b), Q6).
+% Expect: Q6 = 4
+% Expect: end
+
+?- shape(f(a,b,c), Q7).
+% Expect: fail
@@ -0,0 +1,29 @@
+%
+% Compiled predicates translated to native code
+%
+% Meta: native on
+
+len([], 0).
+len([_|Xs], N) :-
+    len(Xs, N0),
+    N is N0 + 1.
+
+?- len([a,b,c,d], Q1).
+% Expect: Q1 = 4
+% Expect: end
+
+pick(X, [X|_]).
+pick(X, [_|Xs]) :-
+    pick(X, Xs).
+
+?- pick(Q2, [1,2,3]), Q2 > 1.
+% Expect: Q2 = 2
+% Expect: Q2 = 3
+% Expect: end
+
+% Errors raised in native code reach the caller
+ratio(X, Y, Z) :-
+    Z is X // Y.
+
+?- ratio(7, 0, Q3).
+% Expect: is/2: Division by zero
@@ -0,0 +1,68 @@
+%
+% Test assert/retract (dynamic predicates)
+%
+
+?- retractall(item(_)), assertz(item(b)), assertz(item(c)), asserta(item(a)), findall(X, item(X), Q1).
+% Expect: Q1 = [a,b,c]
+% Expect: end
+
+?- item(Q2).
+% Expect: Q2 = a
+% Expect: Q2 = b
+% Expect: Q2 = c
+% Expect: end
+
+% A running call doesn't see clauses added or removed meanwhile
+% (the logical update view.)
+
+?- retractall(n(_)), assertz(n(1)), assertz(n(2)), (n(X), Y is X + 10, assertz(n(Y)), fail ; true), findall(Z, n(Z), Q3).
+% Expect: Q3 = [1,2,11,12]
+% Expect: end
+
+?- retractall(n(_)), assertz(n(1)), assertz(n(2)), assertz(n(3)), findall(X, (n(X), (X == 1 -> retract(n(3)) ; true)), Q4).
+% Expect: Q4 = [1,2,3]
+% Expect: end
+
+?- retractall(n(_)), assertz(n(1)), assertz(n(2)), retract(n(Q5)).
+% Expect: Q5 = 1
+% Expect: Q5 = 2
+% Expect: end
+
+?- findall(X, n(X), Q6).
+% Expect: Q6 = []
+% Expect: end
+
+% Clauses with bodies
+
+?- retractall(double(_, _)), assertz((double(X, Y) :- Y is 2 * X)), double(21, Q7).
+% Expect: Q7 = 42
+% Expect: end
+
+?- retractall(ready), assertz((ready :- double(1, 2))), retract((ready :- Q8)).
+% Expect: Q8 = double(1, 2)
+% Expect: end
+
+% A consulted predicate becomes dynamic when it is modified
+
+color(red).
+color(green).
+
+uses_color(X) :- color(X).
+
+?- uses_color(Q9).
+% Expect: Q9 = red
+% Expect: Q9 = green
+% Expect: end
+
+?- retractall(color(blue)), assertz(color(blue)), findall(X, uses_color(X), Q10).
+% Expect: Q10 = [red,green,blue]
+% Expect: end
+
+% Indexing on the first and on other arguments
+
+?- retractall(edge(_, _)), assertz(edge(a, b)), assertz(edge(b, c)), assertz(edge(c, d)), assertz(edge(d, e)), assertz(edge(e, f)), assertz(edge(f, g)), assertz(edge(g, h)), assertz(edge(h, i)), assertz(edge(X, X)), findall(A-B, (edge(c, B), edge(A, e)), Q11).
+% Expect: Q11 = [d-d,e-d,d-c,e-c]
+% Expect: end
+
+?- assert(Q12).
+% Expect: assert/1: Arguments are not sufficiently instantiated
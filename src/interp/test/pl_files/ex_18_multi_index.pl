@@ -0,0 +1,86 @@
+%
+% Indexing on other arguments than the first, over several arguments
+% and one level into structures
+%
+
+balance(acc1, usd, 10).
+balance(acc1, eur, 20).
+balance(acc2, usd, 30).
+balance(acc2, eur, 40).
+balance(acc3, usd, 50).
+
+?- balance(acc2, eur, Q1).
+% Expect: Q1 = 40
+% Expect: end
+
+?- balance(acc1, Q2, X).
+% Expect: Q2 = usd, X = 10
+% Expect: Q2 = eur, X = 20
+% Expect: end
+
+?- balance(Q3, usd, X).
+% Expect: Q3 = acc1, X = 10
+% Expect: Q3 = acc2, X = 30
+% Expect: Q3 = acc3, X = 50
+% Expect: end
+
+?- balance(acc1, gbp, Q4).
+% Expect: fail
+
+% Keyed on the second argument
+
+owner(_, alice, 1).
+owner(_, bob, 2).
+owner(_, carol, 3).
+owner(_, alice, 4).
+
+?- owner(x, alice, Q5).
+% Expect: Q5 = 1
+% Expect: Q5 = 4
+% Expect: end
+
+?- owner(x, Q6, 3).
+% Expect: Q6 = carol
+% Expect: end
+
+?- owner(x, dave, Q7).
+% Expect: fail
+
+% Always the same structure, so keyed on its first argument
+
+ledger(tx(t1, 100), a).
+ledger(tx(t2, 200), b).
+ledger(tx(t3, 300), c).
+ledger(tx(t2, 250), d).
+
+?- ledger(tx(t2, Q8), X).
+% Expect: Q8 = 200, X = b
+% Expect: Q8 = 250, X = d
+% Expect: end
+
+?- ledger(tx(t4, _), Q9).
+% Expect: fail
+
+?- ledger(other, Q10).
+% Expect: fail
+
+?- ledger(Q11, c).
+% Expect: Q11 = tx(t3, 300)
+% Expect: end
+
+% The directive overrides the choice
+
+:- index(transfer(0, 0, 1)).
+
+transfer(acc1, acc2, t1).
+transfer(acc2, acc3, t2).
+transfer(acc1, acc3, t3).
+
+?- transfer(Q12, Y, t3).
+% Expect: Q12 = acc1, Y = acc3
+% Expect: end
+
+?- transfer(acc1, Q13, T).
+% Expect: Q13 = acc2, T = t1
+% Expect: Q13 = acc3, T = t3
+% Expect: end
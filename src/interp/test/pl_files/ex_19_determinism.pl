@@ -0,0 +1,72 @@
+%
+% Clauses that exclude each other through an arithmetic test, a
+% term comparison or a cut are selected without a choice point
+%
+
+max(X, Y, Z) :- X >= Y, !, Z = X.
+max(X, Y, Z) :- Z = Y.
+
+?- max(3, 2, Q1).
+% Expect: Q1 = 3
+% Expect: end
+
+?- max(2, 3, Q2).
+% Expect: Q2 = 3
+% Expect: end
+
+sgn(X, S) :- X > 0, S = pos.
+sgn(X, S) :- X =< 0, S = nonpos.
+
+?- sgn(5, Q3).
+% Expect: Q3 = pos
+% Expect: end
+
+?- sgn(-5, Q4).
+% Expect: Q4 = nonpos
+% Expect: end
+
+?- sgn(0, Q5).
+% Expect: Q5 = nonpos
+% Expect: end
+
+fact(0, F) :- !, F = 1.
+fact(N, F) :- N1 is N - 1, fact(N1, F1), F is N * F1.
+
+?- fact(5, Q6).
+% Expect: Q6 = 120
+% Expect: end
+
+cmp(X, Y, R) :- X @< Y, R = lt.
+cmp(X, Y, R) :- Y @=< X, R = ge.
+
+?- cmp(a, b, Q7).
+% Expect: Q7 = lt
+% Expect: end
+
+?- cmp(b, a, Q8).
+% Expect: Q8 = ge
+% Expect: end
+
+% The test can't be decided for an unbound argument, so the clauses
+% are tried in order
+
+?- cmp(X, a, Q9).
+% Expect: Q9 = lt
+% Expect: end
+
+% Tests that don't exclude each other still leave a choice
+
+range(X, low) :- X < 10.
+range(X, mid) :- X < 100.
+range(_, any).
+
+?- range(5, Q10).
+% Expect: Q10 = low
+% Expect: Q10 = mid
+% Expect: Q10 = any
+% Expect: end
+
+?- range(50, Q11).
+% Expect: Q11 = mid
+% Expect: Q11 = any
+% Expect: end
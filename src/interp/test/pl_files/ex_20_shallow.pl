@@ -0,0 +1,68 @@
+%
+% Clause heads that fail before the neck are retried without a choice
+% point; the bindings they made must still be undone.
+%
+
+m(a, 1).
+m(b, 2).
+m(c, 2).
+
+n(b).
+n(c).
+
+% V is bound by the head of m(a, 1) before 1 = 2 fails
+
+s(R) :- m(V, 2), n(V), R = V.
+
+?- s(Q1).
+% Expect: Q1 = b
+% Expect: Q1 = c
+% Expect: end
+
+e(f(X, 1), X).
+e(f(y, 2), z).
+e(g(X), X).
+e(Z, w) :- Z = h(_).
+
+?- e(f(Q2, 2), B).
+% Expect: Q2 = y, B = z
+% Expect: end
+
+?- e(Q3, w).
+% Expect: Q3 = f(w, 1)
+% Expect: Q3 = g(w)
+% Expect: Q3 = h(_)
+% Expect: end
+
+% Not indexable, so every head is tried in turn
+
+tab(p(q(k1)), 1).
+tab(p(q(k2)), 2).
+tab(p(q(k3)), 3).
+tab(p(q(k4)), 4).
+
+?- tab(p(q(k3)), Q4).
+% Expect: Q4 = 3
+% Expect: end
+
+?- tab(p(q(k5)), Q5).
+% Expect: fail
+
+% Disjunctions in a body still push their choice point at once
+
+d(X, Y) :- (m(X, Y) ; X = d, Y = 0).
+
+?- d(Q6, 2).
+% Expect: Q6 = b
+% Expect: Q6 = c
+% Expect: end
+
+?- d(Q7, 0).
+% Expect: Q7 = d
+% Expect: end
+
+t(X, Y) :- m(X, Y), !.
+
+?- t(Q8, 2).
+% Expect: Q8 = b
+% Expect: end
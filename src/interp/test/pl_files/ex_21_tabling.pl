@@ -0,0 +1,73 @@
+%
+% Tabled predicates: calls are answered from tables, so left recursion
+% and cycles terminate, and every answer is found once.
+%
+
+:- table path/2.
+
+% Left recursive over a cyclic graph
+
+edge(a, b).
+edge(b, c).
+edge(c, a).
+edge(c, d).
+
+path(X, Y) :- path(X, Z), edge(Z, Y).
+path(X, Y) :- edge(X, Y).
+
+?- findall(Y, path(a, Y), L1), sort(L1, Q1).
+% Expect: L1 = [b,c,a,d], Q1 = [a,b,c,d]
+% Expect: end
+
+?- findall(X-Y, path(X, Y), L2), sort(L2, Q2).
+% Expect: L2 = [a-b,b-c,c-a,c-d,a-c,b-a,b-d,c-b,a-a,a-d,b-b,c-c], Q2 = [a-a,a-b,a-c,a-d,b-a,b-b,b-c,b-d,c-a,c-b,c-c,c-d]
+% Expect: end
+
+?- path(d, Q3).
+% Expect: fail
+
+% A complete table answers without evaluating again
+
+?- path(b, d), path(c, Q4), Q4 == d.
+% Expect: Q4 = d
+% Expect: end
+
+% Mutual recursion (one SCC)
+
+:- table even/1, odd/1.
+
+succ(0, 1).
+succ(1, 2).
+succ(2, 3).
+succ(3, 4).
+succ(4, 5).
+succ(5, 0).
+
+even(0).
+even(Y) :- odd(X), succ(X, Y).
+odd(Y) :- even(X), succ(X, Y).
+
+?- findall(X, odd(X), L5), sort(L5, Q5).
+% Expect: L5 = [1,3,5], Q5 = [1,3,5]
+% Expect: end
+
+?- findall(X, even(X), L6), sort(L6, Q6).
+% Expect: L6 = [0,2,4], Q6 = [0,2,4]
+% Expect: end
+
+% Answers are reused across calls
+
+:- table fib/2.
+
+fib(0, 0).
+fib(1, 1).
+fib(N, F) :- N > 1, N1 is N - 1, N2 is N - 2,
+             fib(N1, F1), fib(N2, F2), F is F1 + F2.
+
+?- fib(60, Q7).
+% Expect: Q7 = 1548008755920
+% Expect: end
+
+?- abolish_all_tables, fib(30, Q8).
+% Expect: Q8 = 832040
+% Expect: end
@@ -0,0 +1,111 @@
+%
+% Test bagof/3, setof/3 and aggregate_all/3
+%
+
+member(X, [X|_]).
+member(X, [_|Xs]) :- member(X, Xs).
+
+age(peter, 7).
+age(ann, 11).
+age(pat, 8).
+age(tom, 5).
+age(mike, 11).
+
+class(peter, a).
+class(ann, b).
+class(pat, a).
+class(tom, b).
+class(mike, a).
+
+?- findall(N-A, age(N, A), Q1).
+% Expect: Q1 = [peter-7,ann-11,pat-8,tom-5,mike-11]
+% Expect: end
+
+% Free variables give one bag per binding (on backtracking)
+
+?- bagof(N, age(N, A), Q2).
+% Expect: A = 5, Q2 = [tom]
+% Expect: A = 7, Q2 = [peter]
+% Expect: A = 8, Q2 = [pat]
+% Expect: A = 11, Q2 = [ann,mike]
+% Expect: end
+
+?- bagof(N, A^age(N, A), Q3).
+% Expect: Q3 = [peter,ann,pat,tom,mike]
+% Expect: end
+
+?- setof(A, N^age(N, A), Q4).
+% Expect: Q4 = [5,7,8,11]
+% Expect: end
+
+?- setof(N, A^(class(N, C), age(N, A)), Q5).
+% Expect: C = a, Q5 = [mike,pat,peter]
+% Expect: C = b, Q5 = [ann,tom]
+% Expect: end
+
+?- setof(A-N, age(N, A), Q6).
+% Expect: Q6 = [5-tom,7-peter,8-pat,11-ann,11-mike]
+% Expect: end
+
+% Unlike findall/3, no solutions fail
+
+?- bagof(N, age(N, 99), Q7).
+% Expect: fail
+
+?- setof(N, age(N, 99), Q8).
+% Expect: fail
+
+?- findall(N, age(N, 99), Q9).
+% Expect: Q9 = []
+% Expect: end
+
+% Aggregates
+
+?- aggregate_all(count, age(_, _), Q10).
+% Expect: Q10 = 5
+% Expect: end
+
+?- aggregate_all(sum(A), age(_, A), Q11).
+% Expect: Q11 = 42
+% Expect: end
+
+?- aggregate_all(sum(A*1000000000000), age(_, A), Q12).
+% Expect: Q12 = 42000000000000
+% Expect: end
+
+?- aggregate_all(max(A), age(_, A), Q13).
+% Expect: Q13 = 11
+% Expect: end
+
+?- aggregate_all(max(A, N), age(N, A), Q14).
+% Expect: Q14 = max(11, ann)
+% Expect: end
+
+?- aggregate_all(min(A, N), age(N, A), Q15).
+% Expect: Q15 = min(5, tom)
+% Expect: end
+
+?- aggregate_all(bag(N), class(N, a), Q16).
+% Expect: Q16 = [peter,pat,mike]
+% Expect: end
+
+?- aggregate_all(set(C), class(_, C), Q17).
+% Expect: Q17 = [a,b]
+% Expect: end
+
+?- aggregate_all(count, age(_, 99), Q18).
+% Expect: Q18 = 0
+% Expect: end
+
+?- aggregate_all(sum(A), age(_, 99), Q19).
+% Expect: Q19 = 0
+% Expect: end
+
+?- aggregate_all(max(A), age(_, 99), Q20).
+% Expect: fail
+
+% Nested collections share the solution buffer
+
+?- findall(C-Q, (member(C, [a,b]), aggregate_all(bag(N), class(N, C), Q)), Q21).
+% Expect: Q21 = [a-[peter,pat,mike],b-[ann,tom]]
+% Expect: end
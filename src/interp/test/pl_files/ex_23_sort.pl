@@ -0,0 +1,67 @@
+%
+% Test sort/2, msort/2, sort/4 and keysort/2
+%
+
+% Small integers (negative ones first) and atoms
+
+?- A is 0 - 1, B is 0 - 20, sort([3,A,7,B,3,0,7], Q1).
+% Expect: A = -1, B = -20, Q1 = [-20,-1,0,3,7]
+% Expect: end
+
+?- A is 0 - 1, B is 0 - 20, msort([3,A,7,B,3,0,7], Q2).
+% Expect: A = -1, B = -20, Q2 = [-20,-1,0,3,3,7,7]
+% Expect: end
+
+?- sort([pear,apple,fig,apple,banana], Q3).
+% Expect: Q3 = [apple,banana,fig,pear]
+% Expect: end
+
+% Mixed terms are in standard order; equal structures are duplicates
+
+?- sort([f(b),g(a),1,f(a),zz,f(b),100], Q4).
+% Expect: Q4 = [1,100,zz,f(a),f(b),g(a)]
+% Expect: end
+
+?- msort([f(b),f(a),f(b)], Q5).
+% Expect: Q5 = [f(a),f(b),f(b)]
+% Expect: end
+
+% keysort/2 is stable
+
+?- keysort([b-1,a-2,c-3,a-1,b-0], Q6).
+% Expect: Q6 = [a-2,a-1,b-1,b-0,c-3]
+% Expect: end
+
+?- keysort([f(x)-1,1-2,a-3,f(x)-0], Q7).
+% Expect: Q7 = [1-2,a-3,f(x)-1,f(x)-0]
+% Expect: end
+
+% sort/4 on an argument, in either order, with or without duplicates
+
+?- sort(1, '@<', [p(3,a),p(1,b),p(3,c),p(2,d)], Q8).
+% Expect: Q8 = [p(1, b),p(2, d),p(3, a)]
+% Expect: end
+
+?- sort(1, '@=<', [p(3,a),p(1,b),p(3,c),p(2,d)], Q9).
+% Expect: Q9 = [p(1, b),p(2, d),p(3, a),p(3, c)]
+% Expect: end
+
+?- sort(1, '@>=', [p(3,a),p(1,b),p(3,c),p(2,d)], Q10).
+% Expect: Q10 = [p(3, a),p(3, c),p(2, d),p(1, b)]
+% Expect: end
+
+?- sort(2, '@>', [p(3,a),p(1,b),p(3,c),p(2,b)], Q11).
+% Expect: Q11 = [p(3, c),p(1, b),p(3, a)]
+% Expect: end
+
+?- sort(0, '@>', [c,a,b,a], Q12).
+% Expect: Q12 = [c,b,a]
+% Expect: end
+
+?- sort(0, '@=<', [f(2),1,f(1),1], Q13).
+% Expect: Q13 = [1,1,f(1),f(2)]
+% Expect: end
+
+?- sort([], Q14), msort([], Q15), keysort([], Q16).
+% Expect: Q14 = [], Q15 = [], Q16 = []
+% Expect: end
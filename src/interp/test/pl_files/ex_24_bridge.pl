@@ -0,0 +1,21 @@
+%
+% Queries compiled to WAM code calling predicates that are still
+% interpreted. Repeated head variables must unify as in the interpreter.
+%
+% Meta: dont-compile q/3
+% Meta: dont-compile t/4
+%
+
+q(X,X,R) :- var(X), R = r1.
+q(X,X,R) :- nonvar(X), R = r2.
+
+?- q(A,1,R).
+% Expect: A = 1, R = r2
+% Expect: end
+
+t(f(A),f(A),f(B),R) :- A @< B, R = lt.
+t(f(A),f(A),f(B),R) :- A @>= B, R = ge.
+
+?- t(f(A),f(1),f(0),R).
+% Expect: A = 1, R = ge
+% Expect: end
@@ -3,6 +3,7 @@
 #include "../../common/term_parser.hpp"
 #include "../interpreter.hpp"
 #include <fstream>
+#include <map>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -13,6 +14,14 @@ using namespace prologcoin::interp;
 static bool do_compile = true;
 static bool fast_mode = false;
 
+// Costs of every answer are recorded (to bin/test/<component>/costs.txt)
+// and checked against costs.txt.gold in the test directory, if present.
+// This way any change to the cost accounting is spotted at once. After
+// an intended change (or new queries) the gold file is regenerated by
+// copying costs.txt from a complete run.
+static std::map<std::string, std::string> cost_gold;
+static std::ofstream cost_out;
+
 static std::vector<std::string> parse_x(const std::string &key, std::string &comments)
 {
     std::vector<std::string> matched;
@@ -75,6 +84,8 @@ static void process_meta(interpreter &interp, std::string &comments,
 	    interp.set_debug_enabled();
 	} else if (cmd == "fileio on") {
 	    interp.enable_file_io();
+	} else if (cmd == "native on") {
+	    interp.set_native_enabled(true);
 	} else if (cmd == "WAM-only") {
             opt["WAM-only"] = 1;
 	} else if (cmd == "xlocale") { 
@@ -144,11 +155,34 @@ static bool compare_files(const std::string &gen_path,
     return true;
 }
 
+static bool check_cost(const std::string &key, uint64_t cost)
+{
+    auto actual = boost::lexical_cast<std::string>(cost);
+    if (cost_out.is_open()) {
+	cost_out << key << " " << actual << std::endl;
+    }
+    if (cost_gold.empty()) {
+	return true;
+    }
+    auto it = cost_gold.find(key);
+    if (it == cost_gold.end()) {
+	std::cout << "Error. No gold cost for '" << key << "'\n";
+	return false;
+    }
+    if (it->second != actual) {
+	std::cout << "Error. Cost differs for '" << key << "': "
+		  << actual << " (expected " << it->second << ")\n";
+	return false;
+    }
+    return true;
+}
+
 static bool test_run_once(interpreter &interp,
 	  size_t iteration,
 	  const term &query,
 	  std::vector<std::string> &expected,
-	  std::vector<std::pair<std::string,std::string> > &expected_files)
+	  std::vector<std::pair<std::string,std::string> > &expected_files,
+	  const std::string &cost_key)
 {
     std::string actual;
     bool r = false;
@@ -181,6 +215,9 @@ static bool test_run_once(interpreter &interp,
     } else {
 	assert(match_strings(actual, expected[iteration]));
     }
+    assert(check_cost(cost_key + " "
+		      + boost::lexical_cast<std::string>(iteration),
+		      interp.accumulated_cost()));
 
     for (auto files : expected_files) {
 	auto gen_file = files.first;
@@ -203,6 +240,8 @@ static bool test_interpreter_file(const std::string &filepath,
     std::vector<term_parser *> files;
 
     const std::string dir = boost::filesystem::path(filepath).parent_path().string();
+    const std::string filename = boost::filesystem::path(filepath).filename().string();
+    size_t query_no = 0;
     
     interp.set_current_directory(dir);
 
@@ -295,7 +334,8 @@ static bool test_interpreter_file(const std::string &filepath,
 		// Check if this is a consult operation
 		term a = interp.arg(t, 0);
 		if (!interp.is_list(a)) {
-		    std::cout << "Unrecognized action. Only [...] is supported (to include other files)" << std::endl;
+		    // Any other directive is for the interpreter
+		    interp.load_clause(t);
 		    continue;
 		}
 		for (auto fileatom : interp.iterate_over(a)) {
@@ -328,13 +368,16 @@ static bool test_interpreter_file(const std::string &filepath,
 
 		size_t tr_mark = interp.trail_size();
 		term query = interp.arg(t, 0);
+		std::string cost_key = filename + " "
+		    + boost::lexical_cast<std::string>(query_no++);
 
 		// Skip the ordinary run if we have the option WAM-only
 		if (opt.count("WAM-only") == 0) {
 		    // Run this query first without WAM
 		    interp.set_wam_enabled(false);
 		    for (size_t i = 0; i < expected.size(); i++) {
-			test_run_once(interp, i, query, expected, expected_files);
+			test_run_once(interp, i, query, expected, expected_files,
+				      cost_key + " interp");
 		    }
 		    interp.unwind(tr_mark);
 		    interp.reset_files();
@@ -365,7 +408,8 @@ static bool test_interpreter_file(const std::string &filepath,
 
 		interp.set_register_hb(interp.heap_size());
 		for (size_t i = 0; i < expected.size(); i++) {
-		    test_run_once(interp, i, query, expected, expected_files);
+		    test_run_once(interp, i, query, expected, expected_files,
+				  cost_key + " wam");
 		}
 		interp.unwind(tr_mark);
 		interp.reset_files();
@@ -435,6 +479,20 @@ static void test_interpreter_files(const std::string &dir, std::function<void (i
 
     std::sort(files.begin(), files.end());
 
+    std::ifstream gold(files_dir + "/costs.txt.gold");
+    if (gold.good()) {
+	std::string line;
+	while (std::getline(gold, line)) {
+	    auto i = line.find_last_of(' ');
+	    if (i != std::string::npos) {
+		cost_gold[line.substr(0, i)] = line.substr(i+1);
+	    }
+	}
+	// dir is "/src/<component>/test/pl_files"
+	auto component = dir.substr(5, dir.find('/', 5) - 5);
+	cost_out.open(home_dir + "/bin/test/" + component + "/costs.txt");
+    }
+
     for (auto &filepath : files) {
 	interpreter interp;
 	fn(interp);
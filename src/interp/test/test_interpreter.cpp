@@ -294,6 +294,761 @@ static void test_interpreter_multi_instance()
     }
 }
 
+static void test_jit_indexing()
+{
+    header("test_jit_indexing()");
+
+    interpreter interp;
+
+    std::string program = "[";
+    for (size_t i = 0; i < 100; i++) {
+	if (i > 0) program += ",";
+	program += "edge(n" + boost::lexical_cast<std::string>(i) + ", n"
+	    + boost::lexical_cast<std::string>(i+1) + ", w"
+	    + boost::lexical_cast<std::string>(i % 7) + ")";
+    }
+    program += ", edge(X, X, self)].";
+
+    interp.load_program(interp.parse(program));
+
+    // Only the second argument is bound
+    term qr = interp.parse("edge(A, n42, W).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "A = n41, W = w6"));
+    assert(interp.next());
+    assert(check_terms(interp.get_result(false), "A = n42, W = self"));
+    assert(!interp.next());
+
+    interp.print_jit_index_stats(std::cout);
+    auto stats = interp.get_jit_index_stats();
+    assert(stats.num_predicates == 1);
+    assert(stats.num_arg_indexes == 1);
+
+    // Second and third bound; the combination leaves a single clause
+    qr = interp.parse("edge(A, n8, w0).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "A = n7"));
+    assert(!interp.has_more());
+
+    interp.print_jit_index_stats(std::cout);
+    stats = interp.get_jit_index_stats();
+    assert(stats.num_arg_indexes == 2);
+
+    // Adding a clause drops the index of the predicate
+    interp.load_clause(interp.parse("edge(n0, n42, extra)."));
+    qr = interp.parse("edge(A, n42, W).");
+    assert(interp.execute(qr));
+    assert(interp.next());
+    assert(interp.next());
+    assert(check_terms(interp.get_result(false), "A = n0, W = extra"));
+
+    interp.print_jit_index_stats(std::cout);
+    stats = interp.get_jit_index_stats();
+    assert(stats.num_invalidations == 1);
+
+    // Memory is bounded by the limit
+    interp.set_jit_index_limit(150);
+    for (size_t i = 0; i < 10; i++) {
+	qr = interp.parse("edge(n" + boost::lexical_cast<std::string>(i*10)
+			  + ", B, W).");
+	assert(interp.execute(qr));
+    }
+    interp.print_jit_index_stats(std::cout);
+    stats = interp.get_jit_index_stats();
+    assert(stats.num_resets > 0);
+    assert(stats.num_entries <= interp.jit_index_limit());
+}
+
+static void test_auto_compile()
+{
+    header("test_auto_compile()");
+
+    interpreter interp;
+    interp.set_auto_compile_threshold(10);
+
+    interp.load_program(interp.parse(
+	"[(len([], N, N)), "
+	" (len([_|Xs], N0, N) :- N1 is N0 + 1, len(Xs, N1, N))]."));
+
+    con_cell len("len", 3);
+    const std::string query = "len([a,b,c,d,e,f,g,h,i,j,k,l], 0, N).";
+
+    // With cost tracking a hot predicate stays interpreted, so the
+    // query costs the same every time.
+    uint64_t cost = 0;
+    for (size_t i = 0; i < 3; i++) {
+	term qr = interp.parse(query);
+	assert(interp.execute(qr));
+	assert(check_terms(interp.get_result(false), "N = 12"));
+	std::cout << "Cost " << interp.accumulated_cost() << "\n";
+	if (i == 0) {
+	    cost = interp.accumulated_cost();
+	}
+	assert(interp.accumulated_cost() == cost);
+    }
+    assert(!interp.is_compiled(interp.empty_list(), len));
+    assert(interp.num_auto_compiled() == 0);
+
+    interp.set_track_cost(false);
+
+    term qr = interp.parse(query);
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "N = 12"));
+    assert(!interp.is_compiled(interp.empty_list(), len));
+
+    // The next top level query is a safe point to compile at
+    qr = interp.parse(query);
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "N = 12"));
+    assert(interp.is_compiled(interp.empty_list(), len));
+    assert(interp.num_auto_compiled() == 1);
+
+    // Changing the predicate makes it recompile
+    interp.load_clause(interp.parse("len(foo, N, N)."));
+    qr = interp.parse("len(foo, 42, N).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "N = 42"));
+    assert(interp.is_compiled(interp.empty_list(), len));
+    assert(interp.num_auto_compiled() == 2);
+}
+
+static void test_query_cache()
+{
+    header("test_query_cache()");
+
+    interpreter interp;
+    interp.set_query_cache_size(1);
+
+    interp.load_program(interp.parse(
+	"[(app([], Ys, Ys)), "
+	" (app([X|Xs], Ys, [X|Zs]) :- app(Xs, Ys, Zs))]."));
+
+    // Same shape, different constants: compiled once
+    term qr = interp.parse("app([a,b], [c], Q).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "Q = [a,b,c]"));
+    qr = interp.parse("app([1,2], [3], Q).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "Q = [1,2,3]"));
+    assert(interp.num_query_cache_misses() == 1);
+    assert(interp.num_query_cache_hits() == 1);
+
+    // Another shape evicts the first one
+    qr = interp.parse("app([a], Q, [a,b,c]).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "Q = [b,c]"));
+    qr = interp.parse("app([x], [y], Q).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "Q = [x,y]"));
+    assert(interp.num_query_cache_misses() == 3);
+    assert(interp.num_query_cache_hits() == 1);
+}
+
+static void native_run(bool native, std::vector<std::string> &results,
+		       uint64_t &cost, size_t &num_blocks)
+{
+    interpreter interp;
+    interp.set_native_enabled(native);
+
+    interp.load_program(interp.parse(
+	"[(app([], Ys, Ys)), "
+	" (app([X|Xs], Ys, [X|Zs]) :- app(Xs, Ys, Zs)), "
+	" (nrev([], [])), "
+	" (nrev([X|Xs], Ys) :- nrev(Xs, Zs), app(Zs, [X], Ys)), "
+	" (fib(0, 0)), (fib(1, 1)), "
+	" (fib(N, F) :- N > 1, N1 is N - 1, N2 is N - 2, "
+	"               fib(N1, F1), fib(N2, F2), F is F1 + F2), "
+	" (color(red)), (color(green)), (color(blue))]."));
+    interp.compile();
+    num_blocks = interp.native_code().num_blocks();
+
+    const char *queries[] = {
+	"nrev([1,2,3,4,5,6,7,8,9,10], Q).",
+	"fib(15, Q).",
+	"app(Q, R, [a,b]).",
+	"color(Q), Q \\== red."
+    };
+    for (auto query : queries) {
+	// The cost is reset for each answer
+	term qr = interp.parse(query);
+	bool ok = interp.execute(qr);
+	cost += interp.accumulated_cost();
+	while (ok) {
+	    results.push_back(interp.get_result(false));
+	    ok = interp.next();
+	    cost += interp.accumulated_cost();
+	}
+    }
+}
+
+static void test_native()
+{
+    header("test_native()");
+
+    std::vector<std::string> results_wam, results_native;
+    uint64_t cost_wam = 0, cost_native = 0;
+    size_t blocks_wam = 0, blocks_native = 0;
+
+    native_run(false, results_wam, cost_wam, blocks_wam);
+    native_run(true, results_native, cost_native, blocks_native);
+
+    for (auto &r : results_native) {
+	std::cout << r << "\n";
+    }
+    std::cout << "Cost: " << cost_wam << " (WAM) " << cost_native
+	      << " (native)\n";
+
+    assert(blocks_wam == 0);
+    assert(!wam_native::is_supported() || blocks_native == 4);
+    assert(results_wam.size() == 7);
+    assert(results_wam == results_native);
+    assert(cost_wam == cost_native);
+}
+
+static void test_code_gc()
+{
+    header("test_code_gc()");
+
+    interpreter interp;
+    interp.set_native_enabled(true);
+    interp.set_query_cache_size(0);
+
+    interp.load_program(interp.parse(
+	"[(color(red)), (color(green)), (color(blue)), "
+	" (count(N, N)), "
+	" (count(N0, N) :- N0 < 3, N1 is N0 + 1, count(N1, N))]."));
+    interp.compile();
+    size_t num_segments = interp.num_segments();
+    assert(num_segments == 2);
+
+    // The pending choice point keeps the old code of color/1 alive
+    term qr = interp.parse("color(Q).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "Q = red"));
+    interp.compile(interp.empty_list(), con_cell("color", 1));
+    assert(interp.num_segments() == num_segments + 1);
+    assert(interp.collect_code() == 0);
+    assert(interp.next());
+    assert(check_terms(interp.get_result(false), "Q = green"));
+    assert(interp.next());
+    assert(check_terms(interp.get_result(false), "Q = blue"));
+    assert(!interp.next());
+    assert(interp.collect_code() == 1);
+    assert(interp.num_segments() == num_segments);
+
+    // Changing predicates over and over doesn't grow the code area
+    for (size_t i = 0; i < 100; i++) {
+	interp.load_clause(interp.parse("color(c" + boost::lexical_cast<std::string>(i) + ")."));
+	qr = interp.parse("count(0, N).");
+	assert(interp.execute(qr));
+	assert(check_terms(interp.get_result(false), "N = 0"));
+	while (interp.next()) { }
+	assert(interp.num_segments() <= num_segments + 1);
+    }
+    qr = interp.parse("color(c99), count(0, 3).");
+    assert(interp.execute(qr));
+    assert(interp.is_compiled(interp.empty_list(), con_cell("color", 1)));
+
+    std::cout << "Segments: " << interp.num_segments()
+	      << " Code size: " << interp.code_size() << "\n";
+}
+
+static void test_incremental_compile()
+{
+    header("test_incremental_compile()");
+
+    for (int native = 0; native < 2; native++) {
+	interpreter interp;
+	interp.set_native_enabled(native);
+	interp.set_query_cache_size(0);
+
+	interp.load_program(interp.parse(
+	    "[(p(a, 1)), (p(X, any)), (p(b, 2)), (p(f(1), 3)), "
+	    " (p([x], 4) :- true)]."));
+	interp.compile();
+	qname pn(interp.empty_list(), con_cell("p", 2));
+	assert(interp.find_clause_chain(pn) == nullptr);
+
+	// A change makes it a clause chain
+	interp.load_clause(interp.parse("p(a, 5)."));
+	interp.compile();
+	auto *chain = interp.find_clause_chain(pn);
+	assert(chain != nullptr && chain->size() == 6);
+
+	std::string answers;
+	term qr = interp.parse("p(a, Q).");
+	for (bool ok = interp.execute(qr); ok; ok = interp.next()) {
+	    answers += interp.get_result(false) + " ";
+	}
+	assert(answers == "Q = 1 Q = any Q = 5 ");
+	answers.clear();
+	qr = interp.parse("p(Q, R).");
+	for (bool ok = interp.execute(qr); ok; ok = interp.next()) {
+	    answers += interp.get_result(false) + " ";
+	}
+	assert(answers == "Q = a, R = 1 R = any Q = b, R = 2 "
+	                  "Q = f(1), R = 3 Q = [x], R = 4 Q = a, R = 5 ");
+	qr = interp.parse("p(c, Q).");
+	assert(interp.execute(qr));
+	assert(check_terms(interp.get_result(false), "Q = any"));
+	assert(!interp.next());
+
+	// Adding clauses appends to the same chain
+	for (size_t i = 0; i < 200; i++) {
+	    std::string n = boost::lexical_cast<std::string>(i);
+	    interp.load_clause(interp.parse("p(k" + n + ", " + n + ")."));
+	    qr = interp.parse("p(k" + n + ", Q), Q \\== any.");
+	    assert(interp.execute(qr));
+	    assert(check_terms(interp.get_result(false), "Q = " + n));
+	    while (interp.next()) { }
+	}
+	assert(interp.find_clause_chain(pn) == chain);
+	assert(chain->size() == 206);
+	assert(interp.num_segments() < 10);
+
+	// Reconsulting makes a new chain, and the old one goes away
+	interp.load_program(interp.parse("[(p(z, 0))]."));
+	qr = interp.parse("p(z, Q).");
+	assert(interp.execute(qr));
+	assert(check_terms(interp.get_result(false), "Q = 0"));
+	assert(interp.find_clause_chain(pn)->size() == 1);
+	assert(interp.num_segments() <= 4);
+    }
+}
+
+// Unification in WAM code only adds its cost, which is checked later.
+// Running out of funds must still happen at the same maximum.
+static void test_deferred_cost()
+{
+    header("test_deferred_cost()");
+
+    const char *program =
+	"[(same(X, X) :- true), (err(X, X, T) :- functor(T, _, _))].";
+    const char *big = "f(g(a, b), [1, 2, 3], h(c, [d, e]))";
+
+    auto run = [&](bool native, const std::string &query, uint64_t max,
+		   bool &out_of_funds) {
+	interpreter interp;
+	interp.set_native_enabled(native);
+	interp.set_query_cache_size(0);
+	interp.load_program(interp.parse(program));
+	interp.compile();
+	interp.set_maximum_cost(max);
+	out_of_funds = false;
+	try {
+	    interp.execute(interp.parse(query));
+	} catch (interpreter_exception_out_of_funds &) {
+	    out_of_funds = true;
+	} catch (interpreter_exception &) {
+	}
+	return interp.accumulated_cost();
+    };
+
+    const uint64_t unlimited = std::numeric_limits<uint64_t>::max();
+    const std::string same = std::string("same(") + big + ", " + big + ").";
+    const std::string err = std::string("err(") + big + ", " + big + ", _).";
+
+    for (int native = 0; native < 2; native++) {
+	bool out_of_funds = false;
+	uint64_t cost = run(native, same, unlimited, out_of_funds);
+	std::cout << same << " cost " << cost << "\n";
+	assert(!out_of_funds);
+	assert(run(native, same, cost + 1, out_of_funds) == cost);
+	assert(!out_of_funds);
+	run(native, same, cost, out_of_funds);
+	assert(out_of_funds);
+
+	// The error comes after the limit was passed.
+	cost = run(native, err, unlimited, out_of_funds);
+	std::cout << err << " cost " << cost << "\n";
+	assert(!out_of_funds);
+	run(native, err, cost, out_of_funds);
+	assert(out_of_funds);
+    }
+}
+
+// Without cost tracking compiled code runs on an engine that doesn't
+// count cost, but it must give the same answers.
+static void test_untracked_cost()
+{
+    header("test_untracked_cost()");
+
+    const char *program =
+	"[(app([], Y, Y) :- true), (app([X|Xs], Y, [X|Zs]) :- app(Xs, Y, Zs)),"
+	" (nrev([], []) :- true),"
+	" (nrev([X|Xs], Y) :- nrev(Xs, Z), app(Z, [X], Y))].";
+    const char *query = "nrev([a, b, c, d, e, f, g, h, i, j], Q).";
+
+    std::string answer[2];
+    uint64_t cost[2];
+    for (int track = 0; track < 2; track++) {
+	interpreter interp;
+	interp.set_track_cost(track);
+	interp.set_query_cache_size(0);
+	interp.load_program(interp.parse(program));
+	interp.compile();
+	assert(interp.execute(interp.parse(query)));
+	answer[track] = interp.get_result(false);
+	cost[track] = interp.accumulated_cost();
+	std::cout << "track cost " << track << ": " << answer[track]
+		  << " (Cost " << cost[track] << ")\n";
+	if (!track) {
+	    // Compiled code doesn't run out of funds
+	    interp.set_maximum_cost(cost[1 - track] + 1);
+	    assert(interp.execute(interp.parse(query)));
+	}
+    }
+    assert(answer[0] == answer[1]);
+    assert(cost[0] < cost[1]);
+}
+
+static void test_dynamic_db(size_t n)
+{
+    header("test_dynamic_db()");
+
+    interpreter interp;
+    qname pn(interp.empty_list(), con_cell("f", 2));
+
+    // A running call keeps seeing (and keeps alive) retracted clauses
+    term qr = interp.parse("assertz(f(1, a)), assertz(f(2, b)), assertz(f(3, c)), f(X, Y).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "X = 1, Y = a"));
+    auto &dp = *interp.find_predicate_descriptor(pn)->dynamic;
+    assert(dp.size() == 3 && dp.num_alive() == 3);
+
+    for (auto *c : dp.clauses()) {
+	interp.get_dynamic_db().remove(dp, c);
+    }
+    assert(dp.num_alive() == 0);
+    assert(interp.next());
+    assert(check_terms(interp.get_result(false), "X = 2, Y = b"));
+    assert(interp.next());
+    assert(check_terms(interp.get_result(false), "X = 3, Y = c"));
+    assert(!interp.next());
+
+    // New calls don't see them
+    qr = interp.parse("assertz(f(4, d)), f(X, Y).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "X = 4, Y = d"));
+    assert(!interp.next());
+
+    // Fill, look up and retract 'n' facts; each is linear in 'n'
+    interp.load_program(interp.parse(
+	"[(fill(0) :- !), (fill(N) :- assertz(g(N, v)), N1 is N - 1, fill(N1)),"
+	" (look(0) :- !), (look(N) :- g(N, _), N1 is N - 1, look(N1)),"
+	" (del(0) :- !), (del(N) :- retract(g(N, _)), N1 is N - 1, del(N1))]."));
+    interp.compile();
+    for (auto name : {"fill", "look", "del"}) {
+	auto start = boost::posix_time::microsec_clock::local_time();
+	qr = interp.parse(std::string(name) + "("
+			  + boost::lexical_cast<std::string>(n) + ").");
+	assert(interp.execute(qr));
+	auto stop = boost::posix_time::microsec_clock::local_time();
+	auto dt = stop - start;
+	std::cout << name << "(" << n << ") in "
+		  << dt.total_milliseconds() << " milliseconds\n";
+    }
+    auto &gp = *interp.find_predicate_descriptor(
+	qname(interp.empty_list(), con_cell("g", 2)))->dynamic;
+    // Retracted clauses were reclaimed along the way
+    assert(gp.num_alive() == 0);
+    assert(gp.size() < dynamic_db::RECLAIM_THRESHOLD);
+    std::cout << "Dynamic heap: " << interp.get_dynamic_db().env().heap_size()
+	      << " words\n";
+}
+
+static void test_tabling(size_t n)
+{
+    header("test_tabling()");
+
+    interpreter interp;
+    interp.load_program(interp.parse(
+	"[(:- table path/2),"
+	" (path(X, Y) :- path(X, Z), edge(Z, Y)), (path(X, Y) :- edge(X, Y)),"
+	" (reach(X, Y) :- edge(X, Y)), (reach(X, Y) :- edge(X, Z), reach(Z, Y)),"
+	" (fill(N, N) :- !),"
+	" (fill(I, N) :- I1 is I + 1, I2 is I + 2,"
+	"  assertz(edge(I, I1)), assertz(edge(I, I2)), fill(I1, N)),"
+	" (count(G, N) :- findall(x, G, L), len(L, N)),"
+	" (len([], 0)), (len([_|T], N) :- len(T, N0), N is N0 + 1)]."));
+    interp.compile();
+
+    // A DAG of 'n' edges: i -> i+1 and i -> i+2. Without tabling,
+    // the paths from 0 are as many as the Fibonacci numbers.
+    size_t m = n / 2;
+    term qr = interp.parse("fill(0, " + boost::lexical_cast<std::string>(m)
+			   + ").");
+    assert(interp.execute(qr));
+
+    // Untabled on a short suffix of the graph
+    size_t k = 22;
+    std::string from = boost::lexical_cast<std::string>(m - k);
+    auto start = boost::posix_time::microsec_clock::local_time();
+    qr = interp.parse("count(reach(" + from + ", _), N).");
+    assert(interp.execute(qr));
+    auto stop = boost::posix_time::microsec_clock::local_time();
+    std::cout << "Untabled, " << 2*k << " edges: " << interp.get_result(false)
+	      << " answers in " << (stop - start).total_milliseconds()
+	      << " milliseconds\n";
+
+    start = boost::posix_time::microsec_clock::local_time();
+    qr = interp.parse("count(path(" + from + ", _), N).");
+    assert(interp.execute(qr));
+    stop = boost::posix_time::microsec_clock::local_time();
+    std::cout << "Tabled, " << 2*k << " edges: " << interp.get_result(false)
+	      << " answers in " << (stop - start).total_milliseconds()
+	      << " milliseconds\n";
+    assert(check_terms(interp.get_result(false),
+		       "N = " + boost::lexical_cast<std::string>(k + 1)));
+
+    // The whole graph
+    start = boost::posix_time::microsec_clock::local_time();
+    qr = interp.parse("count(path(0, _), N).");
+    assert(interp.execute(qr));
+    stop = boost::posix_time::microsec_clock::local_time();
+    std::cout << "Tabled, " << n << " edges: " << interp.get_result(false)
+	      << " answers in " << (stop - start).total_milliseconds()
+	      << " milliseconds\n";
+    assert(check_terms(interp.get_result(false),
+		       "N = " + boost::lexical_cast<std::string>(m + 1)));
+
+    // Completed tables answer without evaluation
+    uint64_t cost = interp.accumulated_cost();
+    assert(interp.execute(qr));
+    assert(interp.accumulated_cost() < cost);
+
+    auto &db = interp.get_table_db();
+    std::cout << "Tables: " << db.num_calls() << " calls, "
+	      << db.num_answers() << " answers, "
+	      << db.memory_words() << " words\n";
+    assert(db.num_calls() == 2 && db.num_answers() == k + m + 2);
+
+    qr = interp.parse("abolish_all_tables.");
+    assert(interp.execute(qr));
+    assert(db.num_calls() == 0 && db.num_answers() == 0);
+    assert(db.memory_words() < 100);
+}
+
+static void test_deep_recursion()
+{
+    header("test_deep_recursion()");
+
+    interpreter interp;
+    interp.load_program(interp.parse(
+	"[(mk(0, []) :- !), (mk(N, [N|T]) :- N1 is N - 1, mk(N1, T)),"
+	" (len([], 0)), (len([_|T], N) :- len(T, N0), N is N0 + 1),"
+	" (deep(N) :- mk(200000, L), len(L, N))]."));
+
+    // Far deeper than what fits in the initial stack
+    size_t initial = interp.stack_committed_size();
+    term qr = interp.parse("deep(N).");
+    assert(interp.execute(qr));
+    assert(check_terms(interp.get_result(false), "N = 200000"));
+    std::cout << "Stack: " << initial << " bytes initially, "
+	      << interp.stack_committed_size() << " bytes after\n";
+
+    // Segments are released once the recursion has unwound
+    assert(interp.stack_committed_size() <= 2*initial);
+
+    // With a lower limit the same query overflows
+    interp.set_maximum_stack_size(1024*1024);
+    bool overflow = false;
+    try {
+	interp.execute(qr);
+    } catch (interpreter_exception_stack_overflow &ex) {
+	std::cout << "Expected: " << ex.what() << "\n";
+	overflow = true;
+    }
+    assert(overflow);
+}
+
+static void test_shallow_backtracking()
+{
+    header("test_shallow_backtracking()");
+
+    for (int native = 0; native < 2; native++) {
+	interpreter interp;
+	interp.set_native_enabled(native);
+	interp.set_query_cache_size(0);
+
+	interp.load_program(interp.parse(
+	    "[(m(a, 1)), (m(b, 2)), (m(c, 2)), (n(b)), (n(c)),"
+	    " (s(R) :- m(V, 2), n(V), R = V),"
+	    " (e(f(X, 1), X)), (e(f(y, 2), z)), (e(g(X), X)),"
+	    " (d(X, Y) :- (m(X, Y) ; X = d, Y = 0)),"
+	    " (tab(p(q(k1)), 1)), (tab(p(q(k2)), 2)), (tab(p(q(k3)), 3))]."));
+	interp.compile();
+
+	std::stringstream ss;
+	interp.print_code(ss);
+	assert(ss.str().find("neck") != std::string::npos);
+	assert(ss.str().find("try_me_else_body") != std::string::npos);
+
+	const char *queries[] = {
+	    // The head of m(a, 1) binds V (in the environment of s/1)
+	    // before it fails.
+	    "s(Q).",
+	    "e(f(Q, 2), R).",
+	    "e(Q, z).",
+	    "d(Q, 2).",
+	    "tab(p(q(k3)), Q).",
+	    "tab(p(q(k4)), Q)."
+	};
+	const char *expected[] = {
+	    "Q = b Q = c ",
+	    "Q = y, R = z ",
+	    "Q = f(z, 1) Q = f(y, 2) Q = g(z) ",
+	    "Q = b Q = c ",
+	    "Q = 3 ",
+	    ""
+	};
+	for (size_t i = 0; i < sizeof(queries)/sizeof(queries[0]); i++) {
+	    std::string answers;
+	    term qr = interp.parse(queries[i]);
+	    for (bool ok = interp.execute(qr); ok; ok = interp.next()) {
+		answers += interp.get_result(false) + " ";
+	    }
+	    std::cout << queries[i] << " " << answers << "\n";
+	    assert(answers == expected[i]);
+	}
+    }
+}
+
+static void test_inline_builtins()
+{
+    header("test_inline_builtins()");
+
+    for (int native = 0; native < 2; native++) {
+	interpreter interp;
+	interp.set_native_enabled(native);
+	interp.set_query_cache_size(0);
+
+	interp.load_program(interp.parse(
+	    "[(kind(X, var) :- var(X)), (kind(X, atom) :- atom(X)),"
+	    " (kind(X, int) :- integer(X)), (kind(X, atomic) :- atomic(X)),"
+	    " (kind(X, bound) :- nonvar(X)),"
+	    " (order(X, Y, same) :- X == Y), (order(X, Y, diff) :- X \\== Y),"
+	    " (order(X, Y, lt) :- X @< Y), (order(X, Y, ge) :- X @>= Y),"
+	    " (shape(T, F/N) :- functor(T, F, N))]."));
+	interp.compile();
+
+	std::stringstream ss;
+	interp.print_code(ss);
+	for (auto instr : {"test var(a0)", "test atom(a0)", "test integer(a0)",
+			   "test atomic(a0)", "test nonvar(a0)",
+			   "compare_term a0 == a1", "compare_term a0 \\== a1",
+			   "compare_term a0 @< a1", "functor a0, a1, a2"}) {
+	    assert(ss.str().find(instr) != std::string::npos);
+	}
+	assert(ss.str().find("builtin") == std::string::npos);
+
+	const char *queries[] = {
+	    "kind(_, Q).",
+	    "kind(foo, Q).",
+	    "kind(42, Q).",
+	    "order(f(A), f(A), Q).",
+	    "order(1, a, Q).",
+	    "order(b, a, Q).",
+	    "shape(f(a, b), Q).",
+	    "shape(foo, Q).",
+	    "shape(7, Q)."
+	};
+	const char *expected[] = {
+	    "Q = var ",
+	    "Q = atom Q = atomic Q = bound ",
+	    "Q = int Q = bound ",
+	    "Q = same Q = ge ",
+	    "Q = diff Q = lt ",
+	    "Q = diff Q = ge ",
+	    "Q = f/2 ",
+	    "Q = foo/0 ",
+	    "Q = 7/0 "
+	};
+	for (size_t i = 0; i < sizeof(queries)/sizeof(queries[0]); i++) {
+	    std::string answers;
+	    term qr = interp.parse(queries[i]);
+	    for (bool ok = interp.execute(qr); ok; ok = interp.next()) {
+		answers += interp.get_result(false) + " ";
+	    }
+	    std::cout << queries[i] << " " << answers << "\n";
+	    assert(answers == expected[i]);
+	}
+
+	// The same error as from the built-in
+	bool error = false;
+	try {
+	    interp.execute(interp.parse("shape(_, Q)."));
+	} catch (interpreter_exception &ex) {
+	    error = true;
+	}
+	assert(error);
+    }
+}
+
+static void test_sort(size_t n)
+{
+    header("test_sort()");
+
+    interpreter interp;
+    interp.setup_standard_lib();
+    interp.load_program(interp.parse(
+	"[(by_last(O, X, Y) :- A is X mod 10, B is Y mod 10,"
+	"  compare(O, A, B))]."));
+    interp.compile();
+
+    auto new_list = [&](bool wrap) {
+	term lst = interp.empty_list();
+	for (size_t i = 0; i < n; i++) {
+	    term x = int_cell(static_cast<int64_t>((i * 7919) % 100003) - 50000);
+	    if (wrap) {
+		x = interp.new_term(con_cell("f",1), {x});
+	    }
+	    lst = interp.new_dotted_pair(x, lst);
+	}
+	return lst;
+    };
+
+    // Small integers and structures (the generic path) cost the same
+    std::vector<uint64_t> costs;
+    for (size_t threads : {1, 4}) {
+	builtins_opt::set_sort_threads(threads);
+	for (bool wrap : {false, true}) {
+	    term args[] = { new_list(wrap), interp.new_ref() };
+	    uint64_t cost = interp.accumulated_cost();
+	    auto start = boost::posix_time::microsec_clock::local_time();
+	    assert(builtins_opt::msort_2(interp, 2, args));
+	    auto stop = boost::posix_time::microsec_clock::local_time();
+	    cost = interp.accumulated_cost() - cost;
+	    std::cout << "msort/2 of " << n
+		      << (wrap ? " structures" : " integers")
+		      << " (" << threads << " threads): "
+		      << (stop - start).total_milliseconds()
+		      << " milliseconds, cost " << cost << "\n";
+	    costs.push_back(cost);
+
+	    interpreter_base &ib = interp;
+	    size_t count = 0;
+	    term prev;
+	    for (term lst = ib.deref(args[1]); ib.is_dotted_pair(lst);
+		 lst = ib.deref(ib.arg(lst, 1)), count++) {
+		term x = interp.arg(lst, 0);
+		assert(count == 0 || interp.standard_order(prev, x) <= 0);
+		prev = x;
+	    }
+	    assert(count == n);
+	}
+    }
+    builtins_opt::set_sort_threads(0);
+    for (auto c : costs) {
+	assert(c == costs[0]);
+	assert(c >= builtins_opt::sort_cost(n));
+    }
+
+    term qr = interp.parse("predsort(by_last, [23,15,7,31,42,7], Q).");
+    assert(interp.execute(qr));
+    std::cout << interp.get_result(false) << "\n";
+    assert(interp.get_result(false) == "Q = [31,42,23,15,7]");
+}
 
 int main( int argc, char *argv[] )
 {
@@ -302,6 +1057,22 @@ int main( int argc, char *argv[] )
     test_backtracking_interpreter();
     test_interpreter_serialize();
     test_interpreter_multi_instance();
+    test_jit_indexing();
+    test_auto_compile();
+    test_query_cache();
+    test_native();
+    test_code_gc();
+    test_incremental_compile();
+    test_deep_recursion();
+    test_shallow_backtracking();
+    test_inline_builtins();
+    test_deferred_cost();
+    test_untracked_cost();
+    test_tabling(100000);
+    test_sort(200000);
+    // Run with 'bench' for a million facts
+    test_dynamic_db(argc > 1 && std::string(argv[1]) == "bench"
+		    ? 1000000 : 100000);
 
     return 0;
 }
@@ -1,5 +1,7 @@
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 #include "../../common/term_tools.hpp"
+#include "../../common/test/test_home_dir.hpp"
 #include "../interpreter.hpp"
 #include "../wam_interpreter.hpp"
 #include "../wam_compiler.hpp"
@@ -49,6 +51,9 @@ public:
     void test_compile2();
     void test_varset();
     void test_unsafe_set_unify();
+    void test_index();
+    void test_determinism();
+    void test_register_allocation();
 
 private:
     interpreter interp_;
@@ -332,15 +337,19 @@ static void test_instruction_sequence()
 					       code_point::fail(),
 					       int_cell(8)));
 
-    auto *hm1 = interp.new_hash_map();
-    hm1->insert(std::make_pair(con_cell("f", 2), int_cell(126)));
-    hm1->insert(std::make_pair(int_cell(1234), int_cell(207)));
-    interp.add(wam_instruction<SWITCH_ON_CONSTANT>(hm1));
+    wam_switch_table tbl1;
+    tbl1.push_back(std::make_pair(con_cell("f", 2), int_cell(126)));
+    tbl1.push_back(std::make_pair(int_cell(1234), int_cell(207)));
+    auto *sw1 = wam_instruction<SWITCH_ON_CONSTANT>::create(tbl1);
+    interp.add(*sw1);
+    delete [] reinterpret_cast<char *>(sw1);
 
-    auto *hm2 = interp.new_hash_map();
-    hm2->insert(std::make_pair(con_cell("f", 2), int_cell(221)));
-    hm2->insert(std::make_pair(con_cell("g", 3), int_cell(235)));
-    interp.add(wam_instruction<SWITCH_ON_STRUCTURE>(hm2));
+    wam_switch_table tbl2;
+    tbl2.push_back(std::make_pair(con_cell("f", 2), int_cell(221)));
+    tbl2.push_back(std::make_pair(con_cell("g", 3), int_cell(235)));
+    auto *sw2 = wam_instruction<SWITCH_ON_STRUCTURE>::create(tbl2);
+    interp.add(*sw2);
+    delete [] reinterpret_cast<char *>(sw2);
 
     interp.add(wam_instruction<NECK_CUT>());
     interp.add(wam_instruction<GET_LEVEL>(111));
@@ -456,8 +465,195 @@ static void test_unsafe_set_unify()
     test.test_unsafe_set_unify();
 }
 
+void test_wam_compiler::test_index()
+{
+    std::string prog =
+      R"PROG(
+            owner(X, a1, 10) :- X = alice.
+            owner(X, a2, 20) :- X = bob.
+            owner(X, a3, 30) :- X = carol.
+            ledger(tx(t1, 100), open).
+            ledger(tx(t2, 200), open).
+            ledger(tx(t3, 300), open).
+       )PROG";
+
+    interp_.load_program(prog);
+    interp_.compile(con_cell("[]",0), con_cell("owner",3));
+    interp_.compile(con_cell("[]",0), con_cell("ledger",2));
+
+    std::stringstream ss;
+    interp_.print_code(ss);
+    std::cout << ss.str();
+
+    // owner/3 is keyed on the second argument and ledger/2 on the
+    // first argument inside tx/2.
+    assert(ss.str().find("switch_on_term a1,") != std::string::npos);
+    assert(ss.str().find("arg(1, a0) of tx/2") != std::string::npos);
+}
+
+static void test_index()
+{
+    header("test_index");
+
+    test_wam_compiler test;
+    test.test_index();
+}
+
+void test_wam_compiler::test_determinism()
+{
+    std::string prog =
+      R"PROG(
+            max(X, Y, Z) :- X >= Y, !, Z = X.
+            max(X, Y, Z) :- Z = Y.
+       )PROG";
+
+    interp_.load_program(prog);
+    interp_.compile(con_cell("[]",0), con_cell("max",3));
+
+    std::stringstream ss;
+    interp_.print_code(ss);
+    std::cout << ss.str();
+
+    // Both outcomes of X >= Y go to a single clause; only an unbound
+    // argument falls back to the try_me_else chain.
+    assert(ss.str().find("guard a0 >= a1") != std::string::npos);
+
+    auto *pd = interp_.find_predicate_descriptor(
+	   qname(con_cell("[]",0), con_cell("max",3)));
+    std::cout << "Choice points avoided: " << pd->choice_points_avoided
+	      << std::endl;
+    assert(pd->choice_points_avoided == 2);
+}
+
+static void test_determinism()
+{
+    header("test_determinism");
+
+    test_wam_compiler test;
+    test.test_determinism();
+}
+
+void test_wam_compiler::test_register_allocation()
+{
+    std::string prog =
+      R"PROG(
+            unwrap(f(_, Y), Z) :- g(Y, Z).
+            p(X, Y, Z) :- q(X, W), r(Y, W, V), s(Z, V).
+       )PROG";
+
+    interp_.load_program(prog);
+    interp_.compile(con_cell("[]",0), con_cell("unwrap",2));
+    interp_.compile(con_cell("[]",0), con_cell("p",3));
+
+    std::stringstream ss;
+    interp_.print_code(ss);
+    std::cout << ss.str();
+
+    // Y goes straight into the argument register of the call, and Z
+    // of unwrap/2 and X of p/3 never leave theirs.
+    assert(ss.str().find("unify_variable a0") != std::string::npos);
+    assert(ss.str().find("get_variable x0, a0") == std::string::npos);
+    assert(ss.str().find("put_value x") == std::string::npos);
+
+    //
+    // The example programs compiled without and with register
+    // allocation: the number of instructions, of register moves
+    // (get_variable/put_value on X registers), and of environment
+    // slots kept at calls.
+    //
+    con_cell query_op("?-", 1);
+    con_cell action_op(":-", 1);
+
+    std::vector<std::string> files;
+    std::string dir = find_home_dir() + "/src/interp/test/pl_files";
+    boost::filesystem::directory_iterator it_end;
+    for (boost::filesystem::directory_iterator it(dir); it != it_end; ++it) {
+	std::string name = it->path().filename().string();
+	if ((boost::starts_with(name, "ex_") && boost::ends_with(name, ".pl"))
+	    || name == "std.pl") {
+	    files.push_back(it->path().string());
+	}
+    }
+    std::sort(files.begin(), files.end());
+
+    size_t num_preds = 0;
+    size_t num_instrs[2] = { 0, 0 }, num_moves[2] = { 0, 0 },
+	   num_y[2] = { 0, 0 };
+    for (auto &file : files) {
+	interpreter interp;
+	auto lib = interp.get_predicates();
+
+	std::ifstream in(file);
+	term_tokenizer tok(in);
+	term_parser parser(tok, interp.get_heap(), interp.get_ops());
+	while (!parser.is_eof()) {
+	    term t = parser.parse();
+	    parser.clear_var_names();
+	    if (!interp.is_functor(t, query_op) &&
+		!interp.is_functor(t, action_op)) {
+		interp.load_clause(t);
+	    }
+	}
+
+	for (size_t on = 0; on < 2; on++) {
+	    wam_compiler comp(interp);
+	    comp.set_register_allocation(on == 1);
+	    for (auto &qn : interp.get_predicates()) {
+		if (std::find(lib.begin(), lib.end(), qn) != lib.end()) {
+		    continue;
+		}
+		num_preds += on;
+		wam_interim_code code(interp);
+		comp.compile_predicate(qn, code);
+		for (auto *instr : code) {
+		    if (wam_compiler::is_interim_instruction(instr)) {
+			continue;
+		    }
+		    num_instrs[on]++;
+		    switch (instr->type()) {
+		    case GET_VARIABLE_X: case PUT_VALUE_X:
+			num_moves[on]++;
+			break;
+		    case CALL:
+			num_y[on] += reinterpret_cast<wam_instruction<CALL> *>(instr)->num_y();
+			break;
+		    case BUILTIN_R:
+			num_y[on] += reinterpret_cast<wam_instruction<BUILTIN_R> *>(instr)->num_y();
+			break;
+		    default:
+			break;
+		    }
+		}
+	    }
+	}
+    }
+
+    std::cout << std::endl << files.size() << " files, " << num_preds
+	      << " predicates" << std::endl;
+    std::cout << "  Instructions: " << num_instrs[0] << " -> "
+	      << num_instrs[1] << std::endl;
+    std::cout << "  Moves:        " << num_moves[0] << " -> "
+	      << num_moves[1] << std::endl;
+    std::cout << "  Y at calls:   " << num_y[0] << " -> "
+	      << num_y[1] << std::endl;
+
+    assert(num_instrs[1] < num_instrs[0]);
+    assert(num_moves[1] < num_moves[0]);
+    assert(num_y[1] <= num_y[0]);
+}
+
+static void test_register_allocation()
+{
+    header("test_register_allocation");
+
+    test_wam_compiler test;
+    test.test_register_allocation();
+}
+
 int main( int argc, char *argv[] )
 {
+    find_home_dir(argv[0]);
+
     test_flatten();
     test_instruction_sequence();
     test_partition();
@@ -465,6 +661,9 @@ int main( int argc, char *argv[] )
     test_compile2();
     test_varset();
     test_unsafe_set_unify();
+    test_index();
+    test_determinism();
+    test_register_allocation();
 
     return 0;
 }
@@ -1,5 +1,6 @@
 #include <queue>
 #include <algorithm>
+#include <unordered_set>
 #include "wam_compiler.hpp"
 #include "wam_interpreter.hpp"
 
@@ -82,7 +83,8 @@ void wam_interim_code::get_destinations(
     case TRY:
     case RETRY:
     case TRY_ME_ELSE:
-    case RETRY_ME_ELSE: {
+    case RETRY_ME_ELSE:
+    case TRY_ME_ELSE_BODY: {
 	auto *cp_instr = reinterpret_cast<wam_instruction_code_point *>(instr);
 	continuations.push_back(labels[cp_instr->cp().label()]);
 	if (index+1 < n) continuations.push_back(index+1);
@@ -709,6 +711,457 @@ void wam_compiler::remap_x_registers(wam_interim_code &instrs)
     }
 }
 
+//
+// Register allocation. After the Y registers have been picked, the
+// remaining temporaries are given X registers by coloring a conflict
+// graph built from their liveness, so a register is reused as soon
+// as the value in it is dead. Before that, temporaries are coalesced
+// with argument registers (as in Debray's allocator): a temporary
+// that is moved from or into one argument register, and whose live
+// range that argument register isn't otherwise needed in, lives in
+// the argument register instead and the moves go away. Argument
+// registers are a bank of their own, so this only works if all the
+// other instructions on the temporary have an _A variant.
+//
+void wam_compiler::get_reg_effect(wam_instruction_base *instr,
+				  reg_effect &eff)
+{
+    eff.x_use.clear();
+    eff.x_def.clear();
+    eff.a_use.clear();
+    eff.a_def.clear();
+    eff.all_a_use = false;
+    eff.all_a_def = false;
+
+    auto binary = [&] {
+	return reinterpret_cast<wam_instruction_binary_reg *>(instr); };
+    auto con_reg = [&] {
+	return static_cast<size_t>(
+	    reinterpret_cast<wam_instruction_con_reg *>(instr)->reg()); };
+    auto unary = [&] {
+	return reinterpret_cast<wam_instruction_unary_reg *>(instr)->reg(); };
+    auto arguments = [&](size_t arity) {
+	for (size_t i = 0; i < arity; i++) eff.a_use.push_back(i);
+	eff.all_a_def = true;
+    };
+
+    switch (instr->type()) {
+    case GET_VARIABLE_X:
+	eff.x_def.push_back(binary()->reg_1());
+	eff.a_use.push_back(binary()->reg_2());
+	break;
+    case GET_VALUE_X:
+	eff.x_use.push_back(binary()->reg_1());
+	eff.a_use.push_back(binary()->reg_2());
+	break;
+    case PUT_VARIABLE_X:
+	eff.x_def.push_back(binary()->reg_1());
+	eff.a_def.push_back(binary()->reg_2());
+	break;
+    case PUT_VALUE_X:
+	eff.x_use.push_back(binary()->reg_1());
+	eff.a_def.push_back(binary()->reg_2());
+	break;
+    case GET_VARIABLE_Y:
+    case GET_VALUE_Y:
+	eff.a_use.push_back(binary()->reg_2());
+	break;
+    case PUT_VARIABLE_Y:
+    case PUT_VALUE_Y:
+    case PUT_UNSAFE_VALUE_Y:
+	eff.a_def.push_back(binary()->reg_2());
+	break;
+    case GET_STRUCTURE_X: eff.x_use.push_back(con_reg()); break;
+    case PUT_STRUCTURE_X: eff.x_def.push_back(con_reg()); break;
+    case GET_STRUCTURE_A: eff.a_use.push_back(con_reg()); break;
+    case PUT_STRUCTURE_A: eff.a_def.push_back(con_reg()); break;
+    case GET_LIST_X:
+    case SET_VALUE_X:
+    case SET_LOCAL_VALUE_X:
+    case UNIFY_VALUE_X:
+    case UNIFY_LOCAL_VALUE_X:
+	eff.x_use.push_back(unary());
+	break;
+    case PUT_LIST_X:
+    case SET_VARIABLE_X:
+    case UNIFY_VARIABLE_X:
+	eff.x_def.push_back(unary());
+	break;
+    case GET_LIST_A:
+    case SET_VALUE_A:
+    case UNIFY_VALUE_A:
+	eff.a_use.push_back(unary());
+	break;
+    case PUT_LIST_A:
+    case SET_VARIABLE_A:
+    case UNIFY_VARIABLE_A:
+	eff.a_def.push_back(unary());
+	break;
+    case GET_CONSTANT:
+	eff.a_use.push_back(reinterpret_cast<wam_instruction<GET_CONSTANT> *>(instr)->ai());
+	break;
+    case PUT_CONSTANT:
+	eff.a_def.push_back(reinterpret_cast<wam_instruction<PUT_CONSTANT> *>(instr)->ai());
+	break;
+    case CALL:
+	arguments(reinterpret_cast<wam_instruction<CALL> *>(instr)->arity());
+	break;
+    case EXECUTE:
+	arguments(reinterpret_cast<wam_instruction<EXECUTE> *>(instr)->arity());
+	break;
+    case BUILTIN:
+	arguments(reinterpret_cast<wam_instruction<BUILTIN> *>(instr)->arity());
+	break;
+    case BUILTIN_R:
+	arguments(reinterpret_cast<wam_instruction<BUILTIN_R> *>(instr)->arity());
+	break;
+    case GET_STRUCTURE_Y:
+    case PUT_STRUCTURE_Y:
+    case GET_LIST_Y:
+    case PUT_LIST_Y:
+    case SET_VARIABLE_Y:
+    case SET_VALUE_Y:
+    case SET_LOCAL_VALUE_Y:
+    case SET_CONSTANT:
+    case SET_VOID:
+    case UNIFY_VARIABLE_Y:
+    case UNIFY_VALUE_Y:
+    case UNIFY_LOCAL_VALUE_Y:
+    case UNIFY_CONSTANT:
+    case UNIFY_VOID:
+    case ALLOCATE:
+    case DEALLOCATE:
+    case PROCEED:
+    case NECK:
+    case NECK_CUT:
+    case GET_LEVEL:
+    case CUT:
+    case GOTO:
+    case RESET_LEVEL:
+    case COST:
+	break;
+    default:
+	if (!is_interim_instruction(instr)) {
+	    eff.all_a_use = true;
+	    eff.all_a_def = true;
+	}
+	break;
+    }
+}
+
+void wam_compiler::get_reg_effects(
+	    const std::vector<wam_instruction_base *> &instrs,
+	    std::vector<reg_effect> &effects,
+	    size_t &num_x, size_t &num_a)
+{
+    size_t n = instrs.size();
+    effects.resize(n);
+    num_x = 0;
+    num_a = 1;
+    for (size_t i = 0; i < n; i++) {
+	auto &eff = effects[i];
+	get_reg_effect(instrs[i], eff);
+	for (auto xn : eff.x_use) num_x = std::max(num_x, xn + 1);
+	for (auto xn : eff.x_def) num_x = std::max(num_x, xn + 1);
+	for (auto ai : eff.a_use) num_a = std::max(num_a, ai + 1);
+	for (auto ai : eff.a_def) num_a = std::max(num_a, ai + 1);
+    }
+}
+
+//
+// Registers live after each instruction. Argument register ai is
+// number num_x + ai. The code has no loops, so walking it backwards
+// (successors first) reaches the fixpoint at once; the second round
+// only confirms it.
+//
+void wam_compiler::compute_liveness(
+	    wam_interim_code &instrs,
+	    std::vector<wam_instruction_base *> &instrs1,
+	    std::unordered_map<common::int_cell, size_t> &labels,
+	    const std::vector<reg_effect> &effects,
+	    size_t num_x, size_t num_a, liveness_t &live_out)
+{
+    size_t n = instrs1.size(), num_regs = num_x + num_a;
+    liveness_t live_in(n, std::vector<bool>(num_regs));
+    live_out.assign(n, std::vector<bool>(num_regs));
+
+    std::vector<size_t> sorted, dest;
+    instrs.get_topological_sort(instrs1, labels, sorted);
+
+    bool changed = true;
+    while (changed) {
+	changed = false;
+	for (auto index : sorted) {
+	    auto &out = live_out[index];
+	    instrs.get_destinations(instrs1, labels, index, dest);
+	    for (auto d : dest) {
+		for (size_t r = 0; r < num_regs; r++) {
+		    if (live_in[d][r]) out[r] = true;
+		}
+	    }
+	    auto &eff = effects[index];
+	    std::vector<bool> in(out);
+	    for (auto xn : eff.x_def) in[xn] = false;
+	    for (auto ai : eff.a_def) in[num_x + ai] = false;
+	    for (size_t ai = 0; eff.all_a_def && ai < num_a; ai++) {
+		in[num_x + ai] = false;
+	    }
+	    for (auto xn : eff.x_use) in[xn] = true;
+	    for (auto ai : eff.a_use) in[num_x + ai] = true;
+	    for (size_t ai = 0; eff.all_a_use && ai < num_a; ai++) {
+		in[num_x + ai] = true;
+	    }
+	    if (in != live_in[index]) {
+		live_in[index] = in;
+		changed = true;
+	    }
+	}
+    }
+}
+
+//
+// Get_list followed by two unify_variable on X registers becomes a
+// single superinstruction (see peephole_opt_fuse), which is worth
+// more than the move that coalescing either of them would save.
+//
+bool wam_compiler::in_fused_get_list(
+	    const std::vector<wam_instruction_base *> &instrs, size_t i)
+{
+    auto at_type = [&](size_t j, wam_instruction_type t) {
+	return j < instrs.size() && instrs[j]->type() == t; };
+    auto is_get_list = [&](size_t j) {
+	return at_type(j, GET_LIST_A) || at_type(j, GET_LIST_X); };
+
+    return (i >= 1 && is_get_list(i-1) && at_type(i+1, UNIFY_VARIABLE_X)) ||
+	   (i >= 2 && is_get_list(i-2) && at_type(i-1, UNIFY_VARIABLE_X));
+}
+
+//
+// Xn can live in ai if it's only moved from or into ai, if nothing
+// else writes ai while xn is live, and if ai isn't needed any more
+// where xn gets its value. Heads must leave the argument registers
+// alone (see shallow backtracking), so a temporary that gets its
+// value before the neck can only come from its argument register.
+//
+bool wam_compiler::can_coalesce(size_t xn, size_t ai,
+			const std::vector<wam_instruction_base *> &instrs,
+			const std::vector<reg_effect> &effects,
+			const liveness_t &live_out, size_t num_x, size_t neck)
+{
+    auto has = [](const std::vector<size_t> &v, size_t r) {
+	return std::find(v.begin(), v.end(), r) != v.end(); };
+
+    bool has_move = false;
+    size_t n = instrs.size();
+    for (size_t i = 0; i < n; i++) {
+	auto *instr = instrs[i];
+	auto &eff = effects[i];
+	if (has(eff.x_use, xn) || has(eff.x_def, xn)) {
+	    switch (instr->type()) {
+	    case GET_VARIABLE_X:
+	    case PUT_VALUE_X:
+		if (reinterpret_cast<wam_instruction_binary_reg *>(instr)->reg_2() != ai) {
+		    return false;
+		}
+		has_move = true;
+		break;
+	    case GET_STRUCTURE_X:
+	    case GET_LIST_X:
+	    case SET_VALUE_X:
+	    case UNIFY_VALUE_X:
+		break;
+	    case UNIFY_VARIABLE_X:
+		if (in_fused_get_list(instrs, i)) {
+		    return false;
+		}
+		// Fall through
+	    case PUT_STRUCTURE_X:
+	    case PUT_LIST_X:
+	    case SET_VARIABLE_X:
+		if (i < neck || live_out[i][num_x + ai]) {
+		    return false;
+		}
+		break;
+	    default:
+		return false;
+	    }
+	} else if (live_out[i][xn] && (eff.all_a_def || has(eff.a_def, ai))) {
+	    return false;
+	}
+    }
+    return has_move;
+}
+
+void wam_compiler::coalesce(size_t xn, size_t ai,
+			    const std::vector<wam_instruction_base *> &instrs,
+			    const std::vector<reg_effect> &effects,
+			    std::unordered_set<wam_instruction_base *> &dead)
+{
+    size_t n = instrs.size();
+    for (size_t i = 0; i < n; i++) {
+	auto *instr = instrs[i];
+	auto &eff = effects[i];
+	if (std::find(eff.x_use.begin(), eff.x_use.end(), xn) == eff.x_use.end() &&
+	    std::find(eff.x_def.begin(), eff.x_def.end(), xn) == eff.x_def.end()) {
+	    continue;
+	}
+	switch (instr->type()) {
+	case GET_VARIABLE_X:
+	case PUT_VALUE_X:
+	    dead.insert(instr);
+	    continue;
+	case GET_STRUCTURE_X: instr->set_type<GET_STRUCTURE_A>(); break;
+	case PUT_STRUCTURE_X: instr->set_type<PUT_STRUCTURE_A>(); break;
+	case GET_LIST_X: instr->set_type<GET_LIST_A>(); break;
+	case PUT_LIST_X: instr->set_type<PUT_LIST_A>(); break;
+	case SET_VARIABLE_X: instr->set_type<SET_VARIABLE_A>(); break;
+	case SET_VALUE_X: instr->set_type<SET_VALUE_A>(); break;
+	case UNIFY_VARIABLE_X: instr->set_type<UNIFY_VARIABLE_A>(); break;
+	case UNIFY_VALUE_X: instr->set_type<UNIFY_VALUE_A>(); break;
+	default: break;
+	}
+	if (instr->type() == GET_STRUCTURE_A || instr->type() == PUT_STRUCTURE_A) {
+	    reinterpret_cast<wam_instruction_con_reg *>(instr)->set_reg(ai);
+	} else {
+	    reinterpret_cast<wam_instruction_unary_reg *>(instr)->set_reg(ai);
+	}
+    }
+}
+
+void wam_compiler::erase_instructions(wam_interim_code &instrs,
+			const std::unordered_set<wam_instruction_base *> &dead)
+{
+    auto it = instrs.begin();
+    auto it_end = instrs.end();
+    auto it_prev = instrs.before_begin();
+    while (it != it_end) {
+        if (dead.count(*it)) {
+	    auto *instr = *it;
+	    it = instrs.erase_after(it_prev);
+	    delete instr;
+        } else {
+  	    it_prev = it;
+	    ++it;
+	}
+    }
+}
+
+void wam_compiler::color_x_registers(wam_interim_code &instrs)
+{
+    std::vector<wam_instruction_base *> instrs1;
+    std::unordered_map<common::int_cell, size_t> labels;
+    instrs.get_all(instrs1, labels);
+
+    std::vector<reg_effect> effects;
+    size_t num_x = 0, num_a = 0;
+    get_reg_effects(instrs1, effects, num_x, num_a);
+    if (num_x == 0) {
+	return;
+    }
+
+    liveness_t live_out;
+    compute_liveness(instrs, instrs1, labels, effects, num_x, num_a,
+		     live_out);
+
+    // Where a temporary gets its value, it conflicts with the ones
+    // that are live.
+    std::vector<std::vector<bool> > conflict(num_x, std::vector<bool>(num_x));
+    size_t n = instrs1.size();
+    for (size_t i = 0; i < n; i++) {
+	for (auto xn : effects[i].x_def) {
+	    for (size_t other = 0; other < num_x; other++) {
+		if (other != xn && live_out[i][other]) {
+		    conflict[xn][other] = true;
+		    conflict[other][xn] = true;
+		}
+	    }
+	}
+    }
+
+    // Color the temporaries in the order they appear with the lowest
+    // register not taken by a neighbour.
+    std::vector<int> color(num_x, -1);
+    std::vector<bool> taken;
+    for (size_t i = 0; i < n; i++) {
+	auto &eff = effects[i];
+	std::vector<size_t> regs(eff.x_def);
+	regs.insert(regs.end(), eff.x_use.begin(), eff.x_use.end());
+	for (auto xn : regs) {
+	    if (color[xn] != -1) {
+		continue;
+	    }
+	    taken.assign(num_x, false);
+	    for (size_t other = 0; other < num_x; other++) {
+		if (conflict[xn][other] && color[other] != -1) {
+		    taken[color[other]] = true;
+		}
+	    }
+	    size_t c = 0;
+	    while (taken[c]) c++;
+	    color[xn] = static_cast<int>(c);
+	}
+	if (!regs.empty()) {
+	    auto x_get = x_getter(instrs1[i]);
+	    x_setter(instrs1[i])(static_cast<size_t>(color[x_get()]));
+	}
+    }
+}
+
+void wam_compiler::allocate_x_registers(wam_interim_code &instrs)
+{
+    std::vector<wam_instruction_base *> instrs1;
+    std::unordered_map<common::int_cell, size_t> labels;
+    std::vector<reg_effect> effects;
+    liveness_t live_out;
+    std::unordered_set<wam_instruction_base *> dead;
+
+    bool changed = true;
+    while (changed) {
+	changed = false;
+
+	instrs1.clear();
+	labels.clear();
+	instrs.get_all(instrs1, labels);
+	size_t num_x = 0, num_a = 0;
+	get_reg_effects(instrs1, effects, num_x, num_a);
+	compute_liveness(instrs, instrs1, labels, effects, num_x, num_a,
+			 live_out);
+
+	size_t n = instrs1.size(), neck = 0;
+	for (size_t i = 0; i < n; i++) {
+	    if (instrs1[i]->type() == NECK) neck = i;
+	}
+
+	// A move into a temporary that is never read is dropped.
+	// Otherwise take each argument register at most once a round
+	// as coalescing changes its liveness.
+	dead.clear();
+	std::vector<bool> a_taken(num_a);
+	for (size_t i = 0; i < n; i++) {
+	    auto *instr = instrs1[i];
+	    if (instr->type() != GET_VARIABLE_X && instr->type() != PUT_VALUE_X) {
+		continue;
+	    }
+	    auto *move = reinterpret_cast<wam_instruction_binary_reg *>(instr);
+	    size_t xn = move->reg_1(), ai = move->reg_2();
+	    if (instr->type() == GET_VARIABLE_X && !live_out[i][xn]) {
+		dead.insert(instr);
+	    } else if (!a_taken[ai] && !dead.count(instr) &&
+		       can_coalesce(xn, ai, instrs1, effects, live_out,
+				    num_x, neck)) {
+		coalesce(xn, ai, instrs1, effects, dead);
+		a_taken[ai] = true;
+	    }
+	}
+	if (!dead.empty()) {
+	    erase_instructions(instrs, dead);
+	    changed = true;
+	}
+    }
+
+    color_x_registers(instrs);
+}
+
 bool wam_compiler::is_boundary_instruction(wam_instruction_base *instr)
 {
     return instr->type() == CALL || instr->type() == BUILTIN_R ||
@@ -727,7 +1180,7 @@ void wam_compiler::find_x_to_y_registers(wam_interim_code &instrs,
     std::vector<size_t> boundary_count(instrs1.size());
 
     // 
-    // Because of the presence of GOTO and internal TRY_ME_ELSE instructions
+    // Because of the presence of GOTO and internal TRY_ME_ELSE_BODY instructions
     // we don't have straight control flow. This means every instruction has
     // its own "boundary count," i.e. how many boundary instructions
     // (CALL or BUILTIN_R) are crossed in its control flow path.
@@ -842,14 +1295,56 @@ void wam_compiler::remap_y_registers(wam_interim_code &instrs)
     std::vector<size_t> sorted;
     instrs.get_topological_sort(instrs1, labels, sorted);
 
+    std::vector<size_t> order;
     for (auto index : sorted) {
 	auto *instr = instrs1[index];
 
         if (auto y_get = y_getter(instr)) {
-	    mapit(y_get());
+	    if (std::find(order.begin(), order.end(), y_get()) == order.end()) {
+		order.push_back(y_get());
+	    }
 	}
     }
 
+    //
+    // That orders the registers by their last use on straight code.
+    // With disjunctions, the registers needed at the most calls go
+    // first, so the environment can be trimmed at as many calls as
+    // possible.
+    //
+    if (allocate_regs_) {
+	std::unordered_map<size_t, std::unordered_set<size_t> > after;
+	std::unordered_map<size_t, size_t> num_calls;
+	std::vector<size_t> dest;
+	for (auto index : sorted) {
+	    auto &ys = after[index];
+	    instrs.get_destinations(instrs1, labels, index, dest);
+	    for (auto d : dest) {
+		auto &ys_d = after[d];
+		ys.insert(ys_d.begin(), ys_d.end());
+		if (auto y_get = y_getter(instrs1[d])) {
+		    ys.insert(y_get());
+		}
+	    }
+	    switch (instrs1[index]->type()) {
+	    case CALL:
+	    case BUILTIN_R:
+	    case RESET_LEVEL:
+		for (auto y : ys) num_calls[y]++;
+		break;
+	    default:
+		break;
+	    }
+	}
+	std::stable_sort(order.begin(), order.end(),
+			 [&](size_t y1, size_t y2) {
+			     return num_calls[y1] > num_calls[y2]; });
+    }
+
+    for (auto y : order) {
+	mapit(y);
+    }
+
     // Sweep through all instructions and update to renamed Y registers
     for (auto *instr : instrs) {
 	if (auto y_set = y_setter(instr)) {
@@ -1272,13 +1767,175 @@ void wam_compiler::compile_builtin(common::con_cell module,
 		} else {
 		    seq.push_back(wam_instruction<CUT>(0));
 		}
-	    } else {
+	    } else if (!compile_inline_builtin(bn.fn(), seq)) {
 		seq.push_back(wam_instruction<BUILTIN>(module, f, bn.fn()));
 	    }
 	}
     }
 }
 
+//
+// Type tests, standard order comparisons and functor/3 are done by
+// instructions that look at the argument registers directly, instead
+// of calling the built-in.
+//
+bool wam_compiler::compile_inline_builtin(builtin_fn fn,
+					  wam_interim_code &seq)
+{
+    static const std::pair<builtin_fn, wam_type_test> type_tests[] = {
+	{ builtins::var_1, TYPE_VAR },
+	{ builtins::nonvar_1, TYPE_NONVAR },
+	{ builtins::atom_1, TYPE_ATOM },
+	{ builtins::integer_1, TYPE_INTEGER },
+	{ builtins::atomic_1, TYPE_ATOMIC } };
+    static const std::pair<builtin_fn, wam_compare_op> term_compares[] = {
+	{ builtins::operator_at_less_than, CMP_LT },
+	{ builtins::operator_at_equals_less_than, CMP_LE },
+	{ builtins::operator_at_greater_than, CMP_GT },
+	{ builtins::operator_at_greater_than_equals, CMP_GE },
+	{ builtins::operator_equals, CMP_EQ },
+	{ builtins::operator_not_equals, CMP_NE } };
+
+    for (auto &t : type_tests) {
+	if (fn == t.first) {
+	    seq.push_back(wam_instruction<TYPE_TEST_A>(0, t.second));
+	    return true;
+	}
+    }
+    for (auto &c : term_compares) {
+	if (fn == c.first) {
+	    seq.push_back(wam_instruction<COMPARE_TERM_A>(0, 1, c.second));
+	    return true;
+	}
+    }
+    if (fn == builtins::functor_3) {
+	seq.push_back(wam_instruction<FUNCTOR_A>());
+	return true;
+    }
+    return false;
+}
+
+//
+// Arithmetic expressions over integers, variables and +, -, * and //
+// are compiled into instructions that work on the argument registers
+// (which are free between goals.) Each subexpression is evaluated
+// into the register given by its depth, so ai := ai <op> ai+1.
+//
+bool wam_compiler::is_arith_expr(const term t, size_t ai)
+{
+    static const common::con_cell plus("+", 2);
+    static const common::con_cell minus("-", 2);
+    static const common::con_cell times("*", 2);
+    static const common::con_cell int_div("//", 2);
+
+    if (ai + 1 >= builtins::MAX_ARGS) {
+	return false;
+    }
+    switch (t.tag()) {
+    case common::tag_t::INT:
+    case common::tag_t::REF:
+	return true;
+    case common::tag_t::STR: {
+	auto f = env_.functor(t);
+	if (f != plus && f != minus && f != times && f != int_div) {
+	    return false;
+	}
+	return is_arith_expr(env_.arg(t, 0), ai) &&
+	       is_arith_expr(env_.arg(t, 1), ai + 1);
+    }
+    default:
+	return false;
+    }
+}
+
+void wam_compiler::compile_arith_expr(const term t, size_t ai,
+				      wam_interim_code &seq)
+{
+    static const common::con_cell plus("+", 2);
+    static const common::con_cell minus("-", 2);
+    static const common::con_cell times("*", 2);
+
+    switch (t.tag()) {
+    case common::tag_t::INT:
+	seq.push_back(wam_instruction<PUT_CONSTANT>(t, ai));
+	break;
+    case common::tag_t::REF:
+	compile_query_ref(reg(ai, A_REG), static_cast<const common::ref_cell &>(t), seq);
+	break;
+    default: {
+	auto f = env_.functor(t);
+	compile_arith_expr(env_.arg(t, 0), ai, seq);
+	compile_arith_expr(env_.arg(t, 1), ai + 1, seq);
+	auto r0 = static_cast<uint32_t>(ai), r1 = static_cast<uint32_t>(ai + 1);
+	if (f == plus) {
+	    seq.push_back(wam_instruction<ADD_A>(r0, r1));
+	} else if (f == minus) {
+	    seq.push_back(wam_instruction<SUB_A>(r0, r1));
+	} else if (f == times) {
+	    seq.push_back(wam_instruction<MUL_A>(r0, r1));
+	} else {
+	    seq.push_back(wam_instruction<IDIV_A>(r0, r1));
+	}
+	break;
+    }
+    }
+}
+
+bool wam_compiler::compile_arith(common::con_cell module, common::con_cell f,
+				 const term goal, wam_interim_code &seq)
+{
+    auto fn = get_builtin(module, f).fn();
+    auto lhs = env_.arg(goal, 0);
+    auto rhs = env_.arg(goal, 1);
+
+    if (fn == builtins::is_2) {
+	if (!is_arith_expr(rhs, 0)) {
+	    return false;
+	}
+	// Builtin is/2 costs what unifying its (dereferenced) left-hand
+	// side with the result costs, i.e. 2, as evaluation is free.
+	// Binding a fresh variable or matching a constant costs nothing
+	// here, so charge it explicitly. A variable seen before would be
+	// unified with a cost that depends on its reference chain, so that
+	// case is left to builtin is/2.
+	switch (lhs.tag()) {
+	case common::tag_t::REF:
+	    if (has_reg<X_REG>(static_cast<const common::ref_cell &>(lhs))) {
+		return false;
+	    }
+	    compile_arith_expr(rhs, 0, seq);
+	    seq.push_back(wam_instruction<COST>(IS_2_COST));
+	    compile_program_ref(reg(0, A_REG), static_cast<const common::ref_cell &>(lhs), seq);
+	    return true;
+	case common::tag_t::INT:
+	case common::tag_t::CON:
+	    compile_arith_expr(rhs, 0, seq);
+	    seq.push_back(wam_instruction<COST>(IS_2_COST));
+	    seq.push_back(wam_instruction<GET_CONSTANT>(lhs, 0));
+	    return true;
+	default:
+	    return false;
+	}
+    }
+
+    wam_compare_op op;
+    if (fn == builtins::operator_less_than) op = CMP_LT;
+    else if (fn == builtins::operator_equals_less_than) op = CMP_LE;
+    else if (fn == builtins::operator_greater_than) op = CMP_GT;
+    else if (fn == builtins::operator_greater_than_equals) op = CMP_GE;
+    else if (fn == builtins::operator_arith_equals) op = CMP_EQ;
+    else if (fn == builtins::operator_arith_not_equals) op = CMP_NE;
+    else return false;
+
+    if (!is_arith_expr(lhs, 0) || !is_arith_expr(rhs, 1)) {
+	return false;
+    }
+    compile_arith_expr(lhs, 0, seq);
+    compile_arith_expr(rhs, 1, seq);
+    seq.push_back(wam_instruction<COMPARE_A>(0, 1, op));
+    return true;
+}
+
 bool wam_compiler::is_if_then_else(const term goal)
 {
     static const common::con_cell bn_impl = common::con_cell("->",2);
@@ -1332,7 +1989,7 @@ void wam_compiler::compile_if_then_else(const term goal, wam_interim_code &seq)
     // Compile (A -> B ; C)
     // into
     //
-    //     try_me_else L1
+    //     try_me_else_body L1
     //        [A]
     //     cut
     //        [B]
@@ -1358,7 +2015,7 @@ void wam_compiler::compile_if_then_else(const term goal, wam_interim_code &seq)
     size_t lvl = new_level();
     seq.push_back(wam_instruction<RESET_LEVEL>());
 
-    seq.push_back(wam_instruction<TRY_ME_ELSE>(l1));
+    seq.push_back(wam_instruction<TRY_ME_ELSE_BODY>(l1));
     seq.push_back(wam_interim_instruction<INTERIM_LABEL>(to_merge_0));
     seq.push_back(wam_instruction<GET_LEVEL>(static_cast<uint32_t>(lvl)));
     compile_goal(goal_a, false, seq);
@@ -1401,7 +2058,7 @@ void wam_compiler::compile_disjunction(const term disj, wam_interim_code &seq)
     // Compile (A ; B)
     // into
     //
-    //     try_me_else L1
+    //     try_me_else_body L1
     //        [A]
     // LX:
     //     goto L2
@@ -1421,10 +2078,10 @@ void wam_compiler::compile_disjunction(const term disj, wam_interim_code &seq)
 
     // Even though there are no internal cuts, we need the RESET_LEVEL
     // instruction to ensure that the correct stack space is reserved
-    // by following TRY_ME_ELSE
+    // by following TRY_ME_ELSE_BODY
     seq.push_back(wam_instruction<RESET_LEVEL>());
 
-    seq.push_back(wam_instruction<TRY_ME_ELSE>(l1));
+    seq.push_back(wam_instruction<TRY_ME_ELSE_BODY>(l1));
     compile_goal(goal_a, false, seq);
 
     seq.push_back(wam_interim_instruction<INTERIM_LABEL>(to_merge));
@@ -1473,6 +2130,10 @@ void wam_compiler::compile_goal(const term goal, bool first_goal,
 	f = env_.functor(env_.arg(goal, 1));
     }
     bool isbn = is_builtin(module, f);
+    if (isbn && f.arity() == 2 && env_.functor(goal) == f &&
+	compile_arith(module, f, goal, seq)) {
+	return;
+    }
     compile_query_or_program(goal, COMPILE_QUERY, seq);
     if (isbn) {
 	compile_builtin(module, f, first_goal, seq);
@@ -1594,6 +2255,65 @@ void wam_compiler::peephole_opt_void(wam_interim_code &instrs)
     }
 }
 
+//
+// Fuse the most frequent instruction sequences into superinstructions.
+// The sequences were selected from the opcode profile (see
+// wam_interpreter::print_opcode_profile) of nrev, queens and the test
+// programs. This must run last as the other passes don't know about
+// superinstructions.
+//
+void wam_compiler::peephole_opt_fuse(wam_interim_code &seq)
+{
+    typedef std::forward_list<wam_instruction_base *>::iterator iter;
+
+    auto at_type = [&](iter it, wam_instruction_type t) {
+	return it != seq.end() && (*it)->type() == t;
+    };
+
+    iter it = seq.before_begin();
+    while (it != seq.end()) {
+	iter it_0 = it; ++it_0;
+	if (it_0 == seq.end()) {
+	    break;
+	}
+	iter it_1 = it_0; ++it_1;
+	iter it_2 = it_1; if (it_2 != seq.end()) ++it_2;
+
+	if (at_type(it_0, COST) && at_type(it_1, ALLOCATE)) {
+	    auto *cost_instr = reinterpret_cast<wam_instruction<COST> *>(*it_0);
+	    auto cost = cost_instr->cost();
+	    delete *it_0;
+	    delete *it_1;
+	    seq.erase_after(it, it_2);
+	    it = seq.insert_after(it, wam_instruction<COST_ALLOCATE>(cost));
+	} else if (at_type(it_0, GET_LIST_A) &&
+		   at_type(it_1, UNIFY_VARIABLE_X) &&
+		   at_type(it_2, UNIFY_VARIABLE_X)) {
+	    auto ai = reinterpret_cast<wam_instruction<GET_LIST_A> *>(*it_0)->ai();
+	    auto xn1 = reinterpret_cast<wam_instruction<UNIFY_VARIABLE_X> *>(*it_1)->xn();
+	    auto xn2 = reinterpret_cast<wam_instruction<UNIFY_VARIABLE_X> *>(*it_2)->xn();
+	    iter it_3 = it_2; ++it_3;
+	    delete *it_0;
+	    delete *it_1;
+	    delete *it_2;
+	    seq.erase_after(it, it_3);
+	    it = seq.insert_after(it,
+		  wam_instruction<GET_LIST_A_UNIFY_VARIABLE_XX>(ai, xn1, xn2));
+	} else if (at_type(it_0, PUT_VALUE_X) && at_type(it_1, PUT_VALUE_X)) {
+	    auto *p1 = reinterpret_cast<wam_instruction<PUT_VALUE_X> *>(*it_0);
+	    auto *p2 = reinterpret_cast<wam_instruction<PUT_VALUE_X> *>(*it_1);
+	    wam_instruction<PUT_VALUE_XX> fused(p1->xn(), p1->ai(),
+						p2->xn(), p2->ai());
+	    delete *it_0;
+	    delete *it_1;
+	    seq.erase_after(it, it_2);
+	    it = seq.insert_after(it, fused);
+	} else {
+	    it = it_0;
+	}
+    }
+}
+
 void wam_compiler::reset_clause_temps()
 {
     goal_count_ = 0;
@@ -1747,6 +2467,11 @@ void wam_compiler::compile_clause(const managed_clause &m_clause,
     compile_query_or_program(head, COMPILE_PROGRAM, seq);
     seen_vars_ |= varsets_[head];
 
+    // Clauses with an environment push the choice point at allocate
+    if (neck_ && !needs_env) {
+	seq.push_back(wam_instruction<NECK>());
+    }
+
     term body = clause_body(clause);
     bool first_goal = true;
     for (auto goal : for_all_goals(body)) {
@@ -1773,7 +2498,11 @@ void wam_compiler::compile_clause(const managed_clause &m_clause,
     update_calls_for_environment_trimming(seq);
     remap_to_unsafe_y_registers(seq);
     fix_unsafe_set_unify(seq);
+    if (allocate_regs_) {
+	allocate_x_registers(seq);
+    }
     eliminate_interim_but_labels(seq);
+    peephole_opt_fuse(seq);
 }
 
 void wam_compiler::emit_cp(std::vector<common::int_cell> &labels, size_t index, size_t n, wam_interim_code &instrs)
@@ -1812,64 +2541,84 @@ std::vector<common::int_cell> wam_compiler::new_labels_dup(size_t n)
 }
 
 std::vector<size_t> wam_compiler::find_clauses_on_cat(
-      const managed_clauses &m_clauses, wam_compiler::first_arg_cat_t cat)
+      const managed_clauses &m_clauses,
+      const std::vector<size_t> &indices,
+      const wam_index_path &path,
+      wam_compiler::first_arg_cat_t cat)
 {
     std::vector<size_t> found;
-    size_t index = 0;
-    for (auto &m_clause : m_clauses) {
-        if (first_arg_cat(m_clause.clause()) == cat) {
+    for (auto index : indices) {
+        if (index_cat(index_key(m_clauses[index].clause(), path)) == cat) {
 	    found.push_back(index);
         }
-	index++;
     }
     return found;
 }
 
 void wam_compiler::emit_switch_on_term(const managed_clauses &subsection,
+	       const std::vector<size_t> &indices,
+	       const wam_index_path &path,
+	       const index_paths &rest,
+	       code_point on_var_cp,
 	       const std::vector<common::int_cell> &labels,
 	       wam_interim_code &instrs)
 {
-    auto on_var_cp = code_point(labels[0]);
-
-    auto on_con = find_clauses_on_cat(subsection, FIRST_CON);
+    auto on_con = find_clauses_on_cat(subsection, indices, path, FIRST_CON);
     auto on_con_cp = on_con.empty() ? code_point::fail() 
 	           : (on_con.size() == 1) ? code_point(labels[2*on_con[0]+1])
 	           : new_label();
 
-    auto on_lst = find_clauses_on_cat(subsection, FIRST_LST);
+    auto on_lst = find_clauses_on_cat(subsection, indices, path, FIRST_LST);
     auto on_lst_cp = on_lst.empty() ? code_point::fail() 
 	           : (on_lst.size() == 1) ? code_point(labels[2*on_lst[0]+1])
 	           : new_label();
 
-    auto on_str = find_clauses_on_cat(subsection, FIRST_STR);
+    auto on_str = find_clauses_on_cat(subsection, indices, path, FIRST_STR);
     auto on_str_cp = on_str.empty() ? code_point::fail() 
 	           : (on_str.size() == 1) ? code_point(labels[2*on_str[0]+1])
 	           : new_label();
 
-    instrs.push_back(wam_instruction<SWITCH_ON_TERM>(on_var_cp, on_con_cp, on_lst_cp, on_str_cp));
+    instrs.push_back(wam_instruction<SWITCH_ON_TERM>(on_var_cp, on_con_cp, on_lst_cp, on_str_cp, path));
 
-    emit_second_level_indexing(FIRST_CON,subsection,labels,on_con,on_con_cp,instrs);
-    emit_second_level_indexing(FIRST_LST,subsection,labels,on_lst,on_lst_cp,instrs);
-    emit_second_level_indexing(FIRST_STR,subsection,labels,on_str,on_str_cp,instrs);
+    emit_second_level_indexing(FIRST_CON,subsection,path,rest,labels,on_con,on_con_cp,instrs);
+    emit_second_level_indexing(FIRST_LST,subsection,path,rest,labels,on_lst,on_lst_cp,instrs);
+    emit_second_level_indexing(FIRST_STR,subsection,path,rest,labels,on_str,on_str_cp,instrs);
 }
 
 void wam_compiler::emit_third_level_indexing(
+	     const managed_clauses &subsection,
 	     const std::vector<size_t> &clause_indices,
+	     const index_paths &rest,
 	     const std::vector<common::int_cell> &labels,
 	     wam_interim_code &instrs)
 {
-    size_t n = clause_indices.size();
-    for (size_t i = 0; i < n; i++) {
-	auto ci = clause_indices[i];
-	if (i == 0) instrs.push_back(wam_instruction<TRY>(labels[2*ci+1]));
-	else if (i < n - 1) instrs.push_back(wam_instruction<RETRY>(labels[2*ci+1]));
-	else instrs.push_back(wam_instruction<TRUST>(labels[2*ci+1]));
+    // Can another argument tell these clauses apart? If so, switch on
+    // it and only try them all if it's unbound.
+    wam_index_path next;
+    if (choose_index(subsection, clause_indices, rest, true, next)) {
+	index_paths next_rest;
+	for (auto &path : rest) {
+	    if (path != next) next_rest.push_back(path);
+	}
+	auto on_var = new_label();
+	emit_switch_on_term(subsection, clause_indices, next, next_rest,
+			    code_point(on_var), labels, instrs);
+	instrs.push_back(wam_interim_instruction<INTERIM_LABEL>(on_var));
     }
+
+    auto on_unknown = new_label();
+    if (emit_guard(clause_terms(subsection), clause_indices, labels,
+		   code_point(on_unknown), instrs)) {
+	instrs.push_back(wam_interim_instruction<INTERIM_LABEL>(on_unknown));
+    }
+    emit_try_chain(clause_indices, labels, instrs);
 }
 
 void wam_compiler::emit_second_level_indexing(
 	      wam_compiler::first_arg_cat_t cat,
 	      const managed_clauses &subsection,
+	      const wam_index_path &path,
+	      const index_paths &rest,
 	      const std::vector<common::int_cell> &labels,
 	      const std::vector<size_t> &clause_indices,
 	      code_point cp,
@@ -1882,63 +2631,366 @@ void wam_compiler::emit_second_level_indexing(
     const common::int_cell &ic = static_cast<const common::int_cell &>(cp.term_code());
     instrs.push_back(wam_interim_instruction<INTERIM_LABEL>(ic));
 
-    auto *map = interp_.new_hash_map();
-    std::vector<term> for_third_arg;
+    wam_switch_table table;
+    std::unordered_set<term> seen;
+    std::vector<common::int_cell> for_third_lbl;
     std::vector<std::vector<size_t> > for_third_indices;
     for (auto clause_index : clause_indices) {
-	common::int_cell new_lbl(0);
 	auto &m_clause = subsection[clause_index];
 
-	auto arg0 = first_arg(m_clause.clause());
+	auto key = index_key(m_clause.clause(), path);
 
 	// Already managed?
-	if (map->count(arg0)) {
+	if (!seen.insert(key).second) {
 	    continue;
 	}
 
-	// Get all clauses with the same arg
-	std::vector<size_t> same_arg0;
+	// Get all clauses with the same key
+	std::vector<size_t> same_key;
 	for (auto ci : clause_indices) {
 	    auto &other_m_clause = subsection[ci];
-	    auto other_arg0 = first_arg(other_m_clause.clause());
-	    if (arg0 == other_arg0) {
-		same_arg0.push_back(ci);
+	    auto other_key = index_key(other_m_clause.clause(), path);
+	    if (key == other_key) {
+		same_key.push_back(ci);
 	    }
 	}
-	if (same_arg0.size() == 1) {
+	prune_after_cut(subsection, &path, same_key);
+	if (same_key.size() == 1) {
 	    // Unique? Then direct jump
-	    map->insert(std::make_pair(arg0, code_point(labels[2*same_arg0[0]+1])));
+	    table.push_back(std::make_pair(key, code_point(labels[2*same_key[0]+1])));
 	} else {
 	    // Multiple, so create third level indexing
-	    new_lbl = new_label();
-	    map->insert(std::make_pair(arg0, code_point(new_lbl)));
-	    for_third_arg.push_back(arg0);
-	    for_third_indices.push_back(same_arg0);
+	    auto new_lbl = new_label();
+	    table.push_back(std::make_pair(key, code_point(new_lbl)));
+	    for_third_lbl.push_back(new_lbl);
+	    for_third_indices.push_back(same_key);
 	}
     }
     switch (cat) {
-    case FIRST_CON: instrs.push_back(wam_instruction<SWITCH_ON_CONSTANT>(map)); break;
-    case FIRST_STR: instrs.push_back(wam_instruction<SWITCH_ON_STRUCTURE>(map)); break;
+    case FIRST_CON: instrs.push_back(wam_instruction<SWITCH_ON_CONSTANT>::create(table, path)); break;
+    case FIRST_STR: instrs.push_back(wam_instruction<SWITCH_ON_STRUCTURE>::create(table, path)); break;
     default: break;
     }
-    size_t n = for_third_arg.size();
+    size_t n = for_third_lbl.size();
+    for (size_t i = 0; i < n; i++) {
+	instrs.push_back(wam_interim_instruction<INTERIM_LABEL>(for_third_lbl[i]));
+	emit_third_level_indexing(subsection, for_third_indices[i], rest, labels, instrs);
+    }
+}
+
+bool wam_compiler::get_clause_guard(const term clause, clause_guard &g)
+{
+    static const std::unordered_map<common::con_cell, wam_guard_op> guards = {
+	{ common::con_cell("<", 2), GUARD_LT },
+	{ common::con_cell("=<", 2), GUARD_LE },
+	{ common::con_cell(">", 2), GUARD_GT },
+	{ common::con_cell(">=", 2), GUARD_GE },
+	{ common::con_cell("=:=", 2), GUARD_EQ },
+	{ common::con_cell("=\\=", 2), GUARD_NE },
+	{ common::con_cell("@<", 2), GUARD_TERM_LT },
+	{ common::con_cell("@=<", 2), GUARD_TERM_LE },
+	{ common::con_cell("@>", 2), GUARD_TERM_GT },
+	{ common::con_cell("@>=", 2), GUARD_TERM_GE },
+	{ common::con_cell("==", 2), GUARD_TERM_EQ },
+	{ common::con_cell("\\==", 2), GUARD_TERM_NE },
+	{ common::con_cell("var", 1), GUARD_VAR },
+	{ common::con_cell("nonvar", 1), GUARD_NONVAR } };
+
+    term goal;
+    for (auto g0 : for_all_goals(clause_body(clause))) {
+	goal = env_.deref(g0);
+	break;
+    }
+    if (goal.tag() != common::tag_t::STR) {
+	return false;
+    }
+    auto it = guards.find(env_.functor(goal));
+    if (it == guards.end()) {
+	return false;
+    }
+    g.op = it->second;
+    bool arith = g.op <= GUARD_NE;
+
+    // Variables must be head arguments, so the test can be made on
+    // the argument registers before the head is unified.
+    term head = clause_head(clause);
+    size_t arity = env_.functor(head).arity();
+    auto operand = [&](const term t0, wam_guard_operand &x) {
+	term t = env_.deref(t0);
+	switch (t.tag()) {
+	case common::tag_t::REF:
+	    for (size_t i = 0; i < arity; i++) {
+		if (env_.deref(env_.arg(head, i)) == t) {
+		    x = wam_guard_operand(static_cast<uint32_t>(i));
+		    return true;
+		}
+	    }
+	    return false;
+	case common::tag_t::INT:
+	    x = wam_guard_operand(t);
+	    return true;
+	case common::tag_t::CON:
+	    x = wam_guard_operand(t);
+	    return !arith && g.op < GUARD_VAR &&
+		   static_cast<const common::con_cell &>(t).arity() == 0;
+	default:
+	    return false;
+	}
+    };
+    if (!operand(env_.arg(goal, 0), g.x)) {
+	return false;
+    }
+    if (g.op >= GUARD_VAR) {
+	g.y = wam_guard_operand();
+	return g.x.is_reg();
+    }
+    return operand(env_.arg(goal, 1), g.y);
+}
+
+wam_compiler::clause_guard wam_compiler::complement(const clause_guard &g)
+{
+    static const wam_guard_op ops[] = {
+	GUARD_GE, GUARD_GT, GUARD_LE, GUARD_LT, GUARD_NE, GUARD_EQ,
+	GUARD_TERM_GE, GUARD_TERM_GT, GUARD_TERM_LE, GUARD_TERM_LT,
+	GUARD_TERM_NE, GUARD_TERM_EQ, GUARD_NONVAR, GUARD_VAR };
+    clause_guard c = g;
+    c.op = ops[g.op];
+    return c;
+}
+
+bool wam_compiler::same_guard(const clause_guard &g1, const clause_guard &g2)
+{
+    // The same test with the operands swapped
+    static const wam_guard_op swapped[] = {
+	GUARD_GT, GUARD_GE, GUARD_LT, GUARD_LE, GUARD_EQ, GUARD_NE,
+	GUARD_TERM_GT, GUARD_TERM_GE, GUARD_TERM_LT, GUARD_TERM_LE,
+	GUARD_TERM_EQ, GUARD_TERM_NE, GUARD_VAR, GUARD_NONVAR };
+    if (g1.op == g2.op && g1.x == g2.x && g1.y == g2.y) {
+	return true;
+    }
+    return g1.op < GUARD_VAR && swapped[g1.op] == g2.op &&
+	   g1.x == g2.y && g1.y == g2.x;
+}
+
+bool wam_compiler::head_always_matches(const term clause,
+				       const wam_index_path *key)
+{
+    // Distinct variables only, except for the argument the clause was
+    // selected on if that is a constant.
+    term head = clause_head(clause);
+    size_t arity = env_.functor(head).arity();
+    std::unordered_set<term> seen;
+    for (size_t i = 0; i < arity; i++) {
+	term a = env_.deref(env_.arg(head, i));
+	if (key != nullptr && key->sub == 0 && key->arg == i &&
+	    (a.tag() == common::tag_t::CON || a.tag() == common::tag_t::INT)) {
+	    continue;
+	}
+	if (a.tag() != common::tag_t::REF || !seen.insert(a).second) {
+	    return false;
+	}
+    }
+    return true;
+}
+
+bool wam_compiler::is_cut_goal(const term clause, size_t nth)
+{
+    static const common::con_cell cut_op("!", 0);
+    size_t i = 0;
+    for (auto goal : for_all_goals(clause_body(clause))) {
+	if (i++ == nth) {
+	    return env_.deref(goal) == cut_op;
+	}
+    }
+    return false;
+}
+
+void wam_compiler::prune_after_cut(const managed_clauses &subsection,
+				   const wam_index_path *key,
+				   std::vector<size_t> &clause_indices)
+{
+    size_t n = clause_indices.size();
+    for (size_t i = 0; i + 1 < n; i++) {
+	auto clause = subsection[clause_indices[i]].clause();
+	if (is_cut_goal(clause, 0) && head_always_matches(clause, key)) {
+	    clause_indices.resize(i + 1);
+	    if (i == 0) num_avoided_++;
+	    return;
+	}
+    }
+}
+
+bool wam_compiler::get_head_test(const term clause, clause_guard &g)
+{
+    term head = clause_head(clause);
+    size_t arity = env_.functor(head).arity();
+    for (size_t i = 0; i < arity; i++) {
+	term a = env_.deref(env_.arg(head, i));
+	if (a.tag() == common::tag_t::INT ||
+	    (a.tag() == common::tag_t::CON &&
+	     static_cast<const common::con_cell &>(a).arity() == 0)) {
+	    g.op = GUARD_TERM_EQ;
+	    g.x = wam_guard_operand(static_cast<uint32_t>(i));
+	    g.y = wam_guard_operand(a);
+	    return true;
+	}
+    }
+    return false;
+}
+
+void wam_compiler::classify_clause(const term clause,
+				   const clause_guard &g, bool head_test,
+				   bool &on_true, bool &on_false,
+				   bool &ends_true, bool &ends_false)
+{
+    on_true = on_false = true;
+    ends_true = ends_false = false;
+    if (clause == term()) {
+	return;
+    }
+    bool cut0 = is_cut_goal(clause, 0);
+    if (head_test) {
+	wam_index_path key(g.x.reg);
+	term a = env_.deref(env_.arg(clause_head(clause), g.x.reg));
+	if (a == g.y.con) {
+	    on_false = false;
+	    ends_true = cut0 && head_always_matches(clause, &key);
+	} else if (a.tag() == common::tag_t::REF) {
+	    ends_true = ends_false = cut0 && head_always_matches(clause, nullptr);
+	} else {
+	    on_true = false;
+	}
+	return;
+    }
+    clause_guard gi;
+    bool has_guard = get_clause_guard(clause, gi);
+    bool is_g = has_guard && same_guard(gi, g);
+    bool is_not_g = has_guard && same_guard(gi, complement(g));
+    on_true = !is_not_g;
+    on_false = !is_g;
+    if (head_always_matches(clause, nullptr)) {
+	bool cut1 = is_cut_goal(clause, 1);
+	ends_true = cut0 || (is_g && cut1);
+	ends_false = cut0 || (is_not_g && cut1);
+    }
+}
+
+std::vector<common::term> wam_compiler::clause_terms(
+	      const managed_clauses &clauses)
+{
+    std::vector<term> terms;
+    terms.reserve(clauses.size());
+    for (auto &m_clause : clauses) {
+	terms.push_back(m_clause.clause());
+    }
+    return terms;
+}
+
+bool wam_compiler::emit_guard(const std::vector<term> &clauses,
+			      const std::vector<size_t> &indices,
+			      const std::vector<common::int_cell> &labels,
+			      code_point on_unknown,
+			      wam_interim_code &instrs)
+{
+    if (indices.size() < 2 || clauses[indices[0]] == term()) {
+	return false;
+    }
+    // Test on a constant in the head of the first clause, or else on
+    // its guard.
+    clause_guard g;
+    bool head_test = get_head_test(clauses[indices[0]], g);
+    if (!head_test && !get_clause_guard(clauses[indices[0]], g)) {
+	return false;
+    }
+
+    // The clauses left if the test succeeds and if it fails
+    std::vector<size_t> on_true, on_false;
+    bool true_done = false, false_done = false;
+    for (auto ci : indices) {
+	bool in_t, in_f, ends_t, ends_f;
+	classify_clause(clauses[ci], g, head_test, in_t, in_f, ends_t, ends_f);
+	if (!true_done && in_t) {
+	    on_true.push_back(ci);
+	    true_done = ends_t;
+	}
+	if (!false_done && in_f) {
+	    on_false.push_back(ci);
+	    false_done = ends_f;
+	}
+    }
+    if (on_true.size() > 1 && on_false.size() > 1) {
+	return false;
+    }
+
+    std::vector<std::pair<common::int_cell, std::vector<size_t> *> > chains;
+    auto target = [&](std::vector<size_t> &cis) {
+	if (cis.empty()) {
+	    num_avoided_++;
+	    return code_point::fail();
+	} else if (cis.size() == 1) {
+	    num_avoided_++;
+	    return code_point(labels[2*cis[0]+1]);
+	} else {
+	    auto lbl = new_label();
+	    chains.push_back(std::make_pair(lbl, &cis));
+	    return code_point(lbl);
+	}
+    };
+    auto pt = target(on_true);
+    auto pf = target(on_false);
+    instrs.push_back(wam_instruction<GUARD>(g.op, g.x, g.y, pt, pf, on_unknown));
+    for (auto &chain : chains) {
+	instrs.push_back(wam_interim_instruction<INTERIM_LABEL>(chain.first));
+	emit_try_chain(*chain.second, labels, instrs);
+    }
+    return true;
+}
+
+void wam_compiler::emit_try_chain(const std::vector<size_t> &clause_indices,
+				  const std::vector<common::int_cell> &labels,
+				  wam_interim_code &instrs)
+{
+    size_t n = clause_indices.size();
     for (size_t i = 0; i < n; i++) {
-	auto arg = for_third_arg[i];
-	auto &clause_indices = for_third_indices[i];
-	auto &cp = (*map)[arg];
-	const common::int_cell &lbl = static_cast<const common::int_cell &>(cp.term_code());
-	instrs.push_back(wam_interim_instruction<INTERIM_LABEL>(lbl));
-	emit_third_level_indexing(clause_indices, labels, instrs);
+	auto ci = clause_indices[i];
+	if (i == 0) instrs.push_back(wam_instruction<TRY>(labels[2*ci+1]));
+	else if (i < n - 1) instrs.push_back(wam_instruction<RETRY>(labels[2*ci+1]));
+	else instrs.push_back(wam_instruction<TRUST>(labels[2*ci+1]));
     }
 }
 
 void wam_compiler::compile_subsection(const managed_clauses &subsection,
+				      const wam_index_path *path,
 				      wam_interim_code &instrs)
 {
     auto n = subsection.size();
     if (n > 1) {
         std::vector<common::int_cell> labels = new_labels(2*n);
-	emit_switch_on_term(subsection, labels, instrs);
+	std::vector<size_t> all(n);
+	for (size_t i = 0; i < n; i++) all[i] = i;
+
+	// Select by a guard before resorting to the choice point
+	code_point on_var(labels[0]);
+	auto on_guard = new_label();
+	wam_interim_code guard_instrs(interp_);
+	bool guarded = emit_guard(clause_terms(subsection), all, labels, on_var,
+				  guard_instrs);
+	if (guarded) {
+	    on_var = code_point(on_guard);
+	}
+
+	if (path != nullptr) {
+	    index_paths rest;
+	    for (auto &p : index_paths_) {
+		if (p != *path) rest.push_back(p);
+	    }
+	    emit_switch_on_term(subsection, all, *path, rest,
+				on_var, labels, instrs);
+	}
+	if (guarded) {
+	    instrs.push_back(wam_interim_instruction<INTERIM_LABEL>(on_guard));
+	    instrs.append(guard_instrs);
+	}
 	for (size_t i = 0; i < n; i++) {
 	    emit_cp(labels, i, n, instrs);
 	    auto &m_clause = subsection[i];
@@ -1962,17 +3014,184 @@ void wam_compiler::compile_predicate(const qname &qn, wam_interim_code &instrs)
 	return;
     }
 
-    auto sections = partition_clauses_nonvar(clauses);
+    num_avoided_ = 0;
+    neck_ = clauses.size() > 1;
+    index_paths_ = index_candidates(qn, clauses);
+    std::vector<size_t> all(clauses.size());
+    for (size_t i = 0; i < all.size(); i++) all[i] = i;
+    wam_index_path path;
+    bool indexed = choose_index(clauses, all, index_paths_, false, path);
+    if (!indexed && !index_ordered_ && qn.second.arity() > 0) {
+	// Nothing better; the first argument still separates the types
+	path = wam_index_path();
+	indexed = true;
+    }
+
+    if (!indexed) {
+	compile_subsection(clauses, nullptr, instrs);
+	neck_ = false;
+	return;
+    }
+
+    auto sections = partition_clauses_nonvar(clauses, path);
     auto n = sections.size();
     if (n > 1) {
-        std::vector<common::int_cell> labels = new_labels_dup(n);
+        std::vector<common::int_cell> labels = new_labels(2*n);
+
+	// A section of a single clause can be selected by a guard
+	std::vector<term> units(n);
+	std::vector<size_t> all(n);
+	for (size_t i = 0; i < n; i++) {
+	    all[i] = i;
+	    if (sections[i].size() == 1) units[i] = sections[i][0].clause();
+	}
+	emit_guard(units, all, labels, code_point(labels[0]), instrs);
+
 	for (size_t i = 0; i < n; i++) {
 	    emit_cp(labels, i, n, instrs);
-	    compile_subsection(sections[i], instrs);
+	    compile_subsection(sections[i], &path, instrs);
 	}
     } else {
-        compile_subsection(sections[0], instrs);
+        compile_subsection(sections[0], &path, instrs);
+    }
+    neck_ = false;
+}
+
+term wam_compiler::index_key(const term clause, const wam_index_path &path)
+{
+    term arg = env_.deref(env_.arg(clause_head(clause), path.arg));
+    if (path.sub > 0) {
+	arg = env_.deref(env_.arg(arg, path.sub - 1));
+    }
+    switch (arg.tag()) {
+    case common::tag_t::STR: return env_.functor(arg);
+    default: return arg;
+    }
+}
+
+bool wam_compiler::has_index_path(const managed_clauses &clauses,
+				  const std::vector<size_t> &indices,
+				  const wam_index_path &path)
+{
+    if (path.sub == 0) {
+	return true;
+    }
+    for (auto i : indices) {
+	term arg = env_.deref(env_.arg(clause_head(clauses[i].clause()),
+				       path.arg));
+	if (arg.tag() != common::tag_t::STR ||
+	    env_.functor(arg) != path.functor) {
+	    return false;
+	}
+    }
+    return true;
+}
+
+wam_compiler::index_paths wam_compiler::index_candidates(
+	      const qname &qn, const managed_clauses &clauses)
+{
+    index_paths paths;
+    size_t arity = qn.second.arity();
+
+    if (auto *spec = interp_.get_index_spec(qn)) {
+	index_ordered_ = true;
+	static const common::int_cell yes(1);
+	for (size_t i = 0; i < arity; i++) {
+	    term a = env_.deref(env_.arg(*spec, i));
+	    if (a == yes) {
+		paths.push_back(wam_index_path(i));
+	    } else if (a.tag() == common::tag_t::STR) {
+		auto f = env_.functor(a);
+		for (size_t j = 0; j < f.arity(); j++) {
+		    if (env_.deref(env_.arg(a, j)) == yes) {
+			paths.push_back(wam_index_path(i, f, j + 1));
+		    }
+		}
+	    }
+	}
+	return paths;
+    }
+
+    index_ordered_ = false;
+    for (size_t i = 0; i < arity; i++) {
+	paths.push_back(wam_index_path(i));
+    }
+
+    // One level into arguments that always hold the same structure
+    std::vector<size_t> all(clauses.size());
+    for (size_t i = 0; i < all.size(); i++) all[i] = i;
+    for (size_t i = 0; i < arity; i++) {
+	term arg = env_.deref(env_.arg(clause_head(clauses[0].clause()), i));
+	if (arg.tag() != common::tag_t::STR) {
+	    continue;
+	}
+	auto f = env_.functor(arg);
+	if (!has_index_path(clauses, all, wam_index_path(i, f, 1))) {
+	    continue;
+	}
+	for (size_t j = 0; j < f.arity(); j++) {
+	    paths.push_back(wam_index_path(i, f, j + 1));
+	}
     }
+    return paths;
+}
+
+//
+// The expected number of clauses to try for a call that binds 'path'
+// (assuming all keys are equally likely), or -1 if indexing on it
+// doesn't tell any clauses apart (or if 'nonvar_only' and there are
+// variables.)
+//
+double wam_compiler::index_selectivity(const managed_clauses &clauses,
+				       const std::vector<size_t> &indices,
+				       const wam_index_path &path,
+				       bool nonvar_only)
+{
+    std::unordered_set<term> keys;
+    size_t num_vars = 0;
+    for (auto i : indices) {
+	auto key = index_key(clauses[i].clause(), path);
+	if (key.tag() == common::tag_t::REF) {
+	    num_vars++;
+	} else {
+	    keys.insert(key);
+	}
+    }
+    if (keys.size() < 2 || (nonvar_only && num_vars > 0)) {
+	return -1;
+    }
+    size_t n = indices.size();
+    return static_cast<double>(n - num_vars) / keys.size() + num_vars;
+}
+
+bool wam_compiler::choose_index(const managed_clauses &clauses,
+				const std::vector<size_t> &indices,
+				const index_paths &paths,
+				bool nonvar_only,
+				wam_index_path &chosen)
+{
+    double best = -1;
+    for (auto &path : paths) {
+	if (!has_index_path(clauses, indices, path)) {
+	    continue;
+	}
+	double s = index_selectivity(clauses, indices, path, nonvar_only);
+	if (s < 0 || s >= indices.size()) {
+	    continue;
+	}
+	if (index_ordered_) {
+	    chosen = path;
+	    return true;
+	}
+	// Arguments that come first are more likely to be bound (they
+	// are the keys by convention), so a later one must be a lot
+	// better to be preferred.
+	if (best < 0 || 2*s <= best) {
+	    best = s;
+	    chosen = path;
+	}
+    }
+    return best >= 0;
 }
 
 term wam_compiler::clause_head(const term clause)
@@ -2054,8 +3273,11 @@ term wam_compiler::first_arg(const term clause)
 
 wam_compiler::first_arg_cat_t wam_compiler::first_arg_cat(const term cl)
 {
-    term arg = first_arg(cl);
+    return index_cat(first_arg(cl));
+}
 
+wam_compiler::first_arg_cat_t wam_compiler::index_cat(const term arg)
+{
     if (interp_.is_dotted_pair(arg)) {
 	return FIRST_LST;
     }
@@ -2089,13 +3311,19 @@ bool wam_compiler::first_arg_is_str(const term clause)
 }
 
 std::vector<managed_clauses> wam_compiler::partition_clauses_nonvar(const managed_clauses &clauses)
+{
+    return partition_clauses_nonvar(clauses, wam_index_path());
+}
+
+std::vector<managed_clauses> wam_compiler::partition_clauses_nonvar(const managed_clauses &clauses, const wam_index_path &path)
 {
     return partition_clauses(clauses,
        [&] (const managed_clause &c1, const managed_clause &c2)
 	     { 
-		 term c1_term = c1.clause();
-		 term c2_term = c2.clause();
-	       return first_arg_is_var(c1_term) || first_arg_is_var(c2_term);
+		 term c1_key = index_key(c1.clause(), path);
+		 term c2_key = index_key(c2.clause(), path);
+	       return c1_key.tag() == common::tag_t::REF ||
+		      c2_key.tag() == common::tag_t::REF;
 	     });
 }
 
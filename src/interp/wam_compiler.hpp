@@ -89,18 +89,10 @@ public:
     static inline void init() {
 	static bool init = [] {
 	    register_printer(&invoke, &print);
-	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	for (auto &p : *from_) {
-	    update_ptr(p, old_base, new_base);
-	}
-    }
-
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
         assert("this instruction should never be executed." == nullptr);
@@ -120,12 +112,6 @@ public:
 	out << "]";
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_interim_instruction<INTERIM_MERGE> *>(self);
-	self1->update(old_base, new_base);
-    }
-
     const std::vector<code_point> & sources() const {
 	return *from_;
     }
@@ -140,6 +126,8 @@ public:
 
     wam_instruction_base * new_instruction(const wam_instruction_base &instr);
     wam_instruction_base * push_back(const wam_instruction_base &instr);
+    // Takes ownership (used for instructions with inline data.)
+    void push_back(wam_instruction_base *instr);
     void append(const wam_interim_code &instrs);
 
     void print(std::ostream &out) const;
@@ -178,6 +166,11 @@ public:
         return std::forward_list<wam_instruction_base *>::begin();
     }
 
+    std::forward_list<wam_instruction_base *>::iterator before_begin()
+    {
+        return std::forward_list<wam_instruction_base *>::before_begin();
+    }
+
     std::forward_list<wam_instruction_base *>::const_iterator before_begin() const
     {
         return std::forward_list<wam_instruction_base *>::before_begin();
@@ -260,8 +253,6 @@ public:
     }
 
 private:
-    void push_back(wam_instruction_base *instr);
-
     wam_interpreter &interp_;
     std::forward_list<wam_instruction_base *>::iterator end_;
     size_t size_;
@@ -310,7 +301,7 @@ public:
     typedef common::term term;
 
     wam_compiler(wam_interpreter &interp)
-        : interp_(interp), env_(interp), regs_a_(A_REG), regs_x_(X_REG), regs_y_(Y_REG), label_count_(1), goal_count_(0), level_count_(0), current_module_(common::con_cell("[]",0)) { }
+        : interp_(interp), env_(interp), regs_a_(A_REG), regs_x_(X_REG), regs_y_(Y_REG), label_count_(1), goal_count_(0), level_count_(0), current_module_(common::con_cell("[]",0)), index_ordered_(false), num_avoided_(0), neck_(false), allocate_regs_(true) { }
 
     ~wam_compiler();
 
@@ -336,12 +327,24 @@ public:
 
     void compile_predicate(const qname &qn, wam_interim_code &instrs);
 
+    // Places where the last compiled predicate selects a clause
+    // without a choice point thanks to guards and cuts.
+    inline size_t num_choice_points_avoided() const { return num_avoided_; }
+    void compile_clause(const term clause, wam_interim_code &seq);
+    void compile_clause(const managed_clause &m_clause, wam_interim_code &seq);
+
     inline common::con_cell current_module()
     { return current_module_; }
 
     inline void set_current_module(common::con_cell module) 
     { current_module_ = module; }
 
+    // Liveness based register allocation (see allocate_x_registers
+    // and remap_y_registers.) Without it every temporary keeps an X
+    // register of its own.
+    inline void set_register_allocation(bool on)
+    { allocate_regs_ = on; }
+
 private:
     friend class test_wam_compiler;
 
@@ -391,6 +394,9 @@ private:
     static const size_t MAX_VARS = 256;
     typedef std::bitset<MAX_VARS> varset_t;
 
+    // What builtin is/2 charges for unifying its result
+    static const uint64_t IS_2_COST = 2;
+
     friend inline std::ostream & operator << (std::ostream &out, reg &r)
     {
         switch (r.type) {
@@ -455,12 +461,53 @@ private:
 			 common::con_cell f,
 			 bool first_goal,
 			 wam_interim_code &seq);
+    bool compile_inline_builtin(builtin_fn fn, wam_interim_code &seq);
+
+    bool is_arith_expr(const term t, size_t ai);
+    void compile_arith_expr(const term t, size_t ai, wam_interim_code &seq);
+    bool compile_arith(common::con_cell module, common::con_cell f,
+		       const term goal, wam_interim_code &seq);
 
 
     void compile_query_or_program(term t, compile_type c,
 			          wam_interim_code &seq);
     bool is_boundary_instruction(wam_instruction_base *i);
     void remap_x_registers(wam_interim_code &seq);
+
+    //
+    // Register allocation. The registers an instruction reads and
+    // writes; an instruction we know nothing about reads and
+    // writes all argument registers.
+    //
+    struct reg_effect {
+	std::vector<size_t> x_use, x_def, a_use, a_def;
+	bool all_a_use, all_a_def;
+    };
+    typedef std::vector<std::vector<bool> > liveness_t;
+
+    void get_reg_effect(wam_instruction_base *instr, reg_effect &eff);
+    void get_reg_effects(const std::vector<wam_instruction_base *> &instrs,
+			 std::vector<reg_effect> &effects,
+			 size_t &num_x, size_t &num_a);
+    void compute_liveness(wam_interim_code &seq,
+			  std::vector<wam_instruction_base *> &instrs,
+			  std::unordered_map<common::int_cell, size_t> &labels,
+			  const std::vector<reg_effect> &effects,
+			  size_t num_x, size_t num_a, liveness_t &live_out);
+    static bool in_fused_get_list(
+	    const std::vector<wam_instruction_base *> &instrs, size_t i);
+    bool can_coalesce(size_t xn, size_t ai,
+		      const std::vector<wam_instruction_base *> &instrs,
+		      const std::vector<reg_effect> &effects,
+		      const liveness_t &live_out, size_t num_x, size_t neck);
+    void coalesce(size_t xn, size_t ai,
+		  const std::vector<wam_instruction_base *> &instrs,
+		  const std::vector<reg_effect> &effects,
+		  std::unordered_set<wam_instruction_base *> &dead);
+    void erase_instructions(wam_interim_code &seq,
+			const std::unordered_set<wam_instruction_base *> &dead);
+    void color_x_registers(wam_interim_code &seq);
+    void allocate_x_registers(wam_interim_code &seq);
     void remap_y_registers(wam_interim_code &seq);
 
     void find_x_to_y_registers(wam_interim_code &seq,
@@ -488,19 +535,19 @@ private:
     void compile_goal(const term goal, bool first_goal, wam_interim_code &seq);
     void peephole_opt_execute(wam_interim_code &seq);
     void peephole_opt_void(wam_interim_code &instr);
+    void peephole_opt_fuse(wam_interim_code &seq);
     void reset_clause_temps();
     bool is_relevant_varset_op(const term t);
     void compute_var_indices(const term t);
     void compute_varsets(const term t);
     void find_vars(const term t, varset_t &varset);
     size_t new_level();
-    void compile_clause(const term clause, wam_interim_code &seq);
-    void compile_clause(const managed_clause &m_clause, wam_interim_code &seq);
     std::vector<common::int_cell> new_labels(size_t n);
     std::vector<common::int_cell> new_labels_dup(size_t n);
     void emit_cp(std::vector<common::int_cell> &labels, size_t index, size_t n,
 		 wam_interim_code &instrs);
     void compile_subsection(const managed_clauses &subsection,
+			    const wam_index_path *path,
 			    wam_interim_code &instrs);
 
     common::int_cell new_label();
@@ -541,6 +588,7 @@ private:
         FIRST_VAR, FIRST_CON, FIRST_LST, FIRST_STR
     };
     first_arg_cat_t first_arg_cat(const term clause);
+    first_arg_cat_t index_cat(const term key);
 
     term first_arg(const term clause);
     common::con_cell first_arg_functor(const term clause);
@@ -550,24 +598,98 @@ private:
 
     std::vector<managed_clauses> partition_clauses(const managed_clauses &clauses, std::function<bool (const managed_clause &c1, const managed_clause &t2)> pred);
     std::vector<managed_clauses> partition_clauses_nonvar(const managed_clauses &clauses);
+    std::vector<managed_clauses> partition_clauses_nonvar(const managed_clauses &clauses, const wam_index_path &path);
     std::vector<managed_clauses> partition_clauses_first_arg(const managed_clauses &clauses);
+
+    //
+    // Indexing. A predicate is indexed on the argument (or argument
+    // of a structure argument) that is expected to leave the fewest
+    // clauses to try. Groups of clauses that are still left with the
+    // same key are indexed on the next best argument, and so on,
+    // which makes a decision tree over several arguments. An index
+    // directive fixes the arguments and their order instead.
+    //
+    typedef std::vector<wam_index_path> index_paths;
+
+    term index_key(const term clause, const wam_index_path &path);
+    bool has_index_path(const managed_clauses &clauses,
+			const std::vector<size_t> &indices,
+			const wam_index_path &path);
+    index_paths index_candidates(const qname &qn,
+				 const managed_clauses &clauses);
+    double index_selectivity(const managed_clauses &clauses,
+			     const std::vector<size_t> &indices,
+			     const wam_index_path &path,
+			     bool nonvar_only);
+    bool choose_index(const managed_clauses &clauses,
+		      const std::vector<size_t> &indices,
+		      const index_paths &paths,
+		      bool nonvar_only,
+		      wam_index_path &chosen);
+
     std::vector<size_t> find_clauses_on_cat(const managed_clauses &clauses,
+					    const std::vector<size_t> &indices,
+					    const wam_index_path &path,
 					    first_arg_cat_t cat);
     void emit_switch_on_term(const managed_clauses &subsection,
+			     const std::vector<size_t> &indices,
+			     const wam_index_path &path,
+			     const index_paths &rest,
+			     code_point on_var_cp,
 			     const std::vector<common::int_cell> &labels,
 			     wam_interim_code &instrs);
     void emit_second_level_indexing(
 	      wam_compiler::first_arg_cat_t cat,
 	      const managed_clauses &subsection,
+	      const wam_index_path &path,
+	      const index_paths &rest,
 	      const std::vector<common::int_cell> &labels,
 	      const std::vector<size_t> &clause_indices,
 	      code_point cp,
 	      wam_interim_code &instrs);
     void emit_third_level_indexing(
+	     const managed_clauses &subsection,
 	     const std::vector<size_t> &clause_indices,
+	     const index_paths &rest,
 	     const std::vector<common::int_cell> &labels,
 	     wam_interim_code &instrs);
 
+    //
+    // Determinism. A clause that starts with a guard (a test that
+    // the guard instruction can decide on the argument registers)
+    // excludes the clauses starting with the opposite test, and a
+    // clause whose head always matches ends the alternatives at a
+    // cut. A set of clauses that such tests split into single
+    // clauses is entered through a guard instead of a choice point.
+    //
+    struct clause_guard {
+	wam_guard_op op;
+	wam_guard_operand x;
+	wam_guard_operand y;
+    };
+
+    bool get_clause_guard(const term clause, clause_guard &g);
+    bool get_head_test(const term clause, clause_guard &g);
+    static clause_guard complement(const clause_guard &g);
+    static bool same_guard(const clause_guard &g1, const clause_guard &g2);
+    bool head_always_matches(const term clause, const wam_index_path *key);
+    bool is_cut_goal(const term clause, size_t nth);
+    void classify_clause(const term clause, const clause_guard &g,
+			 bool head_test, bool &on_true, bool &on_false,
+			 bool &ends_true, bool &ends_false);
+    void prune_after_cut(const managed_clauses &subsection,
+			 const wam_index_path *key,
+			 std::vector<size_t> &clause_indices);
+    static std::vector<term> clause_terms(const managed_clauses &clauses);
+    bool emit_guard(const std::vector<term> &clauses,
+		    const std::vector<size_t> &indices,
+		    const std::vector<common::int_cell> &labels,
+		    code_point on_unknown,
+		    wam_interim_code &instrs);
+    void emit_try_chain(const std::vector<size_t> &clause_indices,
+			const std::vector<common::int_cell> &labels,
+			wam_interim_code &instrs);
+
     void print_partition(std::ostream &out,
 			 const std::vector<managed_clauses> &partition);
 
@@ -612,6 +734,12 @@ private:
     std::vector<std::vector<code_point> *> merges_;
 
     common::con_cell current_module_;
+
+    index_paths index_paths_;  // Candidates for the current predicate
+    bool index_ordered_;       // Take them in order (index directive)
+    size_t num_avoided_;       // Choice points avoided (current predicate)
+    bool neck_;                // Mark the end of heads (shallow backtracking)
+    bool allocate_regs_;       // Liveness based register allocation
 };
 
 template<> inline bool wam_compiler::has_reg<wam_compiler::A_REG>(common::ref_cell ref) { return regs_a_.contains(ref); }
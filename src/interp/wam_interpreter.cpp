@@ -1,27 +1,124 @@
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
 #include "wam_interpreter.hpp"
 
 namespace prologcoin { namespace interp {
 
 std::unordered_map<wam_instruction_base::fn_type, wam_instruction_base::print_fn_type> wam_instruction_base::print_fns_;
-std::unordered_map<wam_instruction_base::fn_type, wam_instruction_base::updater_fn_type> wam_instruction_base::updater_fns_;
+
+void wam_instruction_base::print_path(std::ostream &out,
+				      wam_interpreter &interp,
+				      const wam_index_path &path)
+{
+    if (path.sub > 0) {
+	out << "arg(" << path.sub << ", a" << path.arg << ") of "
+	    << interp.to_string(path.functor) << "/"
+	    << path.functor.arity() << ", ";
+    } else if (path.arg > 0) {
+	out << "a" << path.arg << ", ";
+    }
+}
+
+void wam_instruction<GUARD>::print(std::ostream &out,
+				   wam_interpreter &interp,
+				   wam_instruction_base *self)
+{
+    static const char *ops[] = { "<", "=<", ">", ">=", "=:=", "=\\=",
+				 "@<", "@=<", "@>", "@>=", "==", "\\==",
+				 "var", "nonvar" };
+    auto self1 = reinterpret_cast<wam_instruction<GUARD> *>(self);
+    auto operand = [&](const wam_guard_operand &x) {
+	if (x.is_reg()) {
+	    out << "a" << x.reg;
+	} else {
+	    out << interp.to_string(x.con);
+	}
+    };
+    auto target = [&](const code_point &cp) {
+	if (cp.is_fail()) {
+	    out << "fail";
+	} else {
+	    out << interp.to_string(cp);
+	}
+    };
+    out << "guard ";
+    if (self1->op() >= GUARD_VAR) {
+	out << ops[self1->op()] << " ";
+	operand(self1->x());
+    } else {
+	operand(self1->x());
+	out << " " << ops[self1->op()] << " ";
+	operand(self1->y());
+    }
+    out << ", T->"; target(self1->pt());
+    out << ", F->"; target(self1->pf());
+    out << ", U->"; target(self1->pu());
+}
+
+const size_t wam_code::SLOT_BITS;
+const size_t wam_code::SLOT_WORDS;
+const size_t wam_code::DEFAULT_SEGMENT_WORDS;
+
+wam_code::~wam_code()
+{
+    for (auto &seg : segments_) {
+	delete [] seg.second.code;
+    }
+}
+
+void wam_code::new_segment(size_t capacity)
+{
+    size_t num_slots = (capacity + SLOT_WORDS - 1) / SLOT_WORDS;
+    capacity = num_slots * SLOT_WORDS;
+
+    // Reuse the address range of a reclaimed segment if there's one
+    size_t first_slot;
+    auto it = free_slots_.lower_bound(num_slots);
+    if (it != free_slots_.end()) {
+	first_slot = it->second;
+	size_t n = it->first;
+	free_slots_.erase(it);
+	if (n > num_slots) {
+	    free_slots_.insert(std::make_pair(n - num_slots,
+					      first_slot + num_slots));
+	}
+    } else {
+	first_slot = slots_.size();
+	slots_.resize(first_slot + num_slots, nullptr);
+    }
+
+    segment seg;
+    seg.code = new code_t[capacity];
+    seg.offset = first_slot << SLOT_BITS;
+    seg.size = 0;
+    seg.capacity = capacity;
+    seg.num_users = 0;
+    seg.retired = false;
+    for (size_t i = 0; i < num_slots; i++) {
+	slots_[first_slot + i] = seg.code + i * SLOT_WORDS;
+    }
+    segment_by_ptr_[seg.code] = seg.offset;
+    current_ = &(segments_[seg.offset] = seg);
+}
 
 size_t wam_code::add(const wam_instruction_base &i)
 {
-    size_t offset = next_offset();
     size_t sz = i.size();
-    code_t *old_base = instrs_;
     code_t *data = ensure_fit(sz);
-    code_t *new_base = instrs_;
+    size_t offset = to_code_addr(data);
     auto p = reinterpret_cast<wam_instruction_base *>(data);
     memcpy(p, &i, sz*sizeof(code_t));
 
-    if (old_base != new_base) {
-	p->update(old_base, new_base);
-    }
-
     if (i.type() == EXECUTE || i.type() == CALL) {
 	auto *cp_instr = reinterpret_cast<wam_instruction_code_point *>(p);
 	auto module = cp_instr->cp().module();
+	// Calls without a module are to the user module (see
+	// bind_code_point.)
+	static const common::con_cell user_module("[]", 0);
+	if (module == common::con_cell()) {
+	    module = user_module;
+	}
 	auto f = cp_instr->cp().name();
 	calls_[std::make_pair(module,f)].push_back(offset);
     }
@@ -29,68 +126,481 @@ size_t wam_code::add(const wam_instruction_base &i)
     return sz;
 }
 
+size_t wam_code::code_size() const
+{
+    size_t n = 0;
+    for (auto &seg : segments_) {
+	n += seg.second.size;
+    }
+    return n;
+}
+
+void wam_code::get_retired_segments(std::vector<const segment *> &retired) const
+{
+    for (auto &seg : segments_) {
+	if (seg.second.retired) {
+	    retired.push_back(&seg.second);
+	}
+    }
+}
+
+void wam_code::free_segment(size_t offset)
+{
+    auto it = segments_.find(offset);
+    assert(it != segments_.end() && it->second.retired);
+    auto &seg = it->second;
+    size_t end = seg.offset + seg.capacity;
+
+    // Forget about the calls made from this code
+    for (auto &calls : calls_) {
+	auto &offsets = calls.second;
+	offsets.erase(std::remove_if(offsets.begin(), offsets.end(),
+				     [&](size_t off) {
+					 return off >= seg.offset && off < end;
+				     }), offsets.end());
+    }
+
+    size_t first_slot = seg.offset >> SLOT_BITS;
+    size_t num_slots = seg.capacity >> SLOT_BITS;
+    for (size_t i = 0; i < num_slots; i++) {
+	slots_[first_slot + i] = nullptr;
+    }
+    free_slots_.insert(std::make_pair(num_slots, first_slot));
+
+    segment_by_ptr_.erase(seg.code);
+    delete [] seg.code;
+    if (current_ == &seg) {
+	current_ = nullptr;
+    }
+    segments_.erase(it);
+}
+
 void wam_code::print_code(std::ostream &out)
 {
     static const common::con_cell default_module("[]",0);
-    for (size_t i = 0; i < instrs_size_;) {
-	if (predicate_rev_map_.count(i)) {
-	    auto name = predicate_rev_map_[i];
-	    if (name.first == default_module) {
-		out << interp_.to_string(name.second);
-	    } else {
-		out << interp_.to_string(name.first) << ":"
-		    << interp_.to_string(name.second);
+    for (auto &seg : segments_) {
+	size_t start = seg.second.offset;
+	for (size_t i = start; i < start + seg.second.size;) {
+	    if (predicate_rev_map_.count(i)) {
+		auto name = predicate_rev_map_[i];
+		if (name.first == default_module) {
+		    out << interp_.to_string(name.second);
+		} else {
+		    out << interp_.to_string(name.first) << ":"
+			<< interp_.to_string(name.second);
+		}
+		out << "/" << name.second.arity() << ":" << std::endl;
 	    }
-	    out << "/" << name.second.arity() << ":" << std::endl;
-	}
 
-	wam_instruction_base *instr
-	  = reinterpret_cast<wam_instruction_base *>(&instrs_[i]);
-	out << "[" << std::setw(5) << i << "]: ";
-	instr->print(out, interp_);
-	out << std::endl;
+	    wam_instruction_base *instr = to_code(i);
+	    out << "[" << std::setw(5) << i << "]: ";
+	    instr->print(out, interp_);
+	    out << std::endl;
 	
-	i += instr->size();
+	    i += instr->size();
+	}
     }
 }
 
-wam_interpreter::wam_interpreter() : wam_code(*this)
+wam_interpreter::wam_interpreter()
+    : wam_code(*this), native_(native_steps_, &native_resume)
 {
     fail_ = false;
+    shallow_ = false;
     mode_ = READ;
     set_num_y_fn( &num_y );
     register_s_ = 0;
     memset(register_xn_, 0, sizeof(register_xn_));
+    opcode_profiling_ = false;
 }
 
-wam_interpreter::~wam_interpreter()
+// All instruction types in the order of wam_instruction_type.
+#define WAM_INSTRUCTION_TYPES(X) \
+    X(PUT_VARIABLE_X) X(PUT_VARIABLE_Y) X(PUT_VALUE_X) X(PUT_VALUE_Y) \
+    X(PUT_UNSAFE_VALUE_Y) X(PUT_STRUCTURE_A) X(PUT_STRUCTURE_X) \
+    X(PUT_STRUCTURE_Y) X(PUT_LIST_A) X(PUT_LIST_X) X(PUT_LIST_Y) \
+    X(PUT_CONSTANT) \
+    X(GET_VARIABLE_X) X(GET_VARIABLE_Y) X(GET_VALUE_X) X(GET_VALUE_Y) \
+    X(GET_STRUCTURE_A) X(GET_STRUCTURE_X) X(GET_STRUCTURE_Y) \
+    X(GET_LIST_A) X(GET_LIST_X) X(GET_LIST_Y) X(GET_CONSTANT) \
+    X(SET_VARIABLE_A) X(SET_VARIABLE_X) X(SET_VARIABLE_Y) \
+    X(SET_VALUE_A) X(SET_VALUE_X) X(SET_VALUE_Y) \
+    X(SET_LOCAL_VALUE_X) X(SET_LOCAL_VALUE_Y) X(SET_CONSTANT) X(SET_VOID) \
+    X(UNIFY_VARIABLE_A) X(UNIFY_VARIABLE_X) X(UNIFY_VARIABLE_Y) \
+    X(UNIFY_VALUE_A) X(UNIFY_VALUE_X) X(UNIFY_VALUE_Y) \
+    X(UNIFY_LOCAL_VALUE_X) X(UNIFY_LOCAL_VALUE_Y) X(UNIFY_CONSTANT) \
+    X(UNIFY_VOID) \
+    X(ALLOCATE) X(DEALLOCATE) X(CALL) X(EXECUTE) X(PROCEED) \
+    X(BUILTIN) X(BUILTIN_R) \
+    X(TRY_ME_ELSE) X(RETRY_ME_ELSE) X(TRY_ME_ELSE_BODY) X(TRUST_ME) X(TRY) X(RETRY) X(TRUST) \
+    X(SWITCH_ON_TERM) X(SWITCH_ON_CONSTANT) X(SWITCH_ON_STRUCTURE) \
+    X(NECK_CUT) X(NECK) X(GET_LEVEL) X(CUT) X(GOTO) X(RESET_LEVEL) X(COST) \
+    X(PUT_VALUE_XX) X(GET_LIST_A_UNIFY_VARIABLE_XX) X(COST_ALLOCATE) \
+    X(ADD_A) X(SUB_A) X(MUL_A) X(IDIV_A) X(COMPARE_A) \
+    X(TYPE_TEST_A) X(COMPARE_TERM_A) X(FUNCTOR_A) X(GUARD) \
+    X(NATIVE) X(CHAIN_TRY) X(CHAIN_RETRY)
+
+#define WAM_COUNT_TYPE(I) +1
+static_assert(0 WAM_INSTRUCTION_TYPES(WAM_COUNT_TYPE) == LAST,
+	      "WAM_INSTRUCTION_TYPES is out of sync with wam_instruction_type");
+#undef WAM_COUNT_TYPE
+
+const char * wam_interpreter::opcode_name(wam_instruction_type t)
 {
-    for (auto m : hash_maps_) {
-	delete m;
+#define WAM_TYPE_NAME(I) case I: return #I;
+    switch (t) {
+	WAM_INSTRUCTION_TYPES(WAM_TYPE_NAME)
+    case LAST: break;
     }
+#undef WAM_TYPE_NAME
+    return "?";
 }
 
-bool wam_interpreter::cont_wam()
+void wam_interpreter::set_opcode_profiling(bool on)
 {
-    fail_ = false;
-    while (p().has_wam_code() && !is_top_fail()) {
-	if (auto instr = p().wam_code()) {
-	    if (is_debug()) {
-		std::cout << "[WAM debug]: tr=" << trail_size() << " [" << std::setw(5)
-			  << to_code_addr(instr) << "]: e=" << e0() << " ";
-		instr->print(std::cout, *this);
-		std::cout << "\n";
+    opcode_profiling_ = on;
+    if (on && opcode_counts_.empty()) {
+	reset_opcode_profile();
+    }
+}
+
+void wam_interpreter::reset_opcode_profile()
+{
+    opcode_counts_.assign(LAST, 0);
+    opcode_pairs_.assign(LAST*LAST, 0);
+    opcode_triples_.clear();
+}
+
+void wam_interpreter::print_opcode_profile(std::ostream &out, size_t top) const
+{
+    typedef std::pair<uint64_t, std::string> entry;
+    auto print_top = [&](const char *title, std::vector<entry> &entries) {
+	std::sort(entries.begin(), entries.end(),
+		  [](const entry &a, const entry &b) {
+		      return a.first > b.first; });
+	out << title << ":\n";
+	for (size_t i = 0; i < entries.size() && i < top; i++) {
+	    out << std::setw(12) << entries[i].first << " "
+		<< entries[i].second << "\n";
+	}
+    };
+
+    std::vector<entry> singles, pairs, triples;
+    for (size_t i = 0; i < opcode_counts_.size(); i++) {
+	if (opcode_counts_[i] != 0) {
+	    auto t = static_cast<wam_instruction_type>(i);
+	    singles.push_back(entry(opcode_counts_[i], opcode_name(t)));
+	}
+    }
+    for (size_t i = 0; i < opcode_pairs_.size(); i++) {
+	if (opcode_pairs_[i] != 0) {
+	    auto t1 = static_cast<wam_instruction_type>(i / LAST);
+	    auto t2 = static_cast<wam_instruction_type>(i % LAST);
+	    pairs.push_back(entry(opcode_pairs_[i],
+			  std::string(opcode_name(t1)) + " " + opcode_name(t2)));
+	}
+    }
+    for (auto &t : opcode_triples_) {
+	auto t1 = static_cast<wam_instruction_type>(t.first / (LAST*LAST));
+	auto t2 = static_cast<wam_instruction_type>(t.first / LAST % LAST);
+	auto t3 = static_cast<wam_instruction_type>(t.first % LAST);
+	triples.push_back(entry(t.second,
+	       std::string(opcode_name(t1)) + " " + opcode_name(t2) + " "
+			+ opcode_name(t3)));
+    }
+    print_top("Instructions", singles);
+    print_top("Pairs", pairs);
+    print_top("Triples", triples);
+}
+
+void wam_interpreter::trace_wam(wam_instruction_base *instr)
+{
+    std::cout << "[WAM debug]: tr=" << trail_size() << " [" << std::setw(5)
+	      << to_code_addr(instr) << "]: e=" << e0() << " ";
+    instr->print(std::cout, *this);
+    std::cout << "\n";
+}
+
+inline void wam_interpreter::profile_wam(uint32_t t, uint32_t &prev1,
+					 uint32_t &prev2)
+{
+    opcode_counts_[t]++;
+    if (prev1 != LAST) {
+	opcode_pairs_[prev1*LAST + t]++;
+	if (prev2 != LAST) {
+	    opcode_triples_[(prev2*LAST + prev1)*LAST + t]++;
+	}
+    }
+    prev2 = prev1;
+    prev1 = t;
+}
+
+//
+// Each instruction is invoked directly (and inlined) from its own
+// dispatch point instead of through the function pointer of the
+// instruction. We leave the loop as soon as P no longer points to WAM
+// code (a call to the interpreter or a failure into it) or we failed
+// beyond the top.
+//
+template<typename Policy> void wam_interpreter::run_wam()
+{
+    wam_instruction_base *instr;
+    // Previous two instruction types (LAST if none)
+    uint32_t prev1 = LAST, prev2 = LAST;
+
+#if defined(__GNUC__)
+#define WAM_LABEL_ADDR(I) &&L_##I,
+    static void * const dispatch_table[LAST] = {
+	WAM_INSTRUCTION_TYPES(WAM_LABEL_ADDR)
+    };
+#undef WAM_LABEL_ADDR
+
+#define WAM_DISPATCH() \
+    instr = p().wam_code(); \
+    if (instr == nullptr || is_top_fail()) return; \
+    if (Policy::trace) trace_wam(instr); \
+    if (Policy::profile) profile_wam(instr->type(), prev1, prev2); \
+    goto *dispatch_table[instr->type()];
+
+#define WAM_CASE(I) \
+    L_##I: \
+	wam_engine_step<Policy::cost, I>::invoke(*this, instr); \
+	cnt++; \
+	WAM_DISPATCH();
+
+    WAM_DISPATCH();
+    WAM_INSTRUCTION_TYPES(WAM_CASE)
+#undef WAM_CASE
+#undef WAM_DISPATCH
+
+#else
+#define WAM_CASE(I) \
+    case I: wam_engine_step<Policy::cost, I>::invoke(*this, instr); break;
+
+    for (;;) {
+	instr = p().wam_code();
+	if (instr == nullptr || is_top_fail()) return;
+	if (Policy::trace) trace_wam(instr);
+	if (Policy::profile) profile_wam(instr->type(), prev1, prev2);
+	switch (instr->type()) {
+	    WAM_INSTRUCTION_TYPES(WAM_CASE)
+	    case LAST: break;
+	}
+	cnt++;
+    }
+#undef WAM_CASE
+#endif
+}
+
+//
+// Native code calls these. The step functions run the very same
+// instruction implementations as run_wam() does.
+//
+template<wam_instruction_type I>
+bool wam_interpreter::native_step(wam_interpreter *interp, uint32_t offset)
+{
+    auto *instr = interp->to_code(offset);
+    try {
+	wam_instruction<I>::invoke(*interp, instr);
+    } catch (...) {
+	// Can't unwind through native frames
+	interp->native_exception_ = std::current_exception();
+	return false;
+    }
+    interp->cnt++;
+    return interp->p().wam_code() == interp->next_instruction(instr) &&
+	   !interp->is_top_fail();
+}
+
+// Already in native code, so entering it again is just a no-op.
+template<>
+bool wam_interpreter::native_step<NATIVE>(wam_interpreter *interp,
+					  uint32_t offset)
+{
+    interp->goto_next_instruction();
+    interp->cnt++;
+    return true;
+}
+
+const void * wam_interpreter::native_resume(wam_interpreter *interp)
+{
+    if (interp->native_exception_ || interp->is_top_fail()) {
+	return nullptr;
+    }
+    auto *instr = interp->p().wam_code();
+    if (instr == nullptr) {
+	return nullptr;
+    }
+    // Calls go to a NATIVE instruction, which knows where to continue
+    if (instr->type() == NATIVE) {
+	auto *native_instr = reinterpret_cast<wam_instruction<NATIVE> *>(instr);
+	if (native_instr->entry() != nullptr) {
+	    interp->goto_next_instruction();
+	    interp->cnt++;
+	    return native_instr->entry();
+	}
+	return nullptr;
+    }
+    return interp->native_.lookup(interp->to_code_addr(instr));
+}
+
+#define WAM_NATIVE_STEP(I) &wam_interpreter::native_step<I>,
+const wam_native::step_fn wam_interpreter::native_steps_[] = {
+    WAM_INSTRUCTION_TYPES(WAM_NATIVE_STEP)
+};
+#undef WAM_NATIVE_STEP
+
+//
+// Translate [from, to), which must start with a NATIVE instruction,
+// to native code. If that fails the NATIVE instruction is left
+// without an entry and the predicate runs interpreted.
+//
+void wam_interpreter::compile_native(size_t from, size_t to)
+{
+    auto *first = to_code(from);
+    if (first->type() != NATIVE) {
+	return;
+    }
+    std::vector<std::pair<size_t, uint32_t> > instrs;
+    for (size_t i = from; i < to;) {
+	auto *instr = to_code(i);
+	instrs.push_back(std::make_pair(i, static_cast<uint32_t>(instr->type())));
+	i += instr->size();
+    }
+    if (native_.compile(instrs, to) == nullptr) {
+	return;
+    }
+    auto *native_instr = reinterpret_cast<wam_instruction<NATIVE> *>(first);
+    native_instr->set_entry(native_.lookup(from + first->size()));
+}
+
+//
+// A retired segment may still be executing: P or CP can be in it, or
+// an environment or choice point refer to it. We don't know the exact
+// layout of every stack frame (meta contexts included), so any stack
+// word that looks like a pointer into a segment keeps it alive.
+//
+size_t wam_interpreter::collect_code()
+{
+    size_t n = 0;
+    bool released = true;
+    while (released) {
+	released = false;
+
+	std::vector<const segment *> retired;
+	get_retired_segments(retired);
+	if (retired.empty()) {
+	    break;
+	}
+
+	std::map<uintptr_t, const segment *> by_addr;
+	for (auto *seg : retired) {
+	    by_addr[reinterpret_cast<uintptr_t>(seg->code)] = seg;
+	}
+	std::unordered_set<const segment *> live;
+	auto mark = [&](const void *p) {
+	    auto addr = reinterpret_cast<uintptr_t>(p);
+	    auto it = by_addr.upper_bound(addr);
+	    if (it == by_addr.begin()) {
+		return;
+	    }
+	    --it;
+	    auto *seg = it->second;
+	    if (addr < reinterpret_cast<uintptr_t>(seg->code + seg->capacity)) {
+		live.insert(seg);
 	    }
-	    instr->invoke(*this);
-	    cnt++;
+	};
+
+	mark(p().wam_code());
+	mark(cp().wam_code());
+	word_t *top = allocate_stack();
+	for (word_t *w = stack_base(); w < top; w++) {
+	    const void *p;
+	    memcpy(&p, w, sizeof(p));
+	    mark(p);
 	}
+
+	for (auto *seg : retired) {
+	    if (live.count(seg)) {
+		continue;
+	    }
+	    size_t offset = seg->offset, end = seg->offset + seg->capacity;
+	    native_.remove(offset, end);
+	    free_segment(offset);
+	    n++;
+
+	    // The clauses of a freed chain go too (once unreferenced)
+	    auto it = chains_.find(offset);
+	    if (it != chains_.end()) {
+		auto &chain = *it->second;
+		for (size_t i = 0; i < chain.size(); i++) {
+		    release_segment(chain.offset(i));
+		}
+		chains_.erase(it);
+		released = true;
+	    }
+	}
+    }
+    return n;
+}
+
+wam_clause_chain * wam_interpreter::find_clause_chain(const qname &qn)
+{
+    auto *instr = resolve_predicate(qn.first, qn.second);
+    if (instr == nullptr || instr->type() != CHAIN_TRY) {
+	return nullptr;
+    }
+    return reinterpret_cast<wam_instruction<CHAIN_TRY> *>(instr)->chain();
+}
+
+wam_clause_chain * wam_interpreter::new_clause_chain(const qname &qn)
+{
+    auto *chain = new wam_clause_chain(qn.second.arity());
+    new_segment(wam_instruction<CHAIN_TRY>(chain).size() +
+		wam_instruction<CHAIN_RETRY>(chain).size());
+    size_t offset = next_offset();
+    add(wam_instruction<CHAIN_TRY>(chain));
+    add(wam_instruction<CHAIN_RETRY>(chain));
+    chains_[offset].reset(chain);
+    set_predicate(qn, to_code(offset), 0);
+    return chain;
+}
+
+void wam_interpreter::add_chain_clause(wam_clause_chain &chain,
+				       common::term clause, size_t offset)
+{
+    common::cell key = common::ref_cell(0);
+    if (chain.arity() > 0) {
+	key = index_key(arg(clause_head(clause), 0));
     }
+    use_segment(offset);
+    chain.append(clause, key, to_code(offset), offset);
+}
+
+template<bool Cost> void wam_interpreter::run_wam_engine()
+{
     if (is_debug()) {
+	run_wam<wam_engine_policy<Cost, true, false> >();
 	if (fail_) {
 	    std::cout << "[WAM debug]: fail\n";
 	} else {
 	    std::cout << "[WAM debug]: exit\n";
 	}
+    } else if (opcode_profiling_) {
+	run_wam<wam_engine_policy<Cost, false, true> >();
+    } else {
+	run_wam<wam_engine_policy<Cost, false, false> >();
+    }
+}
+
+bool wam_interpreter::cont_wam()
+{
+    fail_ = false;
+    shallow_ = false;
+    if (is_track_cost()) {
+	run_wam_engine<true>();
+    } else {
+	run_wam_engine<false>();
     }
     return !fail_;
 }
@@ -6,7 +6,11 @@
 #include <istream>
 #include <vector>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <exception>
 #include "interpreter_base.hpp"
+#include "wam_native.hpp"
 
 namespace prologcoin { namespace interp {
 
@@ -77,6 +81,7 @@ enum wam_instruction_type {
  
   TRY_ME_ELSE,
   RETRY_ME_ELSE,
+  TRY_ME_ELSE_BODY, // Non-standard WAM; try_me_else of (A ; B), not shallow
   TRUST_ME,
   TRY,
   RETRY,
@@ -87,6 +92,7 @@ enum wam_instruction_type {
   SWITCH_ON_STRUCTURE,
  
   NECK_CUT,
+  NECK, // Non-standard WAM; end of head, see shallow backtracking
   GET_LEVEL,
   CUT,
 
@@ -95,6 +101,31 @@ enum wam_instruction_type {
 
   COST, // Non-standard WAM; for accumulated cost
 
+  // Superinstructions; the most frequent instruction sequences fused
+  // into one (see wam_compiler::peephole_opt_fuse.)
+  PUT_VALUE_XX,                 // put_value_x + put_value_x
+  GET_LIST_A_UNIFY_VARIABLE_XX, // get_list_a + 2 x unify_variable_x
+  COST_ALLOCATE,                // cost + allocate
+
+  // Arithmetic on argument registers (compiled is/2 and comparisons)
+  ADD_A,
+  SUB_A,
+  MUL_A,
+  IDIV_A,
+  COMPARE_A,
+
+  // Built-ins tested in place on argument registers
+  TYPE_TEST_A,    // var/1, nonvar/1, atom/1, integer/1, atomic/1
+  COMPARE_TERM_A, // ==/2, \==/2, @</2, @=</2, @>/2, @>=/2
+  FUNCTOR_A,      // functor/3 on a0, a1 and a2
+
+  GUARD, // Non-standard WAM; selects clauses by a test, no choice point
+
+  NATIVE, // Non-standard WAM; continue in native code (if any)
+
+  CHAIN_TRY,   // Non-standard WAM; entry of a clause chain
+  CHAIN_RETRY, // Non-standard WAM; next clause of a clause chain
+
   LAST
 };
 
@@ -104,10 +135,65 @@ typedef uint64_t code_t;
 
 class wam_instruction_base;
 
-typedef std::unordered_map<common::term, code_point> wam_hash_map;
+// Keys and targets for a switch_on_constant/switch_on_structure in the
+// order they are to be laid out.
+typedef std::vector<std::pair<common::term, code_point> > wam_switch_table;
+
+// What a switch instruction looks at: argument register 'arg', or if
+// 'sub' > 0, argument 'sub' (counting from 1) of the structure
+// 'functor' in that register.
+struct wam_index_path {
+    inline wam_index_path() : arg(0), sub(0), functor() { }
+    inline wam_index_path(uint32_t a) : arg(a), sub(0), functor() { }
+    inline wam_index_path(uint32_t a, common::con_cell f, uint32_t s)
+	: arg(a), sub(s), functor(f) { }
+
+    inline bool operator == (const wam_index_path &other) const
+        { return arg == other.arg && sub == other.sub &&
+	         (sub == 0 || functor == other.functor); }
+    inline bool operator != (const wam_index_path &other) const
+        { return !(*this == other); }
+
+    uint32_t arg;
+    uint32_t sub;
+    common::con_cell functor;
+};
 
 template<wam_instruction_type I> class wam_instruction;
 
+// Arithmetic comparison performed by compare_a (and comparison in
+// the standard order of terms by compare_term_a)
+enum wam_compare_op { CMP_LT, CMP_LE, CMP_GT, CMP_GE, CMP_EQ, CMP_NE };
+
+// Type test performed by type_test_a
+enum wam_type_test { TYPE_VAR, TYPE_NONVAR, TYPE_ATOM, TYPE_INTEGER,
+		     TYPE_ATOMIC };
+
+// Tests a guard instruction can decide: the arithmetic comparisons
+// (in wam_compare_op order), standard order comparisons and var/nonvar.
+enum wam_guard_op { GUARD_LT, GUARD_LE, GUARD_GT, GUARD_GE,
+		    GUARD_EQ, GUARD_NE,
+		    GUARD_TERM_LT, GUARD_TERM_LE, GUARD_TERM_GT, GUARD_TERM_GE,
+		    GUARD_TERM_EQ, GUARD_TERM_NE,
+		    GUARD_VAR, GUARD_NONVAR };
+
+// An operand of a guard: an argument register, or a constant if
+// 'reg' is NO_REG.
+struct wam_guard_operand {
+    static const uint32_t NO_REG = static_cast<uint32_t>(-1);
+
+    inline wam_guard_operand() : reg(NO_REG), con() { }
+    inline wam_guard_operand(uint32_t r) : reg(r), con() { }
+    inline wam_guard_operand(common::term c) : reg(NO_REG), con(c) { }
+
+    inline bool is_reg() const { return reg != NO_REG; }
+    inline bool operator == (const wam_guard_operand &other) const
+    { return reg == other.reg && (is_reg() || con == other.con); }
+
+    uint32_t reg;
+    common::term con;
+};
+
 class wam_instruction_base
 {
 protected:
@@ -129,24 +215,6 @@ public:
 
     template<wam_instruction_type I> inline void set_type();
 
-protected:
-    inline void update_ptr(code_point &p, code_t *old_base, code_t *new_base)
-    {
-	if (p.wam_code() == nullptr) {
-	    return;
-	}
-	p.set_wam_code(reinterpret_cast<wam_instruction_base *>(reinterpret_cast<code_t *>(p.wam_code()) - old_base + new_base));
-    }
-
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	auto it = updater_fns_.find(fn());
-	if (it != updater_fns_.end()) {
-	    auto updater_fn = it->second;
-	    updater_fn(this, old_base, new_base);
-	}
-    }
-
 private:
     fn_type fn_;
     wam_instruction_type type_;
@@ -154,18 +222,16 @@ private:
 
     typedef void (*print_fn_type)(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self);
 
-    typedef void (*updater_fn_type)(wam_instruction_base *self, code_t *old_base, code_t *new_base);
-
 public:
     static void register_printer(fn_type fn, print_fn_type print_fn)
     {
         print_fns_[fn] = print_fn;
     }
 
-    static void register_updater(fn_type fn, updater_fn_type updater_fn)
-    {
-	updater_fns_[fn] = updater_fn;
-    }
+    // Prints what a switch looks at (nothing for the first argument,
+    // which is the default.)
+    static void print_path(std::ostream &out, wam_interpreter &interp,
+			   const wam_index_path &path);
 
     void print(std::ostream &out, wam_interpreter &interp)
     {
@@ -179,7 +245,6 @@ public:
 
 private:
     static std::unordered_map<fn_type, print_fn_type> print_fns_;
-    static std::unordered_map<fn_type, updater_fn_type> updater_fns_;
 
     friend class wam_code;
 };
@@ -336,13 +401,6 @@ public:
 	cp_ = cp;
     }
 
-protected:
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction_code_point *>(self);
-	self1->update(old_base, new_base);
-    }
-
 private:
     code_point cp_;
 };
@@ -360,64 +418,177 @@ private:
     uint32_t reg_;
 };
 
-class wam_instruction_hash_map : public wam_instruction_base
+// Switch tables are laid out inline, directly after the instruction,
+// so they get copied with the code. Up to MAX_LINEAR entries are
+// scanned linearly. Larger tables use open addressing over a power of
+// two number of slots, where a free slot has a REF key (a dereferenced
+// first argument that reaches a switch table is never a variable.)
+class wam_instruction_switch_table : public wam_instruction_base
 {
 public:
-    inline wam_instruction_hash_map(fn_type fn, uint64_t sz_bytes, wam_instruction_type t, wam_hash_map *map)
-	: wam_instruction_base(fn, sz_bytes, t), map_(map) { }
+    struct entry {
+	common::cell key;
+	code_point cp;
+    };
+
+    static const size_t MAX_LINEAR = 8;
+
+    static inline size_t num_slots_for(size_t n)
+    {
+	if (n <= MAX_LINEAR) {
+	    return n;
+	}
+	size_t slots = 1;
+	while (slots < 2*n) slots *= 2;
+	return slots;
+    }
+
+    static inline size_t size_in_bytes_for(size_t n)
+    {
+	return sizeof(wam_instruction_switch_table) + num_slots_for(n)*sizeof(entry);
+    }
+
+    // Must be constructed into storage of size_in_bytes_for(table.size())
+    inline wam_instruction_switch_table(fn_type fn, wam_instruction_type t, const wam_switch_table &table, const wam_index_path &path)
+	: wam_instruction_base(fn, size_in_bytes_for(table.size()), t),
+	  num_entries_(static_cast<uint32_t>(table.size())),
+	  mask_(table.size() <= MAX_LINEAR ? 0 : static_cast<uint32_t>(num_slots_for(table.size())-1)),
+	  path_(path)
+    {
+	size_t n = num_slots();
+	for (size_t i = 0; i < n; i++) {
+	    new (&entries()[i]) entry{free_key(), code_point::fail()};
+	}
+	if (is_linear()) {
+	    for (size_t i = 0; i < n; i++) {
+		entries()[i].key = table[i].first;
+		entries()[i].cp = table[i].second;
+	    }
+	    return;
+	}
+	for (auto &kv : table) {
+	    size_t j = hash(kv.first) & mask_;
+	    while (!is_free(j)) j = (j + 1) & mask_;
+	    entries()[j].key = kv.first;
+	    entries()[j].cp = kv.second;
+	}
+    }
 
-    inline wam_hash_map & map() const { return *map_; }
+    inline const wam_index_path & path() const { return path_; }
+    inline size_t num_entries() const { return num_entries_; }
+    inline size_t num_slots() const { return is_linear() ? num_entries_ : mask_ + 1; }
+    inline bool is_linear() const { return mask_ == 0; }
+    inline bool is_free(size_t i) const { return entries()[i].key == free_key(); }
+    inline entry & slot(size_t i) { return entries()[i]; }
 
-    inline void update(code_t *old_base, code_t *new_base)
+    inline code_point * find(const common::cell key)
     {
-	for (auto &v : map()) {
-	    update_ptr(v.second, old_base, new_base);
+	entry *e = entries();
+	if (is_linear()) {
+	    for (size_t i = 0; i < num_entries_; i++) {
+		if (e[i].key == key) return &e[i].cp;
+	    }
+	    return nullptr;
+	}
+	for (size_t j = hash(key) & mask_;; j = (j + 1) & mask_) {
+	    if (e[j].key == free_key()) return nullptr;
+	    if (e[j].key == key) return &e[j].cp;
 	}
     }
 
 protected:
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
+    template<typename T> static T * create(const wam_switch_table &table,
+					   const wam_index_path &path)
     {
-	auto self1 = reinterpret_cast<wam_instruction_hash_map *>(self);
-	self1->update(old_base, new_base);
+	char *mem = new char[size_in_bytes_for(table.size())];
+	return new (mem) T(table, path);
     }
 
 private:
-    wam_hash_map *map_;
+    static inline common::cell free_key() { return common::ref_cell(0); }
+
+    static inline size_t hash(const common::cell key)
+    {
+	uint64_t v = key.raw_value();
+	v ^= v >> 32;
+	v *= 0x9e3779b97f4a7c15ULL;
+	return static_cast<size_t>(v >> 32);
+    }
+
+    inline entry * entries() { return reinterpret_cast<entry *>(this + 1); }
+    inline const entry * entries() const { return reinterpret_cast<const entry *>(this + 1); }
+
+    uint32_t num_entries_;
+    uint32_t mask_;
+    wam_index_path path_;
 };
 
+//
+// The code area is a set of segments that never move, so instructions
+// can point at each other (and native code at them) directly. Each
+// loaded predicate gets a segment of its own (the clauses of clause
+// chains share segments), which is what makes it possible to give
+// back its code once it's no longer used (see
+// wam_interpreter::collect_code.)
+//
+// Code addresses are virtual: the address space is divided into slots
+// of SLOT_WORDS words, and a segment occupies one or more consecutive
+// slots. Mapping an address to its instruction is then a table lookup.
+//
 class wam_code
 {
 public:
-    wam_code(wam_interpreter &interp,
-  			     size_t initial_capacity = 1024)
-	: interp_(interp), instrs_size_(0), instrs_capacity_(initial_capacity)
-    { instrs_ = new code_t[instrs_capacity_]; }
+    static const size_t SLOT_BITS = 10;
+    static const size_t SLOT_WORDS = static_cast<size_t>(1) << SLOT_BITS;
+    // Capacity of segments opened implicitly by add()
+    static const size_t DEFAULT_SEGMENT_WORDS = 16*SLOT_WORDS;
+
+    wam_code(wam_interpreter &interp) : interp_(interp), current_(nullptr) { }
+    ~wam_code();
+
+    // Start a new segment with room for 'capacity' words. Code added
+    // after this is contiguous until the segment is full.
+    void new_segment(size_t capacity);
+
+    // Make room for 'sz' contiguous words, in the current segment if
+    // it has room, or in a new shared one otherwise.
+    inline void reserve(size_t sz)
+    {
+	if (current_ == nullptr || current_->size + sz > current_->capacity) {
+	    new_segment(std::max(sz, DEFAULT_SEGMENT_WORDS));
+	}
+    }
 
     inline size_t next_offset() const
     {
-	return instrs_size_;
+	return (current_ == nullptr) ? 0 : current_->offset + current_->size;
     }
     
     inline size_t to_code_addr(code_t *p) const
     {
-	return static_cast<size_t>(p - instrs_);
+	auto it = segment_by_ptr_.upper_bound(p);
+	--it;
+	return it->second + static_cast<size_t>(p - it->first);
     }
 
     inline size_t to_code_addr(wam_instruction_base *p) const
     {
-	return static_cast<size_t>(reinterpret_cast<code_t *>(p) - instrs_);
+	return to_code_addr(reinterpret_cast<code_t *>(p));
     }
 
     inline wam_instruction_base * to_code(size_t addr) const
     {
-	return reinterpret_cast<wam_instruction_base *>(&instrs_[addr]);
+	return reinterpret_cast<wam_instruction_base *>(
+		     slots_[addr >> SLOT_BITS] + (addr & (SLOT_WORDS - 1)));
     }
 
     size_t add(const wam_instruction_base &i);
 
     void print_code(std::ostream &out);
 
+    inline size_t num_segments() const { return segments_.size(); }
+    size_t code_size() const;
+
     inline bool is_compiled(const qname &qn) const
     {
 	return predicate_map_.find(qn) != predicate_map_.end();
@@ -442,6 +613,8 @@ public:
 		auto *cp_instr = reinterpret_cast<wam_instruction_code_point *>(to_code(offset));
 		cp_instr->cp().set_wam_code(nullptr);
 	    }
+
+	    release_segment(offset);
 	}
     }
 
@@ -451,9 +624,12 @@ protected:
 		       wam_instruction_base *instr,
 		       size_t environment_size)
     {
+	remove_compiled(qn);
+
 	size_t predicate_offset = to_code_addr(instr);
 	predicate_map_[qn] = predicate_offset;
 	predicate_rev_map_[predicate_offset] = qn;
+	use_segment(predicate_offset);
 
 	auto &offsets = calls_[qn];
 	for (auto offset : offsets) {
@@ -465,43 +641,70 @@ protected:
     wam_instruction_base * resolve_predicate(common::con_cell module,
 					     common::con_cell predicate_name)
     {
-	if (predicate_map_.count(qname(module, predicate_name))) {
-	    return to_code(predicate_map_[qname(module, predicate_name)]);
+	auto it = predicate_map_.find(qname(module, predicate_name));
+	if (it != predicate_map_.end()) {
+	    return to_code(it->second);
 	} else {
 	    return nullptr;
 	}
     }
 
-private:
-    code_t * ensure_fit(size_t sz)
+    struct segment {
+	code_t *code;
+	size_t offset;
+	size_t size;
+	size_t capacity;
+	size_t num_users;
+	bool retired; // No users left (and never will be)
+    };
+
+    // A segment is in use by the predicates (or clauses) that have
+    // code in it. Once the last one is gone it's retired: nothing new
+    // goes into it and it's reclaimed once unreferenced.
+    inline void use_segment(size_t offset)
     {
-        ensure_capacity(instrs_size_ + sz);
-	code_t *data = &instrs_[instrs_size_];
-	instrs_size_ += sz;
-	return data;
+	segment_of(offset).num_users++;
     }
 
-    void ensure_capacity(size_t cap)
+    inline void release_segment(size_t offset)
     {
-        if (cap > instrs_capacity_) {
-   	    size_t new_cap = 2*std::max(cap, instrs_size_);
-	    code_t *new_instrs = new code_t[new_cap];
-	    memcpy(new_instrs, instrs_, sizeof(code_t)*instrs_size_);
-	    instrs_capacity_ = new_cap;
+	auto &seg = segment_of(offset);
+	if (--seg.num_users == 0) {
+	    seg.retired = true;
+	    if (current_ == &seg) {
+		current_ = nullptr;
+	    }
+	}
+    }
 
-	    update(instrs_, new_instrs);
+    // Segments whose predicates have all been removed
+    void get_retired_segments(std::vector<const segment *> &retired) const;
+    void free_segment(size_t offset);
 
-	    delete instrs_;
-	    instrs_ = new_instrs;
-        }
+private:
+    inline segment & segment_of(size_t offset)
+    {
+	auto it = segments_.upper_bound(offset);
+	--it;
+	return it->second;
     }
 
-    inline void update(code_t *old_base, code_t *new_base);
+    code_t * ensure_fit(size_t sz)
+    {
+	reserve(sz);
+	code_t *data = current_->code + current_->size;
+	current_->size += sz;
+	return data;
+    }
 
     wam_interpreter &interp_;
-    size_t instrs_size_;
-    size_t instrs_capacity_;
-    code_t *instrs_;
+
+    std::map<size_t, segment> segments_;
+    std::map<const code_t *, size_t> segment_by_ptr_;
+    std::vector<code_t *> slots_;
+    // Free slot ranges (number of slots -> first slot)
+    std::multimap<size_t, size_t> free_slots_;
+    segment *current_;
 
     std::unordered_map<qname, size_t> predicate_map_;
     std::unordered_map<size_t, qname> predicate_rev_map_;
@@ -519,16 +722,10 @@ public:
     inline static void init() {
 	static bool init_ = [] {
 	    register_printer(&invoke, &print);
-	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init_);
     }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	update_ptr(p(), old_base, new_base);
-    }
-
     inline const code_point & p() const { return cp(); }
     inline code_point & p() { return cp(); }
 
@@ -547,7 +744,6 @@ public:
 
     static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self);
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base);
 };
 
 template<> class wam_instruction<BUILTIN> : public wam_instruction_code_point {
@@ -608,24 +804,144 @@ private:
 };
 
 
+//
+// An incrementally compiled predicate. Its clauses are compiled one by
+// one and linked through the chain in order, with a first argument
+// index on the side. Adding a clause just appends to it, so a predicate
+// that keeps changing is never recompiled as a whole.
+//
+// The predicate's entry point is a CHAIN_TRY instruction, which picks
+// the clauses that can match the first argument. If there's more than
+// one it pushes a choice point that resumes at CHAIN_RETRY with the
+// position to continue from saved as two extra arguments.
+//
+class wam_clause_chain {
+public:
+    // Every clause is on ALL, and the ones without a key (unbound or
+    // bignum first argument) are on VAR as well. Each key has a list
+    // of its own with the VAR clauses merged in.
+    static const size_t ALL = 0;
+    static const size_t VAR = 1;
+
+    inline wam_clause_chain(size_t arity) : arity_(arity), lists_(2) { }
+
+    inline size_t arity() const { return arity_; }
+    inline size_t size() const { return clauses_.size(); }
+    inline common::term clause(size_t i) const { return clauses_[i].clause; }
+    inline wam_instruction_base * code(size_t i) const { return clauses_[i].code; }
+    inline size_t offset(size_t i) const { return clauses_[i].offset; }
+
+    // Clause positions of a list
+    inline const std::vector<uint32_t> & list(size_t id) const
+    {
+	return lists_[id];
+    }
+
+    // The list to try for a key; no key (a REF cell) means all clauses
+    inline size_t select(common::cell key) const
+    {
+	if (key.tag() == common::tag_t::REF) {
+	    return ALL;
+	}
+	auto it = by_key_.find(key);
+	return it == by_key_.end() ? VAR : it->second;
+    }
+
+    // Append a clause with a given first argument key (a REF cell if
+    // none.)
+    void append(common::term clause, common::cell key,
+		wam_instruction_base *code, size_t offset)
+    {
+	uint32_t pos = static_cast<uint32_t>(clauses_.size());
+	clauses_.push_back(clause_entry{clause, code, offset});
+	lists_[ALL].push_back(pos);
+	if (key.tag() == common::tag_t::REF) {
+	    for (size_t id = VAR; id < lists_.size(); id++) {
+		lists_[id].push_back(pos);
+	    }
+	    return;
+	}
+	auto it = by_key_.find(key);
+	if (it == by_key_.end()) {
+	    it = by_key_.insert(std::make_pair(key, lists_.size())).first;
+	    lists_.push_back(lists_[VAR]);
+	}
+	lists_[it->second].push_back(pos);
+    }
+
+private:
+    struct clause_entry {
+	common::term clause;
+	wam_instruction_base *code;
+	size_t offset;
+    };
+
+    size_t arity_;
+    std::vector<clause_entry> clauses_;
+    std::vector<std::vector<uint32_t> > lists_;
+    std::unordered_map<common::cell, size_t> by_key_;
+};
+
+//
+// Configurations of the WAM engine. run_wam() is instantiated once per
+// policy, so what a policy turns off is compiled out rather than tested
+// for at every instruction. Consensus execution needs cost tracking,
+// but local tools and tests can do without it (see
+// interpreter_base::set_track_cost.)
+//
+template<bool Cost, bool Trace, bool Profile> struct wam_engine_policy {
+    static const bool cost = Cost;
+    static const bool trace = Trace;
+    static const bool profile = Profile;
+};
+
+// Instruction I as run by an engine with or without cost tracking.
+// Without it the cost instructions only do what they are fused with
+// and unification doesn't count its cost (see the specializations at
+// the end.)
+template<bool Cost, wam_instruction_type I> struct wam_engine_step {
+    static inline void invoke(wam_interpreter &interp,
+			      wam_instruction_base *self)
+    {
+	wam_instruction<I>::invoke(interp, self);
+    }
+};
+
 class wam_interpreter : public interpreter_base, public wam_code
 {
 public:
     wam_interpreter();
-    ~wam_interpreter();
 
     typedef common::term term;
 
-    inline wam_hash_map * new_hash_map()
-    {
-	auto *map = new wam_hash_map();
-	hash_maps_.push_back(map);
-	return map;
-    }
+    // Opcode profiling. Counts executed instructions as well as pairs
+    // and triples of consecutive instructions (used to decide what
+    // sequences to fuse into superinstructions.)
+    void set_opcode_profiling(bool on);
+    inline bool is_opcode_profiling() const { return opcode_profiling_; }
+    void reset_opcode_profile();
+    void print_opcode_profile(std::ostream &out, size_t top = 20) const;
+    static const char * opcode_name(wam_instruction_type t);
+
+    // Native code for compiled predicates (see wam_native.) Only
+    // predicates that start with a NATIVE instruction get translated.
+    inline const wam_native & native_code() const { return native_; }
+    void compile_native(size_t from, size_t to);
+
+    // Free the code of removed predicates that nothing refers to
+    // anymore. Returns the number of segments freed.
+    size_t collect_code();
+
+    // The clause chain of a predicate (nullptr if it isn't compiled
+    // as one.)
+    wam_clause_chain * find_clause_chain(const qname &qn);
 
     inline void remove_compiled(const qname &pn)
     {
 	wam_code::remove_compiled(pn);
+	if (auto *pd = find_predicate_descriptor(pn)) {
+	    pd->wam_offset = predicate_descriptor::NO_CODE;
+	}
     }
 
     inline std::string to_string(const term t) const
@@ -652,6 +968,13 @@ public:
     }
 
 protected:
+    inline void set_predicate(const qname &qn,
+			      wam_instruction_base *instr,
+			      size_t environment_size)
+    {
+	wam_code::set_predicate(qn, instr, environment_size);
+	get_predicate_descriptor(qn).wam_offset = to_code_addr(instr);
+    }
 
     inline bool backtrack_wam()
     {
@@ -659,13 +982,79 @@ protected:
 	return !fail_;
     }
 
+    // Compile 'qn' as an empty clause chain
+    wam_clause_chain * new_clause_chain(const qname &qn);
+    // Append a clause loaded at 'offset' (in a shared segment)
+    void add_chain_clause(wam_clause_chain &chain, common::term clause,
+			  size_t offset);
+
+    // First argument index key (a REF cell if none)
+    inline common::cell index_key(common::term t)
+    {
+	t = deref(t);
+	switch (t.tag()) {
+	case common::tag_t::CON: case common::tag_t::INT: return t;
+	case common::tag_t::STR: return functor(t);
+	default: return common::ref_cell(0);
+	}
+    }
+
     int cnt = 0;
 
     bool cont_wam();
 private:
+    // Direct threaded dispatch loop; one instance per engine policy
+    // (wam_engine_policy) so the normal loop doesn't test for tracing,
+    // profiling or cost tracking.
+    template<typename Policy> void run_wam();
+    template<bool Cost> void run_wam_engine();
+    void trace_wam(wam_instruction_base *instr);
+    inline void profile_wam(uint32_t t, uint32_t &prev1, uint32_t &prev2);
+
     bool fail_;
 
+    // Pending (not yet pushed) choice point; see shallow_try()
+    bool shallow_;
+    code_point shallow_bp_;
+    size_t shallow_tr_;
+    size_t shallow_h_;
+    size_t shallow_hb_;
+    size_t shallow_bb_;
+
+    bool opcode_profiling_;
+
+    wam_native native_;
+    // An exception thrown by an instruction in native code is held
+    // here until we're back in C++ frames.
+    std::exception_ptr native_exception_;
+
+    // Clause chains by the code offset of their entry
+    std::map<size_t, std::unique_ptr<wam_clause_chain> > chains_;
+    template<wam_instruction_type I>
+    static bool native_step(wam_interpreter *interp, uint32_t offset);
+    static const void * native_resume(wam_interpreter *interp);
+    static const wam_native::step_fn native_steps_[];
+
+    inline void native(const void *entry)
+    {
+	goto_next_instruction();
+	if (entry == nullptr || is_debug() || opcode_profiling_) {
+	    return;
+	}
+	native_.run(this, entry);
+	if (native_exception_) {
+	    auto ex = native_exception_;
+	    native_exception_ = nullptr;
+	    std::rethrow_exception(ex);
+	}
+    }
+    std::vector<uint64_t> opcode_counts_;
+    std::vector<uint64_t> opcode_pairs_;
+    std::unordered_map<uint32_t, uint64_t> opcode_triples_;
+
     template<wam_instruction_type I> friend class wam_instruction;
+    template<bool Cost, wam_instruction_type I>
+    friend struct wam_engine_step;
 
     static inline size_t num_y(interpreter_base *interp, environment_base_t *e)
     {
@@ -688,6 +1077,15 @@ private:
 
     inline void backtrack()
     {
+	if (shallow_) {
+	    // Only the head has run since the try, so undoing its
+	    // bindings is all there is to it.
+	    unwind_trail(shallow_tr_, trail_size());
+	    trim_trail(shallow_tr_);
+	    trim_heap(shallow_h_);
+	    set_p(shallow_bp_);
+	    return;
+	}
         if (b() == top_b()) {
 	    if (b() != nullptr) {
 		set_b0(b()->b0);
@@ -741,7 +1139,7 @@ private:
 
     inline void trail(size_t a)
     {
-        size_t bb = to_stack_addr(base(b()));
+        size_t bb = shallow_ ? shallow_bb_ : to_stack_addr(base(b()));
 	if (a < get_register_hb() || (is_stack(a) && a < bb)) {
 	    push_trail(a);
 	}
@@ -751,8 +1149,6 @@ private:
 
     size_t register_s_;
 
-    std::vector<wam_hash_map *> hash_maps_;
-
     term register_xn_[1024];
 
   public:
@@ -836,6 +1232,14 @@ private:
 	goto_next_instruction();
     }
 
+    inline void put_value_xx(uint32_t xn1, uint32_t ai1,
+			     uint32_t xn2, uint32_t ai2)
+    {
+        a(ai1) = x(xn1);
+        a(ai2) = x(xn2);
+	goto_next_instruction();
+    }
+
     inline void put_value_y(uint32_t yn, uint32_t ai)
     {
         a(ai) = y(yn);
@@ -904,6 +1308,29 @@ private:
 	goto_next_instruction();
     }
 
+    // Unification and comparison within WAM instructions only add their
+    // cost. It is checked (check_accumulated_cost) at the next clause
+    // entry (cost/cost_allocate), built-in call or when execution stops,
+    // so the outcome is the same as checking it at once.
+    template<bool Cost = true> inline bool unify_deferred(term a, term b)
+    {
+	if (!Cost) {
+	    return common::term_env::unify(a, b);
+	}
+        uint64_t cost = 0;
+	bool ok = common::term_env::unify(a, b, cost);
+	defer_accumulated_cost(cost);
+	return ok;
+    }
+
+    inline int standard_order_deferred(const term a, const term b)
+    {
+        uint64_t cost = 0;
+	int c = common::term_env::standard_order(a, b, cost);
+	defer_accumulated_cost(cost);
+	return c;
+    }
+
     inline void get_variable_x(uint32_t xn, uint32_t ai)
     {
         x(xn) = a(ai);
@@ -916,9 +1343,9 @@ private:
 	goto_next_instruction();
     }
 
-    inline void get_value_x(uint32_t xn, uint32_t ai)
+    template<bool Cost = true> inline void get_value_x(uint32_t xn, uint32_t ai)
     {
-        bool ok = unify(x(xn), a(ai));
+        bool ok = unify_deferred<Cost>(x(xn), a(ai));
 	if (!ok) {
 	    backtrack();
         } else {
@@ -926,9 +1353,9 @@ private:
 	}
     }
 
-    inline void get_value_y(uint32_t yn, uint32_t ai)
+    template<bool Cost = true> inline void get_value_y(uint32_t yn, uint32_t ai)
     {
-        bool ok = unify(y(yn), a(ai));
+        bool ok = unify_deferred<Cost>(y(yn), a(ai));
 
 	if (!ok) {
  	    backtrack();
@@ -956,6 +1383,17 @@ private:
     }
 
     inline void get_structure(common::con_cell f, common::term t)
+    {
+	if (match_structure(f, t)) {
+	    goto_next_instruction();
+	} else {
+	    backtrack();
+	}
+    }
+
+    // Sets up READ or WRITE mode for the arguments of 'f'; returns false
+    // if 't' doesn't match.
+    inline bool match_structure(common::con_cell f, common::term t)
     {
         bool fail = false;
 	switch (t.tag()) {
@@ -981,11 +1419,7 @@ private:
 	  fail = true;
 	  break;
 	}
-	if (fail) {
-	    backtrack();
-	} else {
-	    goto_next_instruction();
-	}
+	return !fail;
     }
 
     inline void get_list_a(uint32_t ai)
@@ -993,6 +1427,27 @@ private:
         get_structure_a(dotted_pair(), ai);
     }
 
+    inline void get_list_a_unify_variable_xx(uint32_t ai,
+					     uint32_t xn1, uint32_t xn2)
+    {
+	if (!match_structure(dotted_pair(), deref(a(ai)))) {
+	    backtrack();
+	    return;
+	}
+        switch (mode_) {
+	case READ:
+	    x(xn1) = heap_get(register_s_);
+	    x(xn2) = heap_get(register_s_+1);
+	    break;
+	case WRITE:
+	    x(xn1) = new_ref();
+	    x(xn2) = new_ref();
+	    break;
+        }
+	register_s_ += 2;
+	goto_next_instruction();
+    }
+
     inline void get_list_x(uint32_t xn)
     {
         get_structure_x(dotted_pair(), xn);
@@ -1145,11 +1600,11 @@ private:
 	goto_next_instruction();
     }
 
-    inline void unify_value_a(uint32_t ai)
+    template<bool Cost = true> inline void unify_value_a(uint32_t ai)
     {
         bool fail = false;
         switch (mode_) {
-	case READ: fail = !unify(a(ai), heap_get(register_s_)); break;
+	case READ: fail = !unify_deferred<Cost>(a(ai), heap_get(register_s_)); break;
 	case WRITE: new_term_copy_cell(a(ai)); break;
         }
 	register_s_++;
@@ -1160,11 +1615,11 @@ private:
 	}
     }
 
-    inline void unify_value_x(uint32_t xn)
+    template<bool Cost = true> inline void unify_value_x(uint32_t xn)
     {
         bool fail = false;
         switch (mode_) {
-	case READ: fail = !unify(x(xn), heap_get(register_s_)); break;
+	case READ: fail = !unify_deferred<Cost>(x(xn), heap_get(register_s_)); break;
 	case WRITE: new_term_copy_cell(x(xn)); break;
         }
 	register_s_++;
@@ -1175,11 +1630,11 @@ private:
 	}
     }
 
-    inline void unify_value_y(uint32_t yn)
+    template<bool Cost = true> inline void unify_value_y(uint32_t yn)
     {
         bool fail = false;
         switch (mode_) {
-	case READ: fail = !unify(y(yn), heap_get(register_s_)); break;
+	case READ: fail = !unify_deferred<Cost>(y(yn), heap_get(register_s_)); break;
 	case WRITE: new_term_copy_cell(y(yn)); break;
         }
 	register_s_++;
@@ -1190,11 +1645,11 @@ private:
 	}
     }
 
-    inline void unify_local_value_x(uint32_t xn)
+    template<bool Cost = true> inline void unify_local_value_x(uint32_t xn)
     {
         bool fail = false;
 	switch (mode_) {
-  	case READ: fail = !unify(x(xn), heap_get(register_s_)); break;
+  	case READ: fail = !unify_deferred<Cost>(x(xn), heap_get(register_s_)); break;
 	case WRITE: {
 	  term t = deref(x(xn));
 	  if (t.tag() == common::tag_t::REF) {
@@ -1219,11 +1674,11 @@ private:
 	}
     }
 
-    inline void unify_local_value_y(uint32_t xn)
+    template<bool Cost = true> inline void unify_local_value_y(uint32_t xn)
     {
         bool fail = false;
 	switch (mode_) {
-  	case READ: fail = !unify(x(xn), heap_get(register_s_)); break;
+  	case READ: fail = !unify_deferred<Cost>(x(xn), heap_get(register_s_)); break;
 	case WRITE: {
 	  term t = deref(x(xn));
 	  if (t.tag() == common::tag_t::REF) {
@@ -1294,6 +1749,9 @@ private:
 
     inline void allocate()
     {
+	if (shallow_) {
+	    materialize_choice_point();
+	}
         allocate_environment(true);
 	goto_next_instruction();
     }
@@ -1343,6 +1801,7 @@ private:
     inline bool builtin_r(wam_instruction_base *p0)
     {
         auto bn = reinterpret_cast<wam_instruction<BUILTIN_R> *>(p0);
+	check_accumulated_cost();
 	size_t num_args = bn->arity();
 	set_num_of_args(num_args);
 	goto_next_instruction();
@@ -1366,6 +1825,7 @@ private:
     inline bool builtin(wam_instruction_base *p0)
     {
         auto bn = reinterpret_cast<wam_instruction<BUILTIN> *>(p0);
+	check_accumulated_cost();
 	size_t num_args = bn->arity();
 	set_num_of_args(num_args);
 	goto_next_instruction();
@@ -1414,7 +1874,52 @@ private:
 	}
     }
 
+    //
+    // Shallow backtracking: try/try_me_else only record the alternative
+    // and the heap/trail marks. The choice point is pushed when the
+    // clause passes its neck (or allocates an environment.) If the head
+    // fails before that, backtracking just undoes the bindings and goes
+    // on with the alternative; the arguments are still in place as head
+    // unification never writes argument registers.
+    //
+    inline void shallow_try(const code_point &alt)
+    {
+	if (shallow_) {
+	    materialize_choice_point();
+	}
+	shallow_ = true;
+	shallow_bp_ = alt;
+	shallow_tr_ = trail_size();
+	shallow_h_ = heap_size();
+	shallow_hb_ = get_register_hb();
+	shallow_bb_ = to_stack_addr(allocate_stack());
+	set_register_hb(shallow_h_);
+    }
+
+    inline void materialize_choice_point()
+    {
+	shallow_ = false;
+	allocate_choice_point(shallow_bp_);
+	b()->tr = shallow_tr_;
+	b()->h = shallow_h_;
+	set_register_hb(shallow_h_);
+    }
+
+    inline void shallow_trust()
+    {
+	shallow_ = false;
+	set_register_hb(shallow_hb_);
+    }
+
     inline void try_me_else(code_point &L)
+    {
+	shallow_try(L);
+	goto_next_instruction();
+    }
+
+    // A disjunction in a body runs arbitrary goals, so it needs the
+    // choice point at once.
+    inline void try_me_else_body(code_point &L)
     {
 	allocate_choice_point(L);
 	goto_next_instruction();
@@ -1422,13 +1927,21 @@ private:
 
     inline void retry_me_else(code_point &L)
     {
-	retry_choice_point(L);
+	if (shallow_) {
+	    shallow_bp_ = L;
+	} else {
+	    retry_choice_point(L);
+	}
 	goto_next_instruction();
     }
 
     inline void trust_me()
     {
-	trust_choice_point();
+	if (shallow_) {
+	    shallow_trust();
+	} else {
+	    trust_choice_point();
+	}
 	goto_next_instruction();
     }
 
@@ -1436,7 +1949,7 @@ private:
     {
         auto p1 = p();
 	next_instruction(p1);
-	allocate_choice_point(p1);
+	shallow_try(p1);
 	set_p(L);
     }
 
@@ -1444,22 +1957,47 @@ private:
     {
         auto p1 = p();
 	next_instruction(p1);
-	retry_choice_point(p1);
+	if (shallow_) {
+	    shallow_bp_ = p1;
+	} else {
+	    retry_choice_point(p1);
+	}
 	set_p(L);
     }
 
     inline void trust(code_point &L)
     {
-	trust_choice_point();
+	if (shallow_) {
+	    shallow_trust();
+	} else {
+	    trust_choice_point();
+	}
 	set_p(L);
     }
 
-    inline void switch_on_term(const code_point &pv,
+    inline void neck()
+    {
+	if (shallow_) {
+	    materialize_choice_point();
+	}
+	goto_next_instruction();
+    }
+
+    inline void switch_on_term(const wam_index_path &path,
+			       const code_point &pv,
 			       const code_point &pc,
 			       const code_point &pl,
 			       const code_point &ps)
     {
-	term t = deref(a(0));
+	term t = deref(a(path.arg));
+	if (path.sub > 0 && t.tag() != common::tag_t::REF) {
+	    // Only structures with the functor can match
+	    if (t.tag() != common::tag_t::STR || functor(t) != path.functor) {
+		backtrack();
+		return;
+	    }
+	    t = deref(arg(t, path.sub - 1));
+	}
 
 	switch (t.tag()) {
 	case common::tag_t::CON: case common::tag_t::INT:
@@ -1497,26 +2035,73 @@ private:
 	}
     }
 
-    inline void switch_on_constant(wam_hash_map &map)
+    inline void chain_try(wam_clause_chain &chain, wam_instruction_base *retry)
     {
-	term t = deref(a(0));
-	auto it = map.find(t);
-	if (it == map.end()) {
+	size_t arity = chain.arity();
+	size_t id = arity == 0 ? wam_clause_chain::ALL
+	                       : chain.select(index_key(a(0)));
+	auto &lst = chain.list(id);
+	if (lst.empty()) {
 	    backtrack();
+	    return;
+	}
+	if (lst.size() > 1) {
+	    a(arity) = common::int_cell(id);
+	    a(arity+1) = common::int_cell(1);
+	    set_num_of_args(arity + 2);
+	    allocate_choice_point(code_point(retry));
+	    set_num_of_args(arity);
+	}
+	set_p(code_point(chain.code(lst[0])));
+    }
+
+    inline void chain_retry(wam_clause_chain &chain)
+    {
+	size_t arity = chain.arity();
+	auto id = static_cast<const common::int_cell &>(b()->ai[arity]).value();
+	auto i = static_cast<const common::int_cell &>(b()->ai[arity+1]).value();
+	auto &lst = chain.list(id);
+	auto *code = chain.code(lst[i]);
+	if (static_cast<size_t>(i + 1) < lst.size()) {
+	    retry_choice_point(b()->bp);
+	    b()->ai[arity+1] = common::int_cell(i + 1);
 	} else {
-	    set_p(it->second);
+	    trust_choice_point();
 	}
+	set_p(code_point(code));
     }
 
-    inline void switch_on_structure(wam_hash_map &map)
+    // The term a switch_on_constant/structure looks at. The preceding
+    // switch_on_term has checked that any structure on the path is
+    // there.
+    inline term index_subject(const wam_index_path &path)
     {
-	term t = functor(deref(a(0)));
+	term t = deref(a(path.arg));
+	if (path.sub > 0) {
+	    t = deref(arg(t, path.sub - 1));
+	}
+	return t;
+    }
+
+    inline void switch_on_constant(wam_instruction_switch_table &table)
+    {
+	term t = index_subject(table.path());
+	auto *cp = table.find(t);
+	if (cp == nullptr) {
+	    backtrack();
+	} else {
+	    set_p(*cp);
+	}
+    }
 
-	auto it = map.find(t);
-	if (it == map.end()) {
+    inline void switch_on_structure(wam_instruction_switch_table &table)
+    {
+	term t = functor(index_subject(table.path()));
+	auto *cp = table.find(t);
+	if (cp == nullptr) {
 	    backtrack();
 	} else {
-	    set_p(it->second);
+	    set_p(*cp);
 	}
     }
 
@@ -1556,7 +2141,7 @@ private:
     {
 	set_b0(b());
 	goto_next_instruction();
-	set_cp(p()); // This means a try_me_else will get the reset_level
+	set_cp(p()); // This means a try_me_else_body will get the reset_level
 	             // instruction to get the current size of the environment
     }
 
@@ -1566,52 +2151,254 @@ private:
 	goto_next_instruction();
     }
 
-    friend class test_wam_interpreter;
-};
-
-inline void wam_code::update(code_t *old_base, code_t *new_base)
-{
-    wam_instruction_base *instr = reinterpret_cast<wam_instruction_base *>(new_base);
-    for (size_t i = 0; i < instrs_size_;) {
-	instr->update(old_base, new_base);
-	instr = interp_.next_instruction(instr);
-	i = static_cast<size_t>(reinterpret_cast<code_t *>(instr) - new_base);
+    inline void cost_allocate(uint64_t c)
+    {
+	add_accumulated_cost(c);
+	if (shallow_) {
+	    materialize_choice_point();
+	}
+        allocate_environment(true);
+	goto_next_instruction();
     }
-}
 
-template<> class wam_instruction<PUT_VARIABLE_X> : public wam_instruction_binary_reg {
-public:
-    inline wam_instruction(uint32_t xn, uint32_t ai) :
-	wam_instruction_binary_reg(&invoke, sizeof(*this), PUT_VARIABLE_X,
-				   xn, ai) {
-        init();
+    // ai := ai <op> aj. Two small integers are computed directly;
+    // anything else (including overflow) is handed to the evaluator,
+    // which still dispatches on 'op' without building a term.
+    template<arith_op Op, bool (*Fn)(int64_t, int64_t, int64_t &)>
+    inline void arith_a(uint32_t ai, uint32_t aj)
+    {
+	term x = deref(a(ai));
+	term y = deref(a(aj));
+	int64_t r;
+	if (x.tag() == common::tag_t::INT && y.tag() == common::tag_t::INT &&
+	    Fn(static_cast<common::int_cell &>(x).value(),
+	       static_cast<common::int_cell &>(y).value(), r)) {
+	    a(ai) = common::int_cell(r);
+	} else {
+	    a(ai) = arith().eval_binary(Op, x, y, "is/2");
+	}
+	goto_next_instruction();
     }
 
-    inline uint32_t xn() const { return reg_1(); }
-    inline uint32_t ai() const { return reg_2(); }
-    inline void set_xn(size_t n) { set_reg_1(n); }
+    inline void add_a(uint32_t ai, uint32_t aj)
+    {
+	arith_a<ARITH_ADD, &arithmetics_fn::add>(ai, aj);
+    }
 
-    inline static void init() {
-	static bool init_ = [] {
-	    register_printer(&invoke, &print);
-	    return true; } ();
-	static_cast<void>(init_);
+    inline void sub_a(uint32_t ai, uint32_t aj)
+    {
+	arith_a<ARITH_SUB, &arithmetics_fn::sub>(ai, aj);
     }
 
-    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    inline void mul_a(uint32_t ai, uint32_t aj)
     {
-        auto self1 = reinterpret_cast<wam_instruction<PUT_VARIABLE_X> *>(self);
-        interp.put_variable_x(self1->xn(), self1->ai());
+	arith_a<ARITH_MUL, &arithmetics_fn::mul>(ai, aj);
     }
 
-    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    inline void idiv_a(uint32_t ai, uint32_t aj)
     {
-        auto self1 = reinterpret_cast<wam_instruction<PUT_VARIABLE_X> *>(self);
-        out << "put_variable x" << self1->xn() << ", a" << self1->ai();
+	arith_a<ARITH_INT_DIV, &arithmetics_fn::int_div>(ai, aj);
     }
-};
 
-template<> class wam_instruction<PUT_VARIABLE_Y> : public wam_instruction_binary_reg {
+    inline void compare_a(uint32_t ai, uint32_t aj, wam_compare_op op)
+    {
+	static const char *context[] = { "</2", "=</2", ">/2", ">=/2",
+					 "=:=/2", "=\\=/2" };
+	term x = deref(a(ai));
+	term y = deref(a(aj));
+	int c;
+	if (x.tag() == common::tag_t::INT && y.tag() == common::tag_t::INT) {
+	    auto vx = static_cast<common::int_cell &>(x).value();
+	    auto vy = static_cast<common::int_cell &>(y).value();
+	    c = (vx < vy) ? -1 : (vx > vy) ? 1 : 0;
+	} else {
+	    c = arith().compare(x, y, context[op]);
+	}
+	if (compare_outcome(op, c)) {
+	    goto_next_instruction();
+	} else {
+	    backtrack();
+	}
+    }
+
+    static inline bool compare_outcome(wam_compare_op op, int c)
+    {
+	switch (op) {
+	case CMP_LT: return c < 0;
+	case CMP_LE: return c <= 0;
+	case CMP_GT: return c > 0;
+	case CMP_GE: return c >= 0;
+	case CMP_EQ: return c == 0;
+	case CMP_NE: return c != 0;
+	}
+	return false;
+    }
+
+    // The same tests as builtins::var_1 etc. (atomic/1 is atom/1 there.)
+    inline void type_test_a(uint32_t ai, wam_type_test test)
+    {
+	term t = deref(a(ai));
+	bool ok = false;
+	switch (test) {
+	case TYPE_VAR: ok = t.tag() == common::tag_t::REF; break;
+	case TYPE_NONVAR: ok = t.tag() != common::tag_t::REF; break;
+	case TYPE_INTEGER: ok = t.tag() == common::tag_t::INT; break;
+	case TYPE_ATOM: case TYPE_ATOMIC:
+	    ok = t.tag() == common::tag_t::CON ||
+		 (t.tag() == common::tag_t::STR && functor(t).arity() == 0);
+	    break;
+	}
+	if (ok) {
+	    goto_next_instruction();
+	} else {
+	    backtrack();
+	}
+    }
+
+    // Costs what the builtins do, so no shortcut for equal terms or
+    // small integers.
+    inline void compare_term_a(uint32_t ai, uint32_t aj, wam_compare_op op)
+    {
+	int c = standard_order_deferred(deref(a(ai)), deref(a(aj)));
+	if (compare_outcome(op, c)) {
+	    goto_next_instruction();
+	} else {
+	    backtrack();
+	}
+    }
+
+    // functor(T, F, N) for a bound T (see builtins::functor_3.) As for a
+    // builtin, the arguments are dereferenced before they are unified.
+    inline void functor_a()
+    {
+	term t = deref(a(0));
+	bool ok = false;
+	switch (t.tag()) {
+	case common::tag_t::REF:
+	    abort(interpreter_exception_not_sufficiently_instantiated(
+		      "functor/3: Arguments are not sufficiently instantiated"));
+	    return;
+	case common::tag_t::INT:
+	case common::tag_t::BIG:
+	    ok = unify_deferred(deref(a(1)), t) &&
+		 unify_deferred(deref(a(2)), common::int_cell(0));
+	    break;
+	case common::tag_t::STR:
+	case common::tag_t::CON: {
+	    auto f = functor(t);
+	    ok = unify_deferred(deref(a(1)), to_atom(f)) &&
+		 unify_deferred(deref(a(2)), common::int_cell(f.arity()));
+	    break;
+	}
+	default:
+	    break;
+	}
+	if (ok) {
+	    goto_next_instruction();
+	} else {
+	    backtrack();
+	}
+    }
+
+    inline term guard_operand(const wam_guard_operand &x)
+    {
+	return x.is_reg() ? deref(a(x.reg)) : x.con;
+    }
+
+    // 1 if the test succeeds, 0 if it fails, and -1 if the outcome
+    // isn't final yet.
+    inline int guard_test(wam_guard_op op, const wam_guard_operand &x0,
+			  const wam_guard_operand &y0)
+    {
+	static const char *context[] = { "</2", "=</2", ">/2", ">=/2",
+					 "=:=/2", "=\\=/2" };
+	term x = guard_operand(x0);
+	if (op == GUARD_VAR || op == GUARD_NONVAR) {
+	    if (x.tag() == common::tag_t::REF) return -1;
+	    return op == GUARD_NONVAR;
+	}
+	term y = guard_operand(y0);
+	int c;
+	if (op <= GUARD_NE) {
+	    auto number = [](term t) { return t.tag() == common::tag_t::INT ||
+			                      t.tag() == common::tag_t::BIG; };
+	    if (!number(x) || !number(y)) return -1;
+	    if (x.tag() == common::tag_t::INT && y.tag() == common::tag_t::INT) {
+		auto vx = static_cast<common::int_cell &>(x).value();
+		auto vy = static_cast<common::int_cell &>(y).value();
+		c = (vx < vy) ? -1 : (vx > vy) ? 1 : 0;
+	    } else {
+		c = arith().compare(x, y, context[op]);
+	    }
+	} else {
+	    auto atomic = [](term t) { return t.tag() != common::tag_t::REF &&
+			                      t.tag() != common::tag_t::STR; };
+	    if (!atomic(x) || !atomic(y)) return -1;
+	    // Free, like switch_on_constant; the selected clause still
+	    // runs (and pays for) its own test.
+	    uint64_t cost = 0;
+	    c = common::term_env::standard_order(x, y, cost);
+	}
+	switch (op) {
+	case GUARD_LT: case GUARD_TERM_LT: return c < 0;
+	case GUARD_LE: case GUARD_TERM_LE: return c <= 0;
+	case GUARD_GT: case GUARD_TERM_GT: return c > 0;
+	case GUARD_GE: case GUARD_TERM_GE: return c >= 0;
+	case GUARD_EQ: case GUARD_TERM_EQ: return c == 0;
+	case GUARD_NE: case GUARD_TERM_NE: return c != 0;
+	default: return -1;
+	}
+    }
+
+    inline void guard(wam_guard_op op, const wam_guard_operand &x,
+		      const wam_guard_operand &y,
+		      code_point &pt, code_point &pf, code_point &pu)
+    {
+	int r = guard_test(op, x, y);
+	code_point &target = (r < 0) ? pu : (r ? pt : pf);
+	if (target.is_fail()) {
+	    backtrack();
+	} else {
+	    set_p(target);
+	}
+    }
+
+    friend class test_wam_interpreter;
+};
+
+template<> class wam_instruction<PUT_VARIABLE_X> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t xn, uint32_t ai) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this), PUT_VARIABLE_X,
+				   xn, ai) {
+        init();
+    }
+
+    inline uint32_t xn() const { return reg_1(); }
+    inline uint32_t ai() const { return reg_2(); }
+    inline void set_xn(size_t n) { set_reg_1(n); }
+
+    inline static void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<PUT_VARIABLE_X> *>(self);
+        interp.put_variable_x(self1->xn(), self1->ai());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<PUT_VARIABLE_X> *>(self);
+        out << "put_variable x" << self1->xn() << ", a" << self1->ai();
+    }
+};
+
+template<> class wam_instruction<PUT_VARIABLE_Y> : public wam_instruction_binary_reg {
 public:
     inline wam_instruction(uint32_t yn, uint32_t ai) :
 	wam_instruction_binary_reg(&invoke, sizeof(*this), PUT_VARIABLE_Y,
@@ -2939,12 +3726,6 @@ inline void wam_instruction<CALL>::print(std::ostream &out, wam_interpreter &int
     out << ", " << self1->num_y();
 }
 
-inline void wam_instruction<CALL>::updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-{
-    auto self1 = reinterpret_cast<wam_instruction<CALL> *>(self);
-    self1->update(old_base, new_base);
-}
-
 template<> class wam_instruction<EXECUTE> : public wam_instruction_code_point {
 public:
     inline wam_instruction(common::con_cell l) :
@@ -2955,16 +3736,10 @@ public:
     static inline void init() {
 	static bool init_ = [] {
 	    register_printer(&invoke, &print);
-	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init_);
     }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	update_ptr(p(), old_base, new_base);
-    }
-
     inline const code_point & p() const { return cp(); }
     inline code_point & p() { return cp(); }
 
@@ -2982,12 +3757,6 @@ public:
 	interp.execute(self1->p(), self1->arity());
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction<EXECUTE> *>(self);
-	self1->update(old_base, new_base);	
-    }
-
     static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<EXECUTE> *>(self);
@@ -3060,7 +3829,6 @@ public:
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3068,11 +3836,6 @@ public:
     inline const code_point & p() const { return cp(); }
     inline code_point & p() { return cp(); }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	update_ptr(p(), old_base, new_base);
-    }
-
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<TRY_ME_ELSE> *>(self);
@@ -3085,11 +3848,37 @@ public:
 	out << "try_me_else " << interp.to_string(self1->p());
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
+};
+
+template<> class wam_instruction<TRY_ME_ELSE_BODY> : public wam_instruction_code_point {
+public:
+    inline wam_instruction(code_point p) :
+	  wam_instruction_code_point(&invoke, sizeof(*this), TRY_ME_ELSE_BODY, p) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init = [] {
+ 	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init);
+    }
+
+    inline const code_point & p() const { return cp(); }
+    inline code_point & p() { return cp(); }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
-	auto self1 = reinterpret_cast<wam_instruction<TRY_ME_ELSE> *>(self);
-	self1->update(old_base, new_base);
+	auto self1 = reinterpret_cast<wam_instruction<TRY_ME_ELSE_BODY> *>(self);
+	interp.try_me_else_body(self1->p());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+	auto self1 = reinterpret_cast<wam_instruction<TRY_ME_ELSE_BODY> *>(self);
+	out << "try_me_else_body " << interp.to_string(self1->p());
     }
+
 };
 
 template<> class wam_instruction<RETRY_ME_ELSE> : public wam_instruction_code_point {
@@ -3102,7 +3891,6 @@ public:
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3110,11 +3898,6 @@ public:
     inline const code_point & p() const { return cp(); }
     inline code_point & p() { return cp(); }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-        update_ptr(p(), old_base, new_base);
-    }
-
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<RETRY_ME_ELSE> *>(self);
@@ -3127,11 +3910,6 @@ public:
 	out << "retry_me_else " << interp.to_string(self1->p());
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction<RETRY_ME_ELSE> *>(self);
-	self1->update(old_base, new_base);
-    }
 };
 
 template<> class wam_instruction<TRUST_ME> : public wam_instruction_base {
@@ -3172,7 +3950,6 @@ public:
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3180,11 +3957,6 @@ public:
     inline const code_point & p() const { return cp(); }
     inline code_point & p() { return cp(); }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	update_ptr(p(), old_base, new_base);
-    }
-
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<TRY> *>(self);
@@ -3197,11 +3969,6 @@ public:
 	out << "try " << interp.to_string(self1->p());
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction<TRY> *>(self);
-	self1->update(old_base, new_base);
-    }
 };
 
 template<> class wam_instruction<RETRY> : public wam_instruction_code_point {
@@ -3214,7 +3981,6 @@ public:
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3222,11 +3988,6 @@ public:
     inline const code_point & p() const { return cp(); }
     inline code_point & p() { return cp(); }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	update_ptr(p(), old_base, new_base);
-    }
-
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<RETRY> *>(self);
@@ -3239,11 +4000,6 @@ public:
 	out << "retry " << interp.to_string(self1->p());
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction<RETRY> *>(self);
-	self1->update(old_base, new_base);
-    }
 };
 
 template<> class wam_instruction<TRUST> : public wam_instruction_code_point {
@@ -3256,7 +4012,6 @@ public:
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3264,11 +4019,6 @@ public:
     inline const code_point & p() const { return cp(); }
     inline code_point & p() { return cp(); }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	update_ptr(p(), old_base, new_base);
-    }
-
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<TRUST> *>(self);
@@ -3281,11 +4031,6 @@ public:
 	out << "trust " << interp.to_string(self1->p());
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction<TRUST> *>(self);
-	self1->update(old_base, new_base);
-    }
 };
 
 template<> class wam_instruction<SWITCH_ON_TERM> : public wam_instruction_base {
@@ -3293,16 +4038,16 @@ public:
       inline wam_instruction(code_point pv,
 			     code_point pc,
 			     code_point pl,
-			     code_point ps) :
+			     code_point ps,
+			     const wam_index_path &path = wam_index_path()) :
       wam_instruction_base(&invoke, sizeof(*this), SWITCH_ON_TERM),
-      pv_(pv), pc_(pc), pl_(pl), ps_(ps) {
+      pv_(pv), pc_(pc), pl_(pl), ps_(ps), path_(path) {
       init();
     }
 
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3311,25 +4056,19 @@ public:
     inline code_point & pc() { return pc_; }
     inline code_point & pl() { return pl_; }
     inline code_point & ps() { return ps_; }
-
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-        update_ptr(pv_, old_base, new_base);
-	update_ptr(pc_, old_base, new_base);
-	update_ptr(pl_, old_base, new_base);
-	update_ptr(ps_, old_base, new_base);
-    }
+    inline const wam_index_path & path() const { return path_; }
 
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<SWITCH_ON_TERM> *>(self);
-	interp.switch_on_term(self1->pv(), self1->pc(), self1->pl(), self1->ps());
+	interp.switch_on_term(self1->path(), self1->pv(), self1->pc(), self1->pl(), self1->ps());
     }
 
     static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<SWITCH_ON_TERM> *>(self);
 	out << "switch_on_term ";
+	print_path(out, interp, self1->path());
         if (self1->pv().is_fail()) {
 	    out << "V->fail";
 	} else {
@@ -3355,29 +4094,33 @@ public:
 	}
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction<SWITCH_ON_TERM> *>(self);
-	self1->update(old_base, new_base);
-    }
-
     code_point pv_;
     code_point pc_;
     code_point pl_;
     code_point ps_;
+    wam_index_path path_;
 };
 
-template<> class wam_instruction<SWITCH_ON_CONSTANT> : public wam_instruction_hash_map {
-public:
-    inline wam_instruction(wam_hash_map *map) :
-      wam_instruction_hash_map(&invoke, sizeof(*this), SWITCH_ON_CONSTANT,map){
+template<> class wam_instruction<SWITCH_ON_CONSTANT> : public wam_instruction_switch_table {
+    friend class wam_instruction_switch_table;
+
+    inline wam_instruction(const wam_switch_table &table,
+			   const wam_index_path &path) :
+      wam_instruction_switch_table(&invoke, SWITCH_ON_CONSTANT, table, path) {
         init();
     }
 
+public:
+    // The table is stored after the instruction, so it can only live
+    // in separately allocated memory (which the caller owns.)
+    static inline wam_instruction * create(const wam_switch_table &table,
+				const wam_index_path &path = wam_index_path()) {
+	return wam_instruction_switch_table::create<wam_instruction>(table, path);
+    }
+
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3385,36 +4128,43 @@ public:
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<SWITCH_ON_CONSTANT> *>(self);
-	interp.switch_on_constant(self1->map());
+	interp.switch_on_constant(*self1);
     }
 
     static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<SWITCH_ON_CONSTANT> *>(self);
 	out << "switch_on_constant ";
+	print_path(out, interp, self1->path());
 	bool first = true;
-	for (auto &v : self1->map()) {
+	for (size_t i = 0; i < self1->num_slots(); i++) {
+	    if (self1->is_free(i)) continue;
+	    auto &e = self1->slot(i);
 	    if (!first) out << ", ";
-	    out << interp.to_string(v.first) << "->" << interp.to_string(v.second);
+	    out << interp.to_string(e.key) << "->" << interp.to_string(e.cp);
 	    first = false;
 	}
     }
-
-    wam_hash_map *map_;
 };
 
-template<> class wam_instruction<SWITCH_ON_STRUCTURE> : public wam_instruction_hash_map {
-public:
-    inline wam_instruction(wam_hash_map *map) :
-        wam_instruction_hash_map(&invoke, sizeof(*this), SWITCH_ON_STRUCTURE,
-				 map) {
+template<> class wam_instruction<SWITCH_ON_STRUCTURE> : public wam_instruction_switch_table {
+    friend class wam_instruction_switch_table;
+
+    inline wam_instruction(const wam_switch_table &table,
+			   const wam_index_path &path) :
+        wam_instruction_switch_table(&invoke, SWITCH_ON_STRUCTURE, table, path) {
         init();
     }
 
+public:
+    static inline wam_instruction * create(const wam_switch_table &table,
+				const wam_index_path &path = wam_index_path()) {
+	return wam_instruction_switch_table::create<wam_instruction>(table, path);
+    }
+
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3422,28 +4172,24 @@ public:
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<SWITCH_ON_STRUCTURE> *>(self);
-	interp.switch_on_structure(self1->map());
+	interp.switch_on_structure(*self1);
     }
 
     static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<SWITCH_ON_STRUCTURE> *>(self);
 	out << "switch_on_structure ";
+	print_path(out, interp, self1->path());
 	bool first = true;
-	for (auto &v : self1->map()) {
+	for (size_t i = 0; i < self1->num_slots(); i++) {
+	    if (self1->is_free(i)) continue;
+	    auto &e = self1->slot(i);
+	    auto f = static_cast<const common::con_cell &>(e.key);
 	    if (!first) out << ", ";
-	    auto str = static_cast<const common::str_cell &>(v.first);
-	    auto f = interp.functor(str);
-	    out << interp.to_string(v.first) << "/" << f.arity() << "->" << interp.to_string(v.second);
+	    out << interp.to_string(e.key) << "/" << f.arity() << "->" << interp.to_string(e.cp);
 	    first = false;
 	}
     }
-
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction<SWITCH_ON_STRUCTURE> *>(self);
-	self1->update(old_base, new_base);
-    }
 };
 
 template<> class wam_instruction<NECK_CUT> : public wam_instruction_base {
@@ -3474,6 +4220,34 @@ public:
     }
 };
 
+template<> class wam_instruction<NECK> : public wam_instruction_base {
+public:
+    inline wam_instruction() :
+      wam_instruction_base(&invoke, sizeof(*this), NECK) {
+      init();
+    }
+
+    static inline void init() {
+	static bool init = [] {
+ 	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init);
+    }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+	static_cast<void>(self);
+        interp.neck();
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+	static_cast<void>(interp);
+	static_cast<void>(self);
+        out << "neck";
+    }
+};
+
 template<> class wam_instruction<GET_LEVEL> : public wam_instruction_unary_reg {
 public:
     inline wam_instruction(uint32_t yn) :
@@ -3542,7 +4316,6 @@ public:
     static inline void init() {
 	static bool init = [] {
  	    register_printer(&invoke, &print);
- 	    register_updater(&invoke, &updater);
 	    return true; } ();
 	static_cast<void>(init);
     }
@@ -3550,11 +4323,6 @@ public:
     inline const code_point & p() const { return cp(); }
     inline code_point & p() { return cp(); }
 
-    inline void update(code_t *old_base, code_t *new_base)
-    {
-	update_ptr(p(), old_base, new_base);
-    }
-
     static void invoke(wam_interpreter &interp, wam_instruction_base *self)
     {
 	auto self1 = reinterpret_cast<wam_instruction<GOTO> *>(self);
@@ -3567,11 +4335,6 @@ public:
 	out << "goto " << interp.to_string(self1->p());
     }
 
-    static void updater(wam_instruction_base *self, code_t *old_base, code_t *new_base)
-    {
-	auto self1 = reinterpret_cast<wam_instruction<GOTO> *>(self);
-	self1->update(old_base, new_base);
-    }
 };
 
 template<> class wam_instruction<RESET_LEVEL> : public wam_instruction_code_point_reg {
@@ -3641,6 +4404,565 @@ public:
     }
 };
 
+template<> class wam_instruction<PUT_VALUE_XX> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t xn1, uint32_t ai1,
+			   uint32_t xn2, uint32_t ai2) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this), PUT_VALUE_XX,
+				   xn1, ai1), xn2_(xn2), ai2_(ai2) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t xn1() const { return reg_1(); }
+    inline uint32_t ai1() const { return reg_2(); }
+    inline uint32_t xn2() const { return xn2_; }
+    inline uint32_t ai2() const { return ai2_; }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<PUT_VALUE_XX> *>(self);
+        interp.put_value_xx(self1->xn1(), self1->ai1(),
+			    self1->xn2(), self1->ai2());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<PUT_VALUE_XX> *>(self);
+        out << "put_value x" << self1->xn1() << ", a" << self1->ai1()
+	    << " + put_value x" << self1->xn2() << ", a" << self1->ai2();
+    }
+
+private:
+    uint32_t xn2_;
+    uint32_t ai2_;
+};
+
+template<> class wam_instruction<GET_LIST_A_UNIFY_VARIABLE_XX> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t ai, uint32_t xn1, uint32_t xn2) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this),
+				   GET_LIST_A_UNIFY_VARIABLE_XX, ai, xn1),
+	xn2_(xn2) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t ai() const { return reg_1(); }
+    inline uint32_t xn1() const { return reg_2(); }
+    inline uint32_t xn2() const { return xn2_; }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<GET_LIST_A_UNIFY_VARIABLE_XX> *>(self);
+        interp.get_list_a_unify_variable_xx(self1->ai(), self1->xn1(),
+					    self1->xn2());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<GET_LIST_A_UNIFY_VARIABLE_XX> *>(self);
+        out << "get_list a" << self1->ai()
+	    << " + unify_variable x" << self1->xn1()
+	    << " + unify_variable x" << self1->xn2();
+    }
+
+private:
+    uint32_t xn2_;
+};
+
+template<> class wam_instruction<COST_ALLOCATE> : public wam_instruction_term {
+public:
+    inline wam_instruction(int64_t cost) :
+	wam_instruction_term(&invoke, sizeof(*this), COST_ALLOCATE,
+			     common::int_cell(cost)) {
+      init();
+    }
+
+    static inline void init() {
+	static bool init = [] {
+ 	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init);
+    }
+
+    inline uint64_t cost() const
+    {
+	const common::term t = get_term();
+	auto ic = reinterpret_cast<const common::int_cell &>(t);
+	return static_cast<uint64_t>(ic.value());
+    }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+	auto self1 = reinterpret_cast<wam_instruction<COST_ALLOCATE> *>(self);
+        interp.cost_allocate(self1->cost());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+	auto self1 = reinterpret_cast<wam_instruction<COST_ALLOCATE> *>(self);
+        out << "cost " << interp.to_string(self1->get_term()) << " + allocate";
+    }
+};
+
+template<> class wam_instruction<ADD_A> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t ai, uint32_t aj) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this), ADD_A, ai, aj) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t ai() const { return reg_1(); }
+    inline uint32_t aj() const { return reg_2(); }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<ADD_A> *>(self);
+        interp.add_a(self1->ai(), self1->aj());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<ADD_A> *>(self);
+        out << "add a" << self1->ai() << ", a" << self1->aj();
+    }
+};
+
+template<> class wam_instruction<SUB_A> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t ai, uint32_t aj) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this), SUB_A, ai, aj) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t ai() const { return reg_1(); }
+    inline uint32_t aj() const { return reg_2(); }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<SUB_A> *>(self);
+        interp.sub_a(self1->ai(), self1->aj());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<SUB_A> *>(self);
+        out << "sub a" << self1->ai() << ", a" << self1->aj();
+    }
+};
+
+template<> class wam_instruction<MUL_A> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t ai, uint32_t aj) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this), MUL_A, ai, aj) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t ai() const { return reg_1(); }
+    inline uint32_t aj() const { return reg_2(); }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<MUL_A> *>(self);
+        interp.mul_a(self1->ai(), self1->aj());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<MUL_A> *>(self);
+        out << "mul a" << self1->ai() << ", a" << self1->aj();
+    }
+};
+
+template<> class wam_instruction<IDIV_A> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t ai, uint32_t aj) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this), IDIV_A, ai, aj) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t ai() const { return reg_1(); }
+    inline uint32_t aj() const { return reg_2(); }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<IDIV_A> *>(self);
+        interp.idiv_a(self1->ai(), self1->aj());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<IDIV_A> *>(self);
+        out << "idiv a" << self1->ai() << ", a" << self1->aj();
+    }
+};
+
+template<> class wam_instruction<COMPARE_A> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t ai, uint32_t aj, wam_compare_op op) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this), COMPARE_A, ai, aj),
+	op_(op) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t ai() const { return reg_1(); }
+    inline uint32_t aj() const { return reg_2(); }
+    inline wam_compare_op op() const { return op_; }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<COMPARE_A> *>(self);
+        interp.compare_a(self1->ai(), self1->aj(), self1->op());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+	static const char *ops[] = { "<", "=<", ">", ">=", "=:=", "=\\=" };
+        auto self1 = reinterpret_cast<wam_instruction<COMPARE_A> *>(self);
+        out << "compare a" << self1->ai() << " " << ops[self1->op()] << " a" << self1->aj();
+    }
+
+private:
+    wam_compare_op op_;
+};
+
+template<> class wam_instruction<TYPE_TEST_A> : public wam_instruction_unary_reg {
+public:
+    inline wam_instruction(uint32_t ai, wam_type_test test) :
+	wam_instruction_unary_reg(&invoke, sizeof(*this), TYPE_TEST_A, ai),
+	test_(test) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t ai() const { return reg(); }
+    inline wam_type_test test() const { return test_; }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<TYPE_TEST_A> *>(self);
+        interp.type_test_a(self1->ai(), self1->test());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+	static const char *tests[] = { "var", "nonvar", "atom", "integer",
+				       "atomic" };
+        auto self1 = reinterpret_cast<wam_instruction<TYPE_TEST_A> *>(self);
+        out << "test " << tests[self1->test()] << "(a" << self1->ai() << ")";
+    }
+
+private:
+    wam_type_test test_;
+};
+
+template<> class wam_instruction<COMPARE_TERM_A> : public wam_instruction_binary_reg {
+public:
+    inline wam_instruction(uint32_t ai, uint32_t aj, wam_compare_op op) :
+	wam_instruction_binary_reg(&invoke, sizeof(*this), COMPARE_TERM_A, ai, aj),
+	op_(op) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline uint32_t ai() const { return reg_1(); }
+    inline uint32_t aj() const { return reg_2(); }
+    inline wam_compare_op op() const { return op_; }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<COMPARE_TERM_A> *>(self);
+        interp.compare_term_a(self1->ai(), self1->aj(), self1->op());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+	static const char *ops[] = { "@<", "@=<", "@>", "@>=", "==", "\\==" };
+        auto self1 = reinterpret_cast<wam_instruction<COMPARE_TERM_A> *>(self);
+        out << "compare_term a" << self1->ai() << " " << ops[self1->op()] << " a" << self1->aj();
+    }
+
+private:
+    wam_compare_op op_;
+};
+
+template<> class wam_instruction<FUNCTOR_A> : public wam_instruction_base {
+public:
+    inline wam_instruction() :
+	wam_instruction_base(&invoke, sizeof(*this), FUNCTOR_A) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+	static_cast<void>(self);
+        interp.functor_a();
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+	static_cast<void>(interp);
+	static_cast<void>(self);
+        out << "functor a0, a1, a2";
+    }
+};
+
+//
+// Jumps to 'then' or 'else' depending on the outcome of a test on
+// argument registers, so clauses that exclude each other by that test
+// need no choice point. If the outcome could still change (e.g. an
+// operand is unbound, so head unification may bind it) it jumps to
+// 'unknown', which tries the clauses as usual.
+//
+template<> class wam_instruction<GUARD> : public wam_instruction_base {
+public:
+    inline wam_instruction(wam_guard_op op,
+			   const wam_guard_operand &x,
+			   const wam_guard_operand &y,
+			   code_point pt, code_point pf, code_point pu) :
+	wam_instruction_base(&invoke, sizeof(*this), GUARD),
+	op_(op), x_(x), y_(y), pt_(pt), pf_(pf), pu_(pu) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline wam_guard_op op() const { return op_; }
+    inline const wam_guard_operand & x() const { return x_; }
+    inline const wam_guard_operand & y() const { return y_; }
+    inline code_point & pt() { return pt_; }
+    inline code_point & pf() { return pf_; }
+    inline code_point & pu() { return pu_; }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<GUARD> *>(self);
+	interp.guard(self1->op(), self1->x(), self1->y(),
+		     self1->pt(), self1->pf(), self1->pu());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self);
+
+private:
+    wam_guard_op op_;
+    wam_guard_operand x_;
+    wam_guard_operand y_;
+    code_point pt_;
+    code_point pf_;
+    code_point pu_;
+};
+
+template<> class wam_instruction<NATIVE> : public wam_instruction_base {
+public:
+    inline wam_instruction() :
+	wam_instruction_base(&invoke, sizeof(*this), NATIVE),
+	entry_(nullptr) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    // Native code for the instruction after this one
+    inline const void * entry() const { return entry_; }
+    inline void set_entry(const void *entry) { entry_ = entry; }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<NATIVE> *>(self);
+        interp.native(self1->entry());
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<NATIVE> *>(self);
+        out << "native";
+	if (self1->entry() == nullptr) {
+	    out << " (none)";
+	}
+    }
+
+private:
+    const void *entry_;
+};
+
+template<> class wam_instruction<CHAIN_TRY> : public wam_instruction_base {
+public:
+    inline wam_instruction(wam_clause_chain *chain) :
+	wam_instruction_base(&invoke, sizeof(*this), CHAIN_TRY),
+	chain_(chain) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    inline wam_clause_chain * chain() const { return chain_; }
+
+    // CHAIN_RETRY follows directly
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<CHAIN_TRY> *>(self);
+        interp.chain_try(*self1->chain_, interp.next_instruction(self));
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<CHAIN_TRY> *>(self);
+        out << "chain_try (" << self1->chain_->size() << " clauses)";
+    }
+
+private:
+    wam_clause_chain *chain_;
+};
+
+template<> class wam_instruction<CHAIN_RETRY> : public wam_instruction_base {
+public:
+    inline wam_instruction(wam_clause_chain *chain) :
+	wam_instruction_base(&invoke, sizeof(*this), CHAIN_RETRY),
+	chain_(chain) {
+        init();
+    }
+
+    static inline void init() {
+	static bool init_ = [] {
+	    register_printer(&invoke, &print);
+	    return true; } ();
+	static_cast<void>(init_);
+    }
+
+    static void invoke(wam_interpreter &interp, wam_instruction_base *self)
+    {
+        auto self1 = reinterpret_cast<wam_instruction<CHAIN_RETRY> *>(self);
+        interp.chain_retry(*self1->chain_);
+    }
+
+    static void print(std::ostream &out, wam_interpreter &interp, wam_instruction_base *self)
+    {
+        out << "chain_retry";
+    }
+
+private:
+    wam_clause_chain *chain_;
+};
+
+//
+// Engine without cost tracking
+//
+
+template<> struct wam_engine_step<false, COST> {
+    static inline void invoke(wam_interpreter &interp, wam_instruction_base *)
+    {
+	interp.goto_next_instruction();
+    }
+};
+
+template<> struct wam_engine_step<false, COST_ALLOCATE> {
+    static inline void invoke(wam_interpreter &interp, wam_instruction_base *)
+    {
+	interp.allocate();
+    }
+};
+
+#define WAM_ENGINE_STEP_NO_COST(I, call) \
+template<> struct wam_engine_step<false, I> { \
+    static inline void invoke(wam_interpreter &interp, \
+			      wam_instruction_base *self) \
+    { \
+        auto self1 = reinterpret_cast<wam_instruction<I> *>(self); \
+	interp.call; \
+    } \
+};
+
+WAM_ENGINE_STEP_NO_COST(GET_VALUE_X, get_value_x<false>(self1->xn(), self1->ai()))
+WAM_ENGINE_STEP_NO_COST(GET_VALUE_Y, get_value_y<false>(self1->yn(), self1->ai()))
+WAM_ENGINE_STEP_NO_COST(UNIFY_VALUE_A, unify_value_a<false>(self1->ai()))
+WAM_ENGINE_STEP_NO_COST(UNIFY_VALUE_X, unify_value_x<false>(self1->xn()))
+WAM_ENGINE_STEP_NO_COST(UNIFY_VALUE_Y, unify_value_y<false>(self1->yn()))
+WAM_ENGINE_STEP_NO_COST(UNIFY_LOCAL_VALUE_X, unify_local_value_x<false>(self1->xn()))
+WAM_ENGINE_STEP_NO_COST(UNIFY_LOCAL_VALUE_Y, unify_local_value_y<false>(self1->yn()))
+
+#undef WAM_ENGINE_STEP_NO_COST
 
 template<wam_instruction_type I> inline void wam_instruction_base::set_type()
 {
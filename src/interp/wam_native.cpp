@@ -0,0 +1,360 @@
+#include <cstring>
+#include "wam_native.hpp"
+
+#if defined(__x86_64__) && defined(__linux__)
+#define WAM_NATIVE_X86_64 1
+#include <sys/mman.h>
+#endif
+
+namespace prologcoin { namespace interp {
+
+//
+// x86_64_assembler
+//
+
+void x86_64_assembler::emit8(uint8_t b)
+{
+    out_.push_back(b);
+}
+
+void x86_64_assembler::emit32(uint32_t w)
+{
+    for (size_t i = 0; i < 4; i++) {
+	emit8(static_cast<uint8_t>(w >> (8*i)));
+    }
+}
+
+void x86_64_assembler::emit64(uint64_t w)
+{
+    for (size_t i = 0; i < 8; i++) {
+	emit8(static_cast<uint8_t>(w >> (8*i)));
+    }
+}
+
+// Relative to the end of the instruction, which is where the 32-bit
+// displacement ends.
+void x86_64_assembler::rel32(const uint8_t *target)
+{
+    auto next = reinterpret_cast<intptr_t>(address()) + 4;
+    auto rel = reinterpret_cast<intptr_t>(target) - next;
+    emit32(static_cast<uint32_t>(static_cast<int32_t>(rel)));
+}
+
+void x86_64_assembler::push(reg r)
+{
+    emit8(0x50 + r);
+}
+
+void x86_64_assembler::pop(reg r)
+{
+    emit8(0x58 + r);
+}
+
+void x86_64_assembler::mov(reg dst, reg src)
+{
+    emit8(0x48);
+    emit8(0x89);
+    emit8(0xc0 | (src << 3) | dst);
+}
+
+// mov r32, imm32 (clears the upper half)
+void x86_64_assembler::mov(reg dst, uint32_t imm)
+{
+    emit8(0xb8 + dst);
+    emit32(imm);
+}
+
+void x86_64_assembler::mov(reg dst, const void *imm)
+{
+    emit8(0x48);
+    emit8(0xb8 + dst);
+    emit64(reinterpret_cast<uint64_t>(imm));
+}
+
+void x86_64_assembler::call(reg r)
+{
+    emit8(0xff);
+    emit8(0xd0 | r);
+}
+
+void x86_64_assembler::jmp(reg r)
+{
+    emit8(0xff);
+    emit8(0xe0 | r);
+}
+
+void x86_64_assembler::jmp(const uint8_t *target)
+{
+    emit8(0xe9);
+    rel32(target);
+}
+
+void x86_64_assembler::jz(const uint8_t *target)
+{
+    emit8(0x0f);
+    emit8(0x84);
+    rel32(target);
+}
+
+void x86_64_assembler::test_al()
+{
+    emit8(0x84);
+    emit8(0xc0);
+}
+
+void x86_64_assembler::test(reg a, reg b)
+{
+    emit8(0x48);
+    emit8(0x85);
+    emit8(0xc0 | (b << 3) | a);
+}
+
+void x86_64_assembler::ret()
+{
+    emit8(0xc3);
+}
+
+//
+// wam_native
+//
+
+wam_native::wam_native(const step_fn *steps, resume_fn resume)
+    : steps_(steps), resume_(resume)
+{
+}
+
+wam_native::~wam_native()
+{
+    clear();
+}
+
+bool wam_native::is_supported()
+{
+#if WAM_NATIVE_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+void wam_native::clear()
+{
+#if WAM_NATIVE_X86_64
+    for (auto &c : chunks_) {
+	munmap(c.base, c.size);
+    }
+#endif
+    chunks_.clear();
+    blocks_.clear();
+}
+
+size_t wam_native::code_size() const
+{
+    size_t n = 0;
+    for (auto &c : chunks_) {
+	n += c.used;
+    }
+    return n;
+}
+
+bool wam_native::protect(chunk &c, bool writable)
+{
+#if WAM_NATIVE_X86_64
+    int prot = writable ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_EXEC);
+    return mprotect(c.base, c.size, prot) == 0;
+#else
+    return false;
+#endif
+}
+
+//
+// Each chunk starts with the code shared by its blocks. RBX holds the
+// interpreter while in native code; it is the only callee saved
+// register we use, and pushing it also aligns the stack for calls.
+//
+// enter(interp, entry):  push rbx; mov rbx, rdi; jmp rsi
+// leave:                 pop rbx; ret
+// resume:                mov rdi, rbx; call resume_fn
+//                        test rax, rax; jz leave; jmp rax
+//
+void wam_native::assemble_stubs(chunk &c, std::vector<uint8_t> &out)
+{
+    typedef x86_64_assembler as;
+    as a(out, c.base);
+
+    c.enter = a.address();
+    a.push(as::RBX);
+    a.mov(as::RBX, as::RDI);
+    a.jmp(as::RSI);
+
+    c.leave = a.address();
+    a.pop(as::RBX);
+    a.ret();
+
+    c.resume = a.address();
+    a.mov(as::RDI, as::RBX);
+    a.mov(as::RAX, reinterpret_cast<const void *>(resume_));
+    a.call(as::RAX);
+    a.test(as::RAX, as::RAX);
+    a.jz(c.leave);
+    a.jmp(as::RAX);
+}
+
+bool wam_native::new_chunk(size_t min_size)
+{
+#if WAM_NATIVE_X86_64
+    size_t size = CHUNK_SIZE;
+    while (size < min_size + 64) {
+	size *= 2;
+    }
+    void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+		     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+	return false;
+    }
+    chunk c;
+    c.base = static_cast<uint8_t *>(mem);
+    c.size = size;
+    std::vector<uint8_t> out;
+    assemble_stubs(c, out);
+    memcpy(c.base, &out[0], out.size());
+    c.used = out.size();
+    c.num_blocks = 0;
+    if (!protect(c, false)) {
+	munmap(c.base, c.size);
+	return false;
+    }
+    chunks_.push_back(c);
+    return true;
+#else
+    return false;
+#endif
+}
+
+//
+// Per instruction:
+//
+//    mov rdi, rbx; mov esi, <offset>; call <step>
+//    test al, al; jz resume
+//
+// and a final jmp resume for falling off the end of the block.
+//
+bool wam_native::assemble(chunk &c,
+			  const std::vector<std::pair<size_t, uint32_t> > &instrs,
+			  std::vector<uint8_t> &out, std::vector<size_t> &at)
+{
+    typedef x86_64_assembler as;
+    as a(out, c.base + c.used);
+
+    for (auto &instr : instrs) {
+	if (instr.first > UINT32_MAX) {
+	    return false;
+	}
+	at.push_back(a.pos());
+	a.mov(as::RDI, as::RBX);
+	a.mov(as::RSI, static_cast<uint32_t>(instr.first));
+	a.mov(as::RAX, reinterpret_cast<const void *>(steps_[instr.second]));
+	a.call(as::RAX);
+	a.test_al();
+	a.jz(c.resume);
+    }
+    a.jmp(c.resume);
+    return true;
+}
+
+const void * wam_native::compile(const std::vector<std::pair<size_t, uint32_t> > &instrs, size_t end_offset)
+{
+    if (!is_supported() || instrs.empty()) {
+	return nullptr;
+    }
+    if (chunks_.empty() && !new_chunk(0)) {
+	return nullptr;
+    }
+
+    std::vector<uint8_t> out;
+    std::vector<size_t> at;
+    if (!assemble(chunks_.back(), instrs, out, at)) {
+	return nullptr;
+    }
+    if (chunks_.back().used + out.size() > chunks_.back().size) {
+	// Doesn't fit; assemble again for a fresh chunk
+	if (!new_chunk(out.size())) {
+	    return nullptr;
+	}
+	out.clear();
+	at.clear();
+	assemble(chunks_.back(), instrs, out, at);
+    }
+
+    chunk &c = chunks_.back();
+    uint8_t *code = c.base + c.used;
+    if (!protect(c, true)) {
+	return nullptr;
+    }
+    memcpy(code, &out[0], out.size());
+    c.used += out.size();
+    if (!protect(c, false)) {
+	return nullptr;
+    }
+
+    size_t start = instrs.front().first;
+    block &blk = blocks_[start];
+    blk.end = end_offset;
+    blk.chunk_base = c.base;
+    c.num_blocks++;
+    blk.entries.assign(end_offset - start, nullptr);
+    for (size_t i = 0; i < instrs.size(); i++) {
+	blk.entries[instrs[i].first - start] = code + at[i];
+    }
+    return code;
+}
+
+void wam_native::remove(size_t start, size_t end)
+{
+    auto it = blocks_.lower_bound(start);
+    while (it != blocks_.end() && it->first < end) {
+	for (auto &c : chunks_) {
+	    if (c.base == it->second.chunk_base) {
+		c.num_blocks--;
+		break;
+	    }
+	}
+	it = blocks_.erase(it);
+    }
+
+    // The last chunk is where new code goes, so keep that one. The
+    // enter stub of the first chunk is used by run(), but any chunk
+    // has one so it doesn't matter which is first.
+    for (size_t i = 0; i + 1 < chunks_.size();) {
+	if (chunks_[i].num_blocks == 0) {
+#if WAM_NATIVE_X86_64
+	    munmap(chunks_[i].base, chunks_[i].size);
+#endif
+	    chunks_.erase(chunks_.begin() + i);
+	} else {
+	    i++;
+	}
+    }
+}
+
+const void * wam_native::lookup(size_t offset) const
+{
+    auto it = blocks_.upper_bound(offset);
+    if (it == blocks_.begin()) {
+	return nullptr;
+    }
+    --it;
+    if (offset >= it->second.end) {
+	return nullptr;
+    }
+    return it->second.entries[offset - it->first];
+}
+
+void wam_native::run(wam_interpreter *interp, const void *entry)
+{
+    typedef void (*enter_fn)(wam_interpreter *interp, const void *entry);
+    auto enter = reinterpret_cast<enter_fn>(const_cast<uint8_t *>(chunks_.front().enter));
+    enter(interp, entry);
+}
+
+}}
@@ -0,0 +1,145 @@
+#pragma once
+
+#ifndef _interp_wam_native_hpp
+#define _interp_wam_native_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace prologcoin { namespace interp {
+
+class wam_interpreter;
+
+//
+// Just enough of an x86-64 assembler for the native backend. Code is
+// assembled into a byte vector that will be copied to 'origin', so
+// relative jumps can be resolved against their final address.
+//
+class x86_64_assembler {
+public:
+    enum reg { RAX = 0, RCX = 1, RDX = 2, RBX = 3,
+	       RSP = 4, RBP = 5, RSI = 6, RDI = 7 };
+
+    x86_64_assembler(std::vector<uint8_t> &out, const uint8_t *origin)
+	: out_(out), origin_(origin) { }
+
+    inline size_t pos() const { return out_.size(); }
+    inline const uint8_t * address() const { return origin_ + pos(); }
+
+    void push(reg r);
+    void pop(reg r);
+    void mov(reg dst, reg src);
+    void mov(reg dst, uint32_t imm);
+    void mov(reg dst, const void *imm);
+    void call(reg r);
+    void jmp(reg r);
+    void jmp(const uint8_t *target);
+    void jz(const uint8_t *target);
+    void test_al();
+    void test(reg a, reg b);
+    void ret();
+
+private:
+    void emit8(uint8_t b);
+    void emit32(uint32_t w);
+    void emit64(uint64_t w);
+    void rel32(const uint8_t *target);
+
+    std::vector<uint8_t> &out_;
+    const uint8_t *origin_;
+};
+
+//
+// Subroutine-threaded x86-64 code for compiled predicates. Every WAM
+// instruction becomes a direct call to its step function, followed by
+// a test whether execution simply falls through to the next
+// instruction. No instruction body is open-coded: the semantics
+// (including all cost accounting) stay in the step functions, so
+// native and interpreted execution are identical step for step; what
+// goes away is the instruction dispatch.
+//
+// If execution continues elsewhere (a jump, call, proceed or
+// backtracking) the resume function maps P back to native code if it
+// lands in another native block, otherwise control returns to the
+// WAM dispatch loop. Predicates without native code simply run
+// interpreted.
+//
+class wam_native {
+public:
+    // Execute the instruction at 'offset'. Returns true if execution
+    // falls through to the next instruction.
+    typedef bool (*step_fn)(wam_interpreter *interp, uint32_t offset);
+    // Native address for the current P (or nullptr to leave.)
+    typedef const void * (*resume_fn)(wam_interpreter *interp);
+
+    wam_native(const step_fn *steps, resume_fn resume);
+    ~wam_native();
+
+    static bool is_supported();
+
+    // Translate the instructions (code offset and instruction type)
+    // of one predicate. The instructions must be contiguous and in
+    // order. Returns the native entry for the first instruction, or
+    // nullptr if this can't be done (the predicate stays interpreted.)
+    const void * compile(const std::vector<std::pair<size_t, uint32_t> > &instrs,
+			 size_t end_offset);
+
+    // Native code for the instruction at 'offset' (nullptr if none.)
+    const void * lookup(size_t offset) const;
+
+    // Run native code at 'entry' until control leaves native code.
+    void run(wam_interpreter *interp, const void *entry);
+
+    // Forget the native code for the WAM code in [start, end), e.g.
+    // when that code is garbage collected. Chunks without any live
+    // blocks are given back to the OS.
+    void remove(size_t start, size_t end);
+
+    // Forget all native code (e.g. when WAM code is discarded.)
+    void clear();
+
+    inline size_t num_chunks() const { return chunks_.size(); }
+
+    inline size_t num_blocks() const { return blocks_.size(); }
+    size_t code_size() const;
+
+private:
+    struct chunk {
+	uint8_t *base;
+	size_t size;
+	size_t used;
+	const uint8_t *enter;
+	const uint8_t *leave;
+	const uint8_t *resume;
+	size_t num_blocks;
+    };
+
+    struct block {
+	size_t end;
+	// Base of the chunk holding the native code
+	uint8_t *chunk_base;
+	// Native address for each code word offset in [start, end), or
+	// nullptr if not the start of an instruction.
+	std::vector<const uint8_t *> entries;
+    };
+
+    bool new_chunk(size_t min_size);
+    void assemble_stubs(chunk &c, std::vector<uint8_t> &out);
+    bool assemble(chunk &c,
+		  const std::vector<std::pair<size_t, uint32_t> > &instrs,
+		  std::vector<uint8_t> &out, std::vector<size_t> &at);
+    bool protect(chunk &c, bool writable);
+
+    static const size_t CHUNK_SIZE = 1024*1024;
+
+    const step_fn *steps_;
+    resume_fn resume_;
+    std::vector<chunk> chunks_;
+    std::map<size_t, block> blocks_;
+};
+
+}}
+
+#endif
@@ -528,11 +528,60 @@ void in_connection::process_query()
 		reply_exception(ex.what());
 	    }
 	}
+    } else if (f == con_cell("prepare",4) || f == e.functor("prepared",2)) {
+	if (session_ == nullptr) {
+	    reply_error(e.functor("no_running_session",0));
+	} else {
+	    process_prepared(t);
+	}
     } else {
 	reply_error(e.new_term(e.functor("unrecognized_command",1),{t}));
     }
 }
 
+//
+// prepare(Handle, Params, Template, Args) registers a query template
+// for the session and executes it. prepared(Handle, Args) executes
+// an already registered template.
+//
+void in_connection::process_prepared(const term t)
+{
+    auto &e = env_;
+    auto &se = session_->env();
+    term handle_term = e.arg(t, 0);
+    if (handle_term.tag() != tag_t::INT) {
+	reply_error(e.new_term(e.functor("unrecognized_command",1),{t}));
+	return;
+    }
+    auto handle = static_cast<const int_cell &>(handle_term).value();
+    try {
+	uint64_t cost = 0;
+	term args;
+	if (e.functor(t) == con_cell("prepare",4)) {
+	    // Copy params and template together to keep their sharing
+	    term pt = se.copy(e.new_term(e.functor("$prepared",2),
+					 {e.arg(t,1), e.arg(t,2)}), e, cost);
+	    if (!session_->prepare(handle, se.arg(pt,0), se.arg(pt,1))) {
+		reply_error(e.new_term(e.functor("too_many_prepared_queries",1),
+				       {handle_term}));
+		return;
+	    }
+	    args = se.copy(e.arg(t,3), e, cost);
+	} else {
+	    args = se.copy(e.arg(t,1), e, cost);
+	}
+	term qr = session_->instantiate_prepared(handle, args);
+	if (qr == term()) {
+	    reply_error(e.new_term(e.functor("unknown_prepared_query",1),
+				   {handle_term}));
+	    return;
+	}
+	process_execution(qr, false);
+    } catch (std::exception &ex) {
+	reply_exception(ex.what());
+    }
+}
+
 std::string in_connection::to_error_message(const std::vector<std::string> &msgs)
 {
     std::stringstream ss;
@@ -611,7 +660,7 @@ void in_connection::process_execution(const term cmd, bool in_query)
 //
 
 out_connection::out_connection(self_node &self, out_connection::out_type_t t, const ip_service &ip)
-    :  connection(self, CONNECTION_OUT, env_), out_type_(t), ip_(ip), init_in_progress_(false), use_heartbeat_(true), connected_(false), sent_my_name_(false), work_( &out_task::comparator )
+    :  connection(self, CONNECTION_OUT, env_), out_type_(t), ip_(ip), init_in_progress_(false), use_heartbeat_(true), connected_(false), sent_my_name_(false), prepared_count_(0), work_( &out_task::comparator ), sent_task_(nullptr)
 {
     using namespace boost::system;
 
@@ -635,6 +684,7 @@ out_connection::~out_connection()
 {
     boost::lock_guard<boost::recursive_mutex> guard(work_lock_);
 
+    delete sent_task_;
     while (!work_.empty()) {
 	out_task *t = work_.top();
         delete t;
@@ -642,6 +692,24 @@ out_connection::~out_connection()
     }
 }
 
+int64_t out_connection::find_prepared(const std::string &key) const
+{
+    auto it = prepared_.find(key);
+    return it == prepared_.end() ? -1 : it->second;
+}
+
+int64_t out_connection::new_prepared(const std::string &key)
+{
+    if (prepared_.size() >= MAX_PREPARED) {
+	return -1;
+    }
+    // Handles are never reused within a session so a stale handle can
+    // never execute the wrong template.
+    int64_t handle = prepared_count_++;
+    prepared_[key] = handle;
+    return handle;
+}
+
 out_task * out_connection::create_heartbeat_task()
 {
     return new task_heartbeat(*this);
@@ -685,9 +753,10 @@ void out_connection::reschedule(out_task *task, utime t)
     boost::lock_guard<boost::recursive_mutex> guard(work_lock_);
 
     // If task issues a reschedule on SEND, which normally it doesn't
-    // as it doesn't pop the work queue, then we'll pop the work queue
-    // to remove it first.
-    if (task->get_state() == out_task::SEND) {
+    // as it is on top of the work queue until it is sent, then we'll
+    // pop the work queue to remove it first.
+    if (task->get_state() == out_task::SEND && !work_.empty() &&
+	work_.top() == task) {
 	work_.pop();
     }
     
@@ -791,6 +860,10 @@ void out_connection::send_next_task()
     if (next_task->get_term() == term()) {
 	set_state(STATE_IDLE);
     } else {
+	// The answer is for this task, even if other tasks get ahead
+	// of it in the work queue meanwhile.
+	work_.pop();
+	sent_task_ = next_task;
 	send(next_task->get_term());
     }
     if (get_state() == STATE_IDLE) {
@@ -805,8 +878,8 @@ void out_connection::on_state()
     switch (get_state()) {
     case STATE_IDLE: if (!is_stopped()) send_next_task(); break;
     case STATE_RECEIVED: {
-	auto task = work_.top();
-	work_.pop();
+	auto task = sent_task_;
+	sent_task_ = nullptr;
 	auto r = received(task->env());
 	task->set_state(out_task::RECEIVED);
 	task->set_term(r);
@@ -184,6 +184,7 @@ private:
     void process_command(const term cmd);
     void process_query();
     void process_query_reply();
+    void process_prepared(const term t);
     void process_execution(const term cmd, bool in_query);
 
     void reply_exception(const std::string &msg);
@@ -223,7 +224,9 @@ public:
     inline void set_sent_my_name() { sent_my_name_ = true; }
 
 
-    inline void set_id(const std::string &id) { id_ = id; }
+    inline void set_id(const std::string &id)
+    { if (id != id_) clear_prepared();
+      id_ = id; }
     inline void set_name(const std::string &name) { name_ = name; }
 
     inline term_env & env() { return env_; }
@@ -256,6 +259,18 @@ public:
       }
     }
 
+    // Handles of query templates prepared at the remote session, keyed
+    // by the shape of the query. Returns -1 if there's none (or no more
+    // room for a new one.)
+    static const size_t MAX_PREPARED = 256;
+
+    int64_t find_prepared(const std::string &key) const;
+    int64_t new_prepared(const std::string &key);
+    inline void forget_prepared(const std::string &key)
+    { prepared_.erase(key); }
+    inline void clear_prepared()
+    { prepared_.clear(); }
+
     inline bool is_connected() const { return connected_; }
     inline void set_connected(bool b) { connected_ = b; }
 
@@ -293,10 +308,13 @@ private:
     bool connected_;
     bool sent_my_name_;
     term_env env_;
+    std::unordered_map<std::string, int64_t> prepared_;
+    int64_t prepared_count_;
     boost::recursive_mutex work_lock_;
     // boost::condition_variable work_cv_;
     std::priority_queue<out_task *, std::vector<out_task *>, std::function<bool (const out_task *t1, const out_task *t2)> > work_;
     utime last_in_work_;
+    out_task *sent_task_; // Waiting for an answer
 };
 
 }}
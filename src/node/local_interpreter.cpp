@@ -84,6 +84,10 @@ bool me_builtins::operator_at_2(interpreter_base &interp0, size_t arity, term ar
 	return false;
     }
 
+    // Continue as a non-recursive built-in would
+    interp.set_p(interp.cp());
+    interp.set_cp(interp.empty_list());
+
     if (result.has_more()) {
 	auto *mc = interp.new_meta_context<meta_context_operator_at>(&operator_at_2_meta);
 	interp.set_top_b(interp.b());
@@ -148,7 +152,9 @@ bool me_builtins::operator_at_2_meta(interpreter_base &interp0, const interp::me
 	return false;
     } else {
 	interp.allocate_choice_point(code_point::fail());
-	interp.set_p(interp.empty_list());
+	// Continue after the @/2 call (which may be in WAM code)
+	interp.set_p(mc->old_p);
+	interp.set_cp(mc->old_cp);
     }
 
     return interp.unify(qr, r.result());
@@ -463,7 +469,8 @@ void local_interpreter::ensure_initialized()
 
 void local_interpreter::setup_modules()
 {
-    load_builtin(con_cell("@",2), &me_builtins::operator_at_2);
+    // Recursive, as it continues from its meta context on backtracking
+    load_builtin(con_cell("@",2), interp::builtin(&me_builtins::operator_at_2,true));
 
     // [...] syntax to load programs.
     load_builtin(con_cell(".", 2), &me_builtins::list_load_2);
@@ -12,9 +12,13 @@ in_session_state::in_session_state(self_node *self, in_connection *conn)
     connection_(conn),
     interp_(*this),
     heartbeat_count_(0),
-    available_funds_(0)
+    available_funds_(0),
+    pending_cost_(0),
+    last_extra_cost_(0)
 {
     id_ = "s" + random::next();
+    // Execution is paid for with funds, so cost must be tracked
+    interp_.set_track_cost(true);
 }
 
 term in_session_state::query_closure()
@@ -28,12 +32,16 @@ bool in_session_state::execute(const term query)
 
     interp_.ensure_initialized();
     interp_.reset_text_out();
-    interp_.set_maximum_cost(available_funds_);
+    // Charge what was spent on preparing the query (if any) as well
+    last_extra_cost_ = pending_cost_;
+    pending_cost_ = 0;
+    interp_.set_maximum_cost(last_extra_cost_ < available_funds_
+			     ? available_funds_ - last_extra_cost_ : 0);
     bool r = false;
     try {
 	r = interp_.execute(query);
 	interp_.flush_standard_output();
-	auto cost = interp_.accumulated_cost();
+	auto cost = last_cost();
 	if (cost > available_funds_) {
 	    available_funds_ = 0;
 	} else {
@@ -52,6 +60,7 @@ bool in_session_state::next()
     using namespace prologcoin::interp;
 
     interp_.reset_text_out();
+    last_extra_cost_ = 0;
     interp_.set_maximum_cost(available_funds_);
     bool r = false;
     try {
@@ -71,6 +80,43 @@ bool in_session_state::next()
     return r;
 }
 
+bool in_session_state::prepare(int64_t handle, const term params,
+			       const term templ)
+{
+    if (prepared_.size() >= MAX_PREPARED && !prepared_.count(handle)) {
+	return false;
+    }
+    interp_.ensure_initialized();
+    term_serializer ser(interp_);
+    auto &buf = prepared_[handle];
+    buf.clear();
+    ser.write(buf, interp_.new_term(interp_.functor("$prepared",2),
+				    {params, templ}));
+    return true;
+}
+
+//
+// Returns a fresh instance of the template with its parameters bound
+// to 'args', or term() if the handle is unknown or the arguments don't
+// match. The cost of the instance and of binding its parameters is
+// charged to the next execute().
+//
+term in_session_state::instantiate_prepared(int64_t handle, const term args)
+{
+    auto it = prepared_.find(handle);
+    if (it == prepared_.end()) {
+	return term();
+    }
+    term_serializer ser(interp_);
+    term inst = ser.read(it->second);
+    uint64_t cost = env().cost(inst);
+    if (!env().unify(interp_.arg(inst, 0), args, cost)) {
+	return term();
+    }
+    pending_cost_ = cost;
+    return interp_.arg(inst, 1);
+}
+
 bool in_session_state::at_end()
 {
     return !interp_.has_more() && interp_.is_instance();
@@ -83,11 +129,15 @@ void in_session_state::delete_instance()
 
 bool in_session_state::reset()
 {
+    prepared_.clear();
+    pending_cost_ = 0;
     return interp_.reset();
 }
 
 void in_session_state::local_reset()
 {
+    prepared_.clear();
+    pending_cost_ = 0;
     interp_.local_reset();
 }
 
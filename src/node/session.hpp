@@ -4,6 +4,7 @@
 #define _node_session_hpp
 
 #include "../common/utime.hpp"
+#include "../common/term_serializer.hpp"
 #include "local_interpreter.hpp"
 
 namespace prologcoin { namespace node {
@@ -33,6 +34,19 @@ public:
 
     bool execute(const common::term query);
     bool next();
+
+    // Prepared queries. A template is registered once under a handle
+    // given by the client; later executions only pass the arguments
+    // for its parameters. Templates are kept serialized, as the heap
+    // of the interpreter is trimmed on backtracking. Building the
+    // instance is paid for by the execution that follows.
+    static const size_t MAX_PREPARED = 256;
+
+    bool prepare(int64_t handle, const common::term params,
+		 const common::term templ);
+    common::term instantiate_prepared(int64_t handle, const common::term args);
+    inline size_t num_prepared() const { return prepared_.size(); }
+
     bool at_end();
     void delete_instance();
     bool reset();
@@ -43,10 +57,16 @@ public:
     inline void reset_text_out() { interp_.reset_text_out(); }
 
     inline bool has_more() const { return interp_.has_more(); }
-    inline uint64_t last_cost() const { return interp_.accumulated_cost(); }
+    inline uint64_t last_cost() const
+        { return interp_.accumulated_cost() + last_extra_cost_; }
     inline uint64_t available_funds() const { return available_funds_; }
 
     void set_available_funds(uint64_t funds) { available_funds_ = funds; }
+
+    inline size_t maximum_stack_size() const
+        { return interp_.maximum_stack_size(); }
+    inline void set_maximum_stack_size(size_t sz)
+        { interp_.set_maximum_stack_size(sz); }
     void add_funds(uint64_t dfunds);
     void heartbeat();
 
@@ -61,6 +81,9 @@ private:
     common::utime heartbeat_;
     size_t heartbeat_count_;
     uint64_t available_funds_;
+    uint64_t pending_cost_;
+    uint64_t last_extra_cost_;
+    std::unordered_map<int64_t, common::term_serializer::buffer_t> prepared_;
 };
 
 }}
@@ -17,6 +17,9 @@ task_execute_query::task_execute_query(out_connection &out,
     uint64_t cost = 0;
     type_ = QUERY;
     query_ = env().copy(query, query_src, cost);
+    handle_ = -1;
+    retried_ = false;
+    prepare_template();
 }
 
 task_execute_query::task_execute_query(out_connection &out,
@@ -27,6 +30,8 @@ task_execute_query::task_execute_query(out_connection &out,
 {
     type_ = DO_NEXT;
     query_ = term();
+    handle_ = -1;
+    retried_ = false;
 }
 
 task_execute_query::task_execute_query(out_connection &out,
@@ -37,6 +42,8 @@ task_execute_query::task_execute_query(out_connection &out,
 {
     type_ = NEW_INSTANCE;
     query_ = term();
+    handle_ = -1;
+    retried_ = false;
 }
 
 task_execute_query::task_execute_query(out_connection &out,
@@ -47,6 +54,151 @@ task_execute_query::task_execute_query(out_connection &out,
 {
     type_ = DELETE_INSTANCE;
     query_ = term();
+    handle_ = -1;
+    retried_ = false;
+}
+
+//
+// The shape of a query is the query with its atomic arguments replaced
+// by parameters. Queries with the same shape share a template at the
+// remote session, so only the arguments are sent the next time. Atoms
+// in goal position (e.g. '!' or 'true') are part of the shape.
+//
+void task_execute_query::prepare_template()
+{
+    if (env().deref(query_).tag() != tag_t::STR) {
+	return;
+    }
+    lift_goal(query_, template_);
+    if (args_.empty()) {
+	key_.clear();
+    }
+}
+
+void task_execute_query::lift_goal(const term t0, term &lifted)
+{
+    static const con_cell comma(",", 2);
+    static const con_cell semi(";", 2);
+    static const con_cell arrow("->", 2);
+    static const con_cell colon(":", 2);
+
+    auto &e = env();
+    term t = e.deref(t0);
+    switch (t.tag()) {
+    case tag_t::CON:
+	key_ += boost::lexical_cast<std::string>(t.raw_value());
+	lifted = t;
+	return;
+    case tag_t::STR:
+	break;
+    default:
+	lift(t, lifted);
+	return;
+    }
+
+    auto f = e.functor(t);
+    bool control = f == comma || f == semi || f == arrow;
+    key_ += boost::lexical_cast<std::string>(f.raw_value()) + "(";
+    lifted = e.new_term(f);
+    for (size_t i = 0; i < f.arity(); i++) {
+	term lifted_arg;
+	if (control || (f == colon && i == 1)) {
+	    lift_goal(e.arg(t, i), lifted_arg);
+	} else if (f == colon && e.deref(e.arg(t, i)).tag() == tag_t::CON) {
+	    // Keep the module name
+	    lifted_arg = e.deref(e.arg(t, i));
+	    key_ += boost::lexical_cast<std::string>(lifted_arg.raw_value());
+	} else {
+	    lift(e.arg(t, i), lifted_arg);
+	}
+	e.set_arg(lifted, i, lifted_arg);
+	key_ += ",";
+    }
+    key_ += ")";
+}
+
+void task_execute_query::lift(const term t0, term &lifted)
+{
+    auto &e = env();
+    term t = e.deref(t0);
+    switch (t.tag()) {
+    case tag_t::REF: {
+	auto it = std::find(vars_.begin(), vars_.end(), t);
+	key_ += "V" + boost::lexical_cast<std::string>(it - vars_.begin());
+	if (it == vars_.end()) {
+	    vars_.push_back(t);
+	}
+	lifted = t;
+	break;
+    }
+    case tag_t::CON:
+    case tag_t::INT:
+    case tag_t::BIG:
+	key_ += "#";
+	lifted = e.new_ref();
+	params_.push_back(lifted);
+	args_.push_back(t);
+	break;
+    case tag_t::STR: {
+	auto f = e.functor(t);
+	key_ += boost::lexical_cast<std::string>(f.raw_value()) + "(";
+	lifted = e.new_term(f);
+	for (size_t i = 0; i < f.arity(); i++) {
+	    term lifted_arg;
+	    lift(e.arg(t, i), lifted_arg);
+	    e.set_arg(lifted, i, lifted_arg);
+	    key_ += ",";
+	}
+	key_ += ")";
+	break;
+    }
+    default:
+	lifted = t;
+	break;
+    }
+}
+
+bool task_execute_query::is_unknown_prepared(const term r)
+{
+    static const con_cell error_1("error",1);
+
+    auto &e = env();
+    if (r.tag() != tag_t::STR || e.functor(r) != error_1) {
+	return false;
+    }
+    term reason = e.arg(r, 0);
+    return reason.tag() == tag_t::STR && e.functor(reason) == e.functor("unknown_prepared_query",1);
+}
+
+void task_execute_query::send_query()
+{
+    auto &e = env();
+    auto &out = connection();
+    if (key_.empty()) {
+	set_query(query_);
+	return;
+    }
+    term args = e.empty_list();
+    for (auto it = args_.rbegin(); it != args_.rend(); ++it) {
+	args = e.new_dotted_pair(*it, args);
+    }
+    handle_ = out.find_prepared(key_);
+    if (handle_ != -1) {
+	set_term(e.new_term(e.functor("prepared",2),
+			    {int_cell(handle_), args}));
+	return;
+    }
+    handle_ = out.new_prepared(key_);
+    if (handle_ == -1) {
+	set_query(query_);
+	return;
+    }
+    term params = e.empty_list();
+    for (auto it = params_.rbegin(); it != params_.rend(); ++it) {
+	params = e.new_dotted_pair(*it, params);
+    }
+    set_term(e.new_term(con_cell("prepare",4),
+			{int_cell(handle_), params, template_, args}));
 }
 
 void task_execute_query::wait_for_result()
@@ -76,11 +228,22 @@ void task_execute_query::process()
     if (get_state() == SEND) {
 	switch (type_) {
 	case NEW_INSTANCE: set_command(con_cell("newinst",0)); break;
-	case QUERY: set_query(query_); break;
+	case QUERY: send_query(); break;
 	case DO_NEXT: set_command(con_cell("next",0)); break;
 	case DELETE_INSTANCE: set_command(con_cell("delinst",0)); break;
 	}
     } else if (get_state() == RECEIVED) {
+	if (handle_ != -1 && is_unknown_prepared(get_term())) {
+	    // The remote session has lost the template (e.g. it was
+	    // reset), so prepare it again once.
+	    connection().forget_prepared(key_);
+	    handle_ = -1;
+	    if (!retried_) {
+		retried_ = true;
+		reschedule_next();
+		return;
+	    }
+	}
 	boost::unique_lock<boost::mutex> lockit(result_cv_lock_);
 	result_ = get_result_goal();
 	result_ready_ = true;
@@ -29,12 +29,29 @@ public:
 private:
     virtual void process() override;
 
+    void prepare_template();
+    void lift_goal(const term t, term &lifted);
+    void lift(const term t, term &lifted);
+    void send_query();
+    bool is_unknown_prepared(const term r);
+
     enum { NEW_INSTANCE = 0, 
 	   QUERY = 1,
 	   DO_NEXT = 2,
 	   DELETE_INSTANCE = 3 } type_;
 
     term query_;
+
+    // Query shape for prepared queries (empty key if the query is sent
+    // as is.) Atomic arguments are lifted to parameters.
+    std::string key_;
+    term template_;
+    std::vector<term> vars_;
+    std::vector<term> params_;
+    std::vector<term> args_;
+    int64_t handle_;
+    bool retried_;
+
     term result_;
     bool result_ready_;
     bool result_consumed_;
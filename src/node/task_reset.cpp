@@ -41,6 +41,8 @@ void task_reset::process()
 	    failed_ = true;
 	    break;
 	} else {
+	    // Remote templates are gone after a reset
+	    connection().clear_prepared();
 	    reset_ = true;
 	}
 	set_state(IDLE);
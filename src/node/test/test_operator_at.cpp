@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include <common/utime.hpp>
+#include <node/session.hpp>
 #include "setup_nodes.hpp"
 
 using namespace prologcoin::common;
@@ -116,9 +117,73 @@ static void test_operator_at_simple()
     network.stop();
 }
 
+//
+// Queries of the same shape are prepared once at the remote session;
+// later ones only send their arguments. If the remote session has lost
+// the template, it is prepared again.
+//
+static void test_operator_at_prepared()
+{
+    header("test_operator_at_prepared");
+
+    setup_nodes network( { { "apple", 8000 },
+			   { "pear", 8001 } } );
+
+    network.start();
+
+    auto tm = network.new_terminal("apple");
+    auto *pear = network.get_node("pear");
+    auto num_prepared = [pear] {
+	size_t n = 0;
+	pear->for_each_in_session(
+	    [&n](in_session_state *session) { n += session->num_prepared(); });
+	return n;
+    };
+
+    std::string q1 = "(member(X, [1,2]), X > 0, !) @ pear.";
+    std::cout << "@apple: testing query: " << q1 << std::endl;
+    {
+	bool r = tm->execute(q1);
+	assert(r);
+	network.check_result(tm, { "X = 1." } );
+	assert(num_prepared() == 1);
+    }
+
+    std::string q2 = "(member(X, [0,0]), X > 0, !) @ pear.";
+    std::cout << "@apple: testing query: " << q2 << std::endl;
+    {
+	bool r = tm->execute(q2);
+	assert(!r);
+	tm->flush_text();
+	assert(num_prepared() == 1);
+    }
+
+    // Forget the templates at 'pear' (but not at 'apple')
+    pear->for_each_in_session(
+	[](in_session_state *session) { session->local_reset(); });
+    assert(num_prepared() == 0);
+
+    std::string q3 = "(member(X, [3,4]), X > 0, !) @ pear.";
+    std::cout << "@apple: testing query: " << q3 << std::endl;
+    {
+	bool r = tm->execute(q3);
+	assert(r);
+	network.check_result(tm, { "X = 3." } );
+	assert(num_prepared() == 1);
+    }
+
+    tm->close();
+
+    // Wait for one second
+    utime::sleep(utime::ss(1));
+
+    network.stop();
+}
+
 int main(int argc, char *argv[])
 {
     test_operator_at_simple();
+    test_operator_at_prepared();
 
     return 0;
 }
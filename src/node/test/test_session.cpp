@@ -0,0 +1,117 @@
+#include <iostream>
+#include <node/self_node.hpp>
+#include <node/session.hpp>
+
+using namespace prologcoin::common;
+using namespace prologcoin::node;
+
+static void header( const std::string &str )
+{
+    std::cout << "\n";
+    std::cout << "--- [" + str + "] " + std::string(60 - str.length(), '-') << "\n";
+    std::cout << "\n";
+}
+
+// Register 'templ' (a term '$t'(Params, Template)) under 'handle'
+static void prepare(in_session_state &sess, int64_t handle,
+		    const std::string &templ)
+{
+    auto &e = sess.env();
+    term t = e.parse(templ);
+    bool r = sess.prepare(handle, e.arg(t, 0), e.arg(t, 1));
+    assert(r);
+}
+
+static std::string run_prepared(in_session_state &sess, int64_t handle,
+				const std::string &args)
+{
+    auto &e = sess.env();
+    term qr = sess.instantiate_prepared(handle, e.parse(args));
+    assert(qr != term());
+    bool r = sess.execute(qr);
+    assert(r);
+    return e.to_string(qr);
+}
+
+static void test_prepare()
+{
+    header("test_prepare");
+
+    self_node node(8000);
+    in_session_state sess(&node, nullptr);
+    sess.set_available_funds(1000000000);
+
+    prepare(sess, 0, "'$t'([P,Q], append([P], [Q], L)).");
+    assert(sess.num_prepared() == 1);
+
+    auto actual = run_prepared(sess, 0, "[a, 1].");
+    std::cout << "Actual: " << actual << std::endl;
+    assert(actual == "append([a], [1], [a,1])");
+    assert(!sess.has_more());
+
+    actual = run_prepared(sess, 0, "[b, 2].");
+    std::cout << "Actual: " << actual << std::endl;
+    assert(actual == "append([b], [2], [b,2])");
+}
+
+static void test_prepare_after_backtracking()
+{
+    header("test_prepare_after_backtracking");
+
+    self_node node(8000);
+    in_session_state sess(&node, nullptr);
+    sess.set_available_funds(1000000000);
+    auto &e = sess.env();
+
+    // Leave a choice point behind, then prepare a template above it
+    bool r = sess.execute(e.parse("member(X, [1,2,3])."));
+    assert(r);
+    assert(sess.has_more());
+
+    prepare(sess, 7, "'$t'([P], append(X, [P], [q, P])).");
+
+    // Backtracking trims the heap down to the choice point; fill
+    // it with other terms afterwards.
+    r = sess.next();
+    assert(r);
+    e.parse("foo(bar, baz(1, 2, 3), [x, y, z]).");
+    r = sess.next();
+    assert(r);
+    assert(!sess.next());
+
+    auto actual = run_prepared(sess, 7, "[w].");
+    std::cout << "Actual: " << actual << std::endl;
+    assert(actual == "append([q], [w], [q,w])");
+}
+
+static void test_unknown_prepared()
+{
+    header("test_unknown_prepared");
+
+    self_node node(8000);
+    in_session_state sess(&node, nullptr);
+    sess.set_available_funds(1000000000);
+    auto &e = sess.env();
+
+    assert(sess.instantiate_prepared(3, e.parse("[a].")) == term());
+
+    prepare(sess, 3, "'$t'([P], atom(P)).");
+
+    // Wrong number of arguments for the template
+    assert(sess.instantiate_prepared(3, e.parse("[a, b].")) == term());
+
+    // A reset forgets all templates
+    sess.local_reset();
+    assert(sess.num_prepared() == 0);
+    assert(sess.instantiate_prepared(3, e.parse("[a].")) == term());
+}
+
+int main(int argc, char *argv[])
+{
+    std::cout << std::unitbuf;
+    test_prepare();
+    test_prepare_after_backtracking();
+    test_unknown_prepared();
+
+    return 0;
+}